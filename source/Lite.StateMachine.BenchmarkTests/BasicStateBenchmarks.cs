@@ -23,10 +23,13 @@ public class BasicStateBenchmarks
   {
     // We will continue to loop using OnError transition until we reached our max counter
     // upon which, we will OnSuccess and exit the state machine.
-    _machine = new StateMachine<BasicStateId>(null, null, isContextPersistent: true);
+    _machine = new StateMachine<BasicStateId>(isContextPersistent: true);
     _machine.RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2);
     _machine.RegisterState<BasicState2>(BasicStateId.State2, BasicStateId.State3);
     _machine.RegisterState<BasicState3>(BasicStateId.State3, onSuccess: null, onError: BasicStateId.State1);
+
+    // Compile the transition table up-front so it isn't measured by the first iteration
+    _machine.Build();
   }
 
   [Benchmark]
@@ -9,28 +9,40 @@ using BenchmarkDotNet.Diagnosers;
 using BenchmarkDotNet.Environments;
 using BenchmarkDotNet.Exporters;
 using BenchmarkDotNet.Exporters.Csv;
+using BenchmarkDotNet.Exporters.Json;
 using BenchmarkDotNet.Jobs;
 using BenchmarkDotNet.Loggers;
+using BenchmarkDotNet.Order;
 
 namespace Lite.StateMachine.BenchmarkTests;
 
 public class BenchmarkConfig
 {
   /// <summary>Custom configuration.</summary>
+  /// <remarks>
+  ///   Benchmarks with <c>OperationsPerInvoke</c> count one operation per transition (or message), so "Op/s" and
+  ///   "Allocated" read as transitions/sec and bytes per transition; "Ratio" compares each against its class's
+  ///   <c>Baseline</c> benchmark. The full JSON report is written per class to
+  ///   "BenchmarkDotNet.Artifacts/results" for comparing releases (i.e. dotnet/performance's ResultsComparer).
+  /// </remarks>
   /// <returns>BenchmarkDotNet Configuration.</returns>
   public static IConfig Get()
   {
     return ManualConfig.CreateEmpty()
       //// Jobs
       .AddJob(Job.Default
-        .WithRuntime(CoreRuntime.Core90)
+        .WithRuntime(CoreRuntime.Core10_0)
         .WithPlatform(Platform.X64))
       //// Diagnoser and Output Configuration
       .AddDiagnoser(MemoryDiagnoser.Default)
       .AddColumnProvider(DefaultColumnProviders.Instance)
+      .AddColumn(StatisticColumn.OperationsPerSecond)
       .AddLogger(ConsoleLogger.Default)
       .AddExporter(CsvExporter.Default)
       .AddExporter(HtmlExporter.Default)
+      .AddExporter(JsonExporter.Full)
+      .AddExporter(MarkdownExporter.GitHub)
+      .WithOrderer(new DefaultOrderer(SummaryOrderPolicy.Declared))
       .AddAnalyser([.. GetAnalysers()]);  //// "[.. GetAnalysers()]" == 'GetAnalysers().ToArray()"
   }
 
@@ -0,0 +1,68 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+using Lite.StateMachine.BenchmarkTests.States;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary>Command state message throughput, with other subscribers listening to the same aggregator.</summary>
+/// <remarks>Each operation is one message delivered through the aggregator, queue and <c>OnMessage</c>.</remarks>
+[MemoryDiagnoser]
+public class CommandStateBenchmarks
+{
+  private const int MessagesPerRun = 1_000;
+
+  private readonly List<IDisposable> _subscriptions = [];
+
+  private EventAggregator _aggregator = new();
+  private StateMachine<BasicStateId> _machine = new();
+
+  [Params(false, true)]
+  public bool IsMessageRoutingEnabled { get; set; }
+
+  /// <summary>Gets or sets the number of unrelated subscribers to <see cref="PingMessage"/>.</summary>
+  [Params(0, 8, 64)]
+  public int SubscriberCount { get; set; }
+
+  [GlobalCleanup]
+  public void CommandGlobalCleanup()
+  {
+    foreach (var subscription in _subscriptions)
+      subscription.Dispose();
+
+    _subscriptions.Clear();
+  }
+
+  [GlobalSetup]
+  public void CommandGlobalSetup()
+  {
+    _aggregator = new EventAggregator();
+    for (int i = 0; i < SubscriberCount; i++)
+      _subscriptions.Add(_aggregator.Subscribe(static _ => { }, typeof(PingMessage)));
+
+    _machine = new StateMachine<BasicStateId>(eventAggregator: _aggregator)
+    {
+      IsMessageRoutingEnabled = IsMessageRoutingEnabled,
+    };
+
+    _machine
+      .RegisterState<PingCommandState>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2)
+      .Build();
+  }
+
+  [Benchmark(OperationsPerInvoke = MessagesPerRun)]
+  public async Task CommandStateMessagesAsync()
+  {
+    _machine.Context.Parameters = new()
+    {
+      { ParameterType.MaxCounter, MessagesPerRun },
+    };
+
+    await _machine.RunAsync(BasicStateId.State1);
+  }
+}
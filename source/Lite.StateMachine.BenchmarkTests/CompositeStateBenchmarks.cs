@@ -0,0 +1,73 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+using Lite.StateMachine.BenchmarkTests.States;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary>Nested composites (the CompositeL1/L3 test shapes), with and without context persistence.</summary>
+/// <remarks>Each operation is one state transition, so ops/sec and allocated bytes read per transition.</remarks>
+[MemoryDiagnoser]
+public class CompositeStateBenchmarks
+{
+  private const int Cycles = 100;
+
+  /// <summary>State1, State2, 2 sub-states and State3.</summary>
+  private const int L1Transitions = Cycles * 5;
+
+  /// <summary>State1, State2, 3 sub-states, 3 nested sub-states and State3.</summary>
+  private const int L3Transitions = Cycles * 9;
+
+  private StateMachine<CompositeL1StateId> _l1 = new();
+  private StateMachine<CompositeL3StateId> _l3 = new();
+
+  [Params(true, false)]
+  public bool IsContextPersistent { get; set; }
+
+  [GlobalSetup]
+  public void CompositeGlobalSetup()
+  {
+    // State3 loops back to State1 (OnError) until the counter is exceeded
+    _l1 = new StateMachine<CompositeL1StateId>(isContextPersistent: IsContextPersistent)
+      .RegisterState<PassState<CompositeL1StateId>>(CompositeL1StateId.State1, CompositeL1StateId.State2)
+      .RegisterComposite<CompositeParentState<CompositeL1StateId>>(CompositeL1StateId.State2, CompositeL1StateId.State2_Sub1, onSuccess: CompositeL1StateId.State3)
+      .RegisterSubState<SubState<CompositeL1StateId>>(CompositeL1StateId.State2_Sub1, CompositeL1StateId.State2, onSuccess: CompositeL1StateId.State2_Sub2)
+      .RegisterSubState<SubState<CompositeL1StateId>>(CompositeL1StateId.State2_Sub2, CompositeL1StateId.State2)
+      .RegisterState<LoopState<CompositeL1StateId>>(CompositeL1StateId.State3, onSuccess: null, onError: CompositeL1StateId.State1)
+      .Build();
+
+    _l3 = new StateMachine<CompositeL3StateId>(isContextPersistent: IsContextPersistent)
+      .RegisterState<PassState<CompositeL3StateId>>(CompositeL3StateId.State1, CompositeL3StateId.State2)
+      .RegisterComposite<CompositeParentState<CompositeL3StateId>>(CompositeL3StateId.State2, CompositeL3StateId.State2_Sub1, onSuccess: CompositeL3StateId.State3)
+      .RegisterSubState<SubState<CompositeL3StateId>>(CompositeL3StateId.State2_Sub1, CompositeL3StateId.State2, onSuccess: CompositeL3StateId.State2_Sub2)
+      .RegisterSubComposite<CompositeParentState<CompositeL3StateId>>(CompositeL3StateId.State2_Sub2, CompositeL3StateId.State2, CompositeL3StateId.State2_Sub2_Sub1, onSuccess: CompositeL3StateId.State2_Sub3)
+      .RegisterSubState<SubState<CompositeL3StateId>>(CompositeL3StateId.State2_Sub2_Sub1, CompositeL3StateId.State2_Sub2, onSuccess: CompositeL3StateId.State2_Sub2_Sub2)
+      .RegisterSubState<SubState<CompositeL3StateId>>(CompositeL3StateId.State2_Sub2_Sub2, CompositeL3StateId.State2_Sub2, onSuccess: CompositeL3StateId.State2_Sub2_Sub3)
+      .RegisterSubState<SubState<CompositeL3StateId>>(CompositeL3StateId.State2_Sub2_Sub3, CompositeL3StateId.State2_Sub2)
+      .RegisterSubState<SubState<CompositeL3StateId>>(CompositeL3StateId.State2_Sub3, CompositeL3StateId.State2)
+      .RegisterState<LoopState<CompositeL3StateId>>(CompositeL3StateId.State3, onSuccess: null, onError: CompositeL3StateId.State1)
+      .Build();
+  }
+
+  [Benchmark(Baseline = true, OperationsPerInvoke = L1Transitions)]
+  public async Task CompositeL1Async()
+  {
+    _l1.Context.Parameters = NewParameters();
+    await _l1.RunAsync(CompositeL1StateId.State1);
+  }
+
+  [Benchmark(OperationsPerInvoke = L3Transitions)]
+  public async Task CompositeL3Async()
+  {
+    _l3.Context.Parameters = NewParameters();
+    await _l3.RunAsync(CompositeL3StateId.State1);
+  }
+
+  private static PropertyBag NewParameters() => new()
+  {
+    { ParameterType.MaxCounter, Cycles - 1 },
+    { ParameterType.Counter, 0 },
+  };
+}
@@ -0,0 +1,98 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Diagnostics.CodeAnalysis;
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+using Lite.StateMachine.Adapters;
+using Lite.StateMachine.BenchmarkTests.States;
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary>States resolved through Microsoft.Extensions.DependencyInjection on every entry (<see cref="StateLifetime.Transient"/>).</summary>
+/// <remarks>Each operation is one state transition; the baseline creates the same states without a container.</remarks>
+[MemoryDiagnoser]
+public class DiStateBenchmarks
+{
+  private const int Cycles = 100;
+  private const int Transitions = Cycles * 3;
+
+  private StateMachine<BasicStateId> _activator = new();
+  private StateMachine<BasicStateId> _direct = new();
+  private StateMachine<BasicStateId> _resolver = new();
+  private ServiceProvider? _services;
+
+  [GlobalCleanup]
+  public void DiGlobalCleanup() => _services?.Dispose();
+
+  [GlobalSetup]
+  public void DiGlobalSetup()
+  {
+    var services = new ServiceCollection()
+      .AddSingleton<CounterService>()
+      .AddTransient<DiState1>()
+      .AddTransient<DiState2>()
+      .AddTransient<DiState3>()
+      .BuildServiceProvider();
+    _services = services;
+
+    var counter = services.GetRequiredService<CounterService>();
+    _direct = RegisterDirect(new StateMachine<BasicStateId>(), () => new DiState1(counter), () => new DiState2(counter), () => new DiState3(counter));
+
+    Func<Type, object?> factory = t => ActivatorUtilities.CreateInstance(services, t);
+    _activator = Register<DiState1, DiState2, DiState3>(new StateMachine<BasicStateId>(factory));
+    _resolver = Register<DiState1, DiState2, DiState3>(new StateMachine<BasicStateId>(new MsDiResolver(services)));
+  }
+
+  /// <summary>Type-based factory; <see cref="ActivatorUtilities.CreateInstance(IServiceProvider, Type, object[])"/> per entry.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  [Benchmark(OperationsPerInvoke = Transitions)]
+  public Task ActivatorFactoryAsync() => RunAsync(_activator);
+
+  /// <summary>Hand-written factories; no container involved.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  [Benchmark(Baseline = true, OperationsPerInvoke = Transitions)]
+  public Task NoContainerAsync() => RunAsync(_direct);
+
+  /// <summary><see cref="MsDiResolver"/>; constructors bound once per registration.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  [Benchmark(OperationsPerInvoke = Transitions)]
+  public Task ServiceResolverAsync() => RunAsync(_resolver);
+
+  private static StateMachine<BasicStateId> Register<
+    [DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T1,
+    [DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T2,
+    [DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T3>(StateMachine<BasicStateId> machine)
+    where T1 : class, IState<BasicStateId>
+    where T2 : class, IState<BasicStateId>
+    where T3 : class, IState<BasicStateId> =>
+    machine
+      .RegisterState<T1>(BasicStateId.State1, BasicStateId.State2, lifetime: StateLifetime.Transient)
+      .RegisterState<T2>(BasicStateId.State2, BasicStateId.State3, lifetime: StateLifetime.Transient)
+      .RegisterState<T3>(BasicStateId.State3, onSuccess: null, onError: BasicStateId.State1, lifetime: StateLifetime.Transient)
+      .Build();
+
+  private static StateMachine<BasicStateId> RegisterDirect(
+    StateMachine<BasicStateId> machine,
+    Func<DiState1> state1,
+    Func<DiState2> state2,
+    Func<DiState3> state3) =>
+    machine
+      .RegisterState(state1, BasicStateId.State1, BasicStateId.State2, null, null, lifetime: StateLifetime.Transient)
+      .RegisterState(state2, BasicStateId.State2, BasicStateId.State3, null, null, lifetime: StateLifetime.Transient)
+      .RegisterState(state3, BasicStateId.State3, null, BasicStateId.State1, null, lifetime: StateLifetime.Transient)
+      .Build();
+
+  private static async Task RunAsync(StateMachine<BasicStateId> machine)
+  {
+    machine.Context.Parameters = new()
+    {
+      { ParameterType.MaxCounter, Cycles - 1 },
+      { ParameterType.Counter, 0 },
+    };
+
+    await machine.RunAsync(BasicStateId.State1);
+  }
+}
@@ -0,0 +1,49 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using BenchmarkDotNet.Attributes;
+using Lite.StateMachine.BenchmarkTests.States;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary><see cref="EventAggregator.Publish(object)"/> fan-out to typed, generic and wildcard subscribers.</summary>
+[MemoryDiagnoser]
+public class EventAggregatorBenchmarks
+{
+  private static readonly PingMessage Ping = new();
+
+  private EventAggregator _generic = new();
+  private int _received;
+  private EventAggregator _typed = new();
+  private EventAggregator _wildcard = new();
+
+  [Params(1, 16, 256)]
+  public int SubscriberCount { get; set; }
+
+  [GlobalSetup]
+  public void AggregatorGlobalSetup()
+  {
+    _generic = new EventAggregator();
+    _typed = new EventAggregator();
+    _wildcard = new EventAggregator();
+
+    for (int i = 0; i < SubscriberCount; i++)
+    {
+      _generic.Subscribe<PingValue>(m => _received += m.Counter);
+      _typed.Subscribe(_ => _received++, typeof(PingMessage));
+      _wildcard.Subscribe(_ => _received++);
+    }
+  }
+
+  /// <summary>Value-type message to <c>Subscribe{T}</c> handlers; expected to not box.</summary>
+  [Benchmark]
+  public void PublishGenericValue() => _generic.Publish(new PingValue(1));
+
+  [Benchmark(Baseline = true)]
+  public void PublishTyped() => _typed.Publish(Ping);
+
+  [Benchmark]
+  public void PublishWildcard() => _wildcard.Publish(Ping);
+
+  private readonly record struct PingValue(int Counter);
+}
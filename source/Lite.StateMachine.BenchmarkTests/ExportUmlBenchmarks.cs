@@ -0,0 +1,70 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Buffers;
+using BenchmarkDotNet.Attributes;
+using Lite.StateMachine.BenchmarkTests.States;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary>Diagram export on large graphs: a chain of composites, each with 3 sub-states.</summary>
+/// <remarks>
+///   Exports are cached per option set (single entry), so the rendering benchmarks alternate an option to
+///   render on every call; the cached benchmarks measure what repeated callers (i.e. a diagnostics page) pay.
+/// </remarks>
+[MemoryDiagnoser]
+public class ExportUmlBenchmarks
+{
+  private const int StatesPerComposite = 4;
+
+  private readonly ArrayBufferWriter<byte> _buffer = new();
+
+  private bool _alternate;
+  private StateMachine<LargeGraphStateId> _machine = new();
+
+  /// <summary>Gets or sets the number of registered states.</summary>
+  [Params(16, 256, 2048)]
+  public int StateCount { get; set; }
+
+  [GlobalSetup]
+  public void ExportGlobalSetup()
+  {
+    _machine = new StateMachine<LargeGraphStateId>();
+
+    var composites = StateCount / StatesPerComposite;
+    for (int c = 0; c < composites; c++)
+    {
+      var parent = c * StatesPerComposite;
+      LargeGraphStateId? next = c + 1 < composites ? Id(parent + StatesPerComposite) : null;
+
+      _machine.RegisterComposite<CompositeParentState<LargeGraphStateId>>(Id(parent), Id(parent + 1), onSuccess: next, onFailure: next is null ? null : Id(0));
+      _machine.RegisterSubState<SubState<LargeGraphStateId>>(Id(parent + 1), Id(parent), onSuccess: Id(parent + 2));
+      _machine.RegisterSubState<SubState<LargeGraphStateId>>(Id(parent + 2), Id(parent), onSuccess: Id(parent + 3), onError: Id(parent + 1));
+      _machine.RegisterSubState<SubState<LargeGraphStateId>>(Id(parent + 3), Id(parent));
+    }
+
+    _machine.Build();
+  }
+
+  [Benchmark]
+  public string ExportMermaid() =>
+    _machine.ExportMermaid(rankLeftToRight: _alternate = !_alternate);
+
+  [Benchmark(Baseline = true)]
+  public string ExportUml() =>
+    _machine.ExportUml(includeLegend: _alternate = !_alternate);
+
+  [Benchmark]
+  public string ExportUmlCached() =>
+    _machine.ExportUml();
+
+  [Benchmark]
+  public int ExportUmlCachedUtf8()
+  {
+    _buffer.ResetWrittenCount();
+    _machine.ExportUml(_buffer);
+    return _buffer.WrittenCount;
+  }
+
+  private static LargeGraphStateId Id(int index) => (LargeGraphStateId)index;
+}
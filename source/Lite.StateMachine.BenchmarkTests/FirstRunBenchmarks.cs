@@ -0,0 +1,48 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+using Lite.StateMachine.BenchmarkTests.States;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary>A machine's first run (build, state creation) versus warm runs of an already used machine.</summary>
+/// <remarks>In-process; JIT is warm. See <see cref="StartupBenchmarks"/> for a cold process.</remarks>
+[MemoryDiagnoser]
+public class FirstRunBenchmarks
+{
+  private StateMachine<BasicStateId> _warm = new();
+
+  [GlobalSetup]
+  public async Task FirstRunGlobalSetup()
+  {
+    _warm = Create();
+    await _warm.RunAsync(BasicStateId.State1);
+  }
+
+  /// <summary>New machine per run: transition table compiled and states created on the way.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  [Benchmark]
+  public async Task FirstRunAsync() =>
+    await Create().RunAsync(BasicStateId.State1);
+
+  /// <summary>New machine per run, with <see cref="StateMachine{TStateId}.WarmUpAsync"/> first.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  [Benchmark]
+  public async Task FirstRunWarmedUpAsync()
+  {
+    var machine = await Create().WarmUpAsync();
+    await machine.RunAsync(BasicStateId.State1);
+  }
+
+  [Benchmark(Baseline = true)]
+  public async Task WarmRunAsync() =>
+    await _warm.RunAsync(BasicStateId.State1);
+
+  private static StateMachine<BasicStateId> Create() =>
+    new StateMachine<BasicStateId>()
+      .RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2, BasicStateId.State3)
+      .RegisterState<PassState<BasicStateId>>(BasicStateId.State3);
+}
@@ -0,0 +1,33 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Engines;
+using BenchmarkDotNet.Jobs;
+using Lite.StateMachine.BenchmarkTests.States;
+
+namespace Lite.StateMachine.BenchmarkTests;
+
+/// <summary>Cold-start cost: create, register and run a machine once in a fresh process (JIT vs. Native AOT).</summary>
+/// <remarks>
+///   Every launch is a new process with a single invocation, so the measurement includes first-call JIT,
+///   type loading and static initialization; exactly what small controllers pay at boot.
+///   Run with: <c>dotnet run -c Release -- --filter *StartupBenchmarks*</c>.
+/// </remarks>
+[MemoryDiagnoser]
+[SimpleJob(RunStrategy.ColdStart, RuntimeMoniker.Net10_0, launchCount: 20, warmupCount: 0, iterationCount: 1, id: "JIT")]
+[SimpleJob(RunStrategy.ColdStart, RuntimeMoniker.NativeAot10_0, launchCount: 20, warmupCount: 0, iterationCount: 1, id: "NativeAOT")]
+public class StartupBenchmarks
+{
+  [Benchmark]
+  public async Task FirstTransitionAsync()
+  {
+    var machine = new StateMachine<BasicStateId>()
+      .RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2, BasicStateId.State3)
+      .RegisterState<BasicState3>(BasicStateId.State3);
+
+    await machine.RunAsync(BasicStateId.State1);
+  }
+}
@@ -0,0 +1,61 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.BenchmarkTests.States;
+
+#pragma warning disable SA1649 // File name should match first type name
+#pragma warning disable SA1402 // File may only contain a single type
+
+/// <summary>Message handled by <see cref="PingCommandState"/>.</summary>
+public sealed class PingMessage;
+
+/// <summary>Publishes <see cref="ParameterType.MaxCounter"/> pings to itself on entry and completes once they are all handled.</summary>
+/// <remarks>A single message instance is re-published, so only the pipeline's own allocations are measured.</remarks>
+public class PingCommandState : ICommandState<BasicStateId>
+{
+  private static readonly PingMessage Ping = new();
+  private static readonly Type[] Subscriptions = [typeof(PingMessage)];
+
+  private int _handled;
+  private int _max;
+
+  public IReadOnlyCollection<Type> SubscribedMessageTypes => Subscriptions;
+
+  /// <summary>Gets the command timeout; generous, a benchmark should never hit it.</summary>
+  public int? TimeoutMs => 60_000;
+
+  public Task OnEnter(Context<BasicStateId> context)
+  {
+    _handled = 0;
+    _max = context.ParameterAsInt(ParameterType.MaxCounter);
+    for (int i = 0; i < _max; i++)
+      context.EventAggregator?.Publish(Ping);
+
+    return Task.CompletedTask;
+  }
+
+  public Task OnEntering(Context<BasicStateId> context) => Task.CompletedTask;
+
+  public Task OnExit(Context<BasicStateId> context) => Task.CompletedTask;
+
+  public Task OnMessage(Context<BasicStateId> context, object message)
+  {
+    if (++_handled == _max)
+      context.NextState(Result.Success);
+
+    return Task.CompletedTask;
+  }
+
+  public Task OnTimeout(Context<BasicStateId> context)
+  {
+    context.NextState(Result.Failure);
+    return Task.CompletedTask;
+  }
+}
+
+#pragma warning restore SA1649 // File name should match first type name
+#pragma warning restore SA1402 // File may only contain a single type
@@ -0,0 +1,60 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.BenchmarkTests.States;
+
+#pragma warning disable SA1649 // File name should match first type name
+#pragma warning disable SA1402 // File may only contain a single type
+
+/// <summary>Composite parent; passes its last child's result on.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class CompositeParentState<TStateId> : StateBase<CompositeParentState<TStateId>, TStateId>
+  where TStateId : struct, Enum
+{
+  public override Task OnEnter(Context<TStateId> context) =>
+    Task.CompletedTask;
+
+  public override Task OnExit(Context<TStateId> context)
+  {
+    context.NextState(context.LastChildResult ?? Result.Failure);
+    return Task.CompletedTask;
+  }
+}
+
+/// <summary>Loops back through <see cref="Result.Error"/> until <see cref="ParameterType.MaxCounter"/> is exceeded.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class LoopState<TStateId> : StateBase<LoopState<TStateId>, TStateId>
+  where TStateId : struct, Enum
+{
+  public override Task OnEnter(Context<TStateId> context)
+  {
+    var cnt = context.ParameterAsInt(ParameterType.Counter) + 1;
+    context.Parameters.SafeAdd(ParameterType.Counter, cnt);
+
+    context.NextState(cnt > context.ParameterAsInt(ParameterType.MaxCounter) ? Result.Success : Result.Error);
+    return Task.CompletedTask;
+  }
+}
+
+/// <summary>Completes with <see cref="Result.Success"/> on entry.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class PassState<TStateId> : StateBase<PassState<TStateId>, TStateId>
+  where TStateId : struct, Enum;
+
+/// <summary>Sub-state adding to the context, so non-persistent parents have a scope to drop.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class SubState<TStateId> : StateBase<SubState<TStateId>, TStateId>
+  where TStateId : struct, Enum
+{
+  public override Task OnEnter(Context<TStateId> context)
+  {
+    context.Parameters.SafeAdd(ParameterType.ChildValue, context.CurrentStateId);
+    return base.OnEnter(context);
+  }
+}
+
+#pragma warning restore SA1649 // File name should match first type name
+#pragma warning restore SA1402 // File may only contain a single type
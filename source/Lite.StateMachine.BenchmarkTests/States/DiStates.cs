@@ -0,0 +1,46 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.BenchmarkTests.States;
+
+#pragma warning disable SA1649 // File name should match first type name
+#pragma warning disable SA1402 // File may only contain a single type
+
+/// <summary>Singleton service injected into the DI states.</summary>
+public sealed class CounterService
+{
+  public int Counter { get; set; }
+}
+
+public class DiState1(CounterService counter) : StateBase<DiState1, BasicStateId>
+{
+  public override Task OnEnter(Context<BasicStateId> context)
+  {
+    counter.Counter++;
+    return base.OnEnter(context);
+  }
+}
+
+public class DiState2(CounterService counter) : StateBase<DiState2, BasicStateId>
+{
+  public override Task OnEnter(Context<BasicStateId> context)
+  {
+    counter.Counter++;
+    return base.OnEnter(context);
+  }
+}
+
+/// <summary>Loops back to <see cref="DiState1"/> until <see cref="ParameterType.MaxCounter"/> is exceeded.</summary>
+public class DiState3(CounterService counter) : LoopState<BasicStateId>
+{
+  public override Task OnEnter(Context<BasicStateId> context)
+  {
+    counter.Counter++;
+    return base.OnEnter(context);
+  }
+}
+
+#pragma warning restore SA1649 // File name should match first type name
+#pragma warning restore SA1402 // File may only contain a single type
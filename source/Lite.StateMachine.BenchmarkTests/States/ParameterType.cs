@@ -7,4 +7,7 @@ public enum ParameterType
 {
   MaxCounter,
   Counter,
+
+  /// <summary>Added by sub-states; dropped on the parent's exit when context isn't persistent.</summary>
+  ChildValue,
 }
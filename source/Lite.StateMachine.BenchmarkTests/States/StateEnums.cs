@@ -13,4 +13,34 @@ public enum BasicStateId
   State3,
 }
 
+/// <summary>One composite level: State1 => State2 { Sub1 => Sub2 } => State3.</summary>
+public enum CompositeL1StateId
+{
+  State1,
+  State2,
+  State2_Sub1,
+  State2_Sub2,
+  State3,
+}
+
+/// <summary>Nested composites: State1 => State2 { Sub1 => Sub2 { Sub1 => Sub2 => Sub3 } => Sub3 } => State3.</summary>
+public enum CompositeL3StateId
+{
+  State1,
+  State2,
+  State2_Sub1,
+  State2_Sub2,
+  State2_Sub2_Sub1,
+  State2_Sub2_Sub2,
+  State2_Sub2_Sub3,
+  State2_Sub3,
+  State3,
+}
+
+/// <summary>Generated graphs; values are cast from their index so any size can be registered.</summary>
+public enum LargeGraphStateId
+{
+  None,
+}
+
 #pragma warning restore SA1649 // File name should match first type name
@@ -0,0 +1,102 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.CodeAnalysis;
+
+namespace Lite.StateMachine.Generators;
+
+/// <summary>Compile-time equivalents of the topology exceptions thrown at run time.</summary>
+internal static class DiagnosticDescriptors
+{
+  private const string Category = "Lite.StateMachine";
+
+  /// <summary>Target class, and any type containing it, must be non-generic and partial, with an enum State Id type.</summary>
+  public static readonly DiagnosticDescriptor InvalidMachine = new(
+    "LSM001",
+    "Invalid generated state machine",
+    "'{0}' must be a non-generic partial class, nested only in non-generic partial types, and '{1}' must be an enum",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>State class can't be created with <c>new()</c> or isn't a state.</summary>
+  public static readonly DiagnosticDescriptor InvalidStateType = new(
+    "LSM002",
+    "Invalid state class",
+    "State class '{0}' must be a non-abstract class implementing IState<{1}> with a parameterless constructor",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>State Id argument isn't the machine's State Id type.</summary>
+  public static readonly DiagnosticDescriptor InvalidStateId = new(
+    "LSM003",
+    "Invalid State Id",
+    "'{0}' must be a '{1}' value",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>DuplicateStateException.</summary>
+  public static readonly DiagnosticDescriptor DuplicateState = new(
+    "LSM004",
+    "Duplicate state",
+    "State '{0}' already registered",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>UnregisteredStateTransitionException.</summary>
+  public static readonly DiagnosticDescriptor UnregisteredState = new(
+    "LSM005",
+    "Unregistered state transition",
+    "State '{0}' {1} '{2}', which was not registered",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>ParentStateMustBeCompositeException.</summary>
+  public static readonly DiagnosticDescriptor ParentMustBeComposite = new(
+    "LSM006",
+    "Parent state must be composite",
+    "Parent state '{0}' of '{1}' must be registered as a composite state (set InitialSubState or Regions)",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>OrphanSubStateException.</summary>
+  public static readonly DiagnosticDescriptor OrphanSubState = new(
+    "LSM007",
+    "Orphan sub-state",
+    "Child state '{0}' must belong to composite '{1}'",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>DisjointedNextSubStateException.</summary>
+  public static readonly DiagnosticDescriptor DisjointedNextSubState = new(
+    "LSM008",
+    "Disjointed next sub-state",
+    "Child '{0}' maps to '{1}', which is not a sibling under '{2}'",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>MissingInitialSubStateException.</summary>
+  public static readonly DiagnosticDescriptor MissingInitialSubState = new(
+    "LSM009",
+    "Missing initial sub-state",
+    "Composite '{0}' must have an initial sub-state (InitialSubState) or at least one region (Regions)",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+
+  /// <summary>Parallel composite regions must start under it and not overlap.</summary>
+  public static readonly DiagnosticDescriptor InvalidParallelComposite = new(
+    "LSM010",
+    "Invalid parallel composite",
+    "Parallel composite '{0}' {1}",
+    Category,
+    DiagnosticSeverity.Error,
+    isEnabledByDefault: true);
+}
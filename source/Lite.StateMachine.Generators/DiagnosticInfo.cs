@@ -0,0 +1,24 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.Text;
+
+namespace Lite.StateMachine.Generators;
+
+/// <summary>Cache-friendly diagnostic; holds no syntax tree or symbol references.</summary>
+internal sealed record DiagnosticInfo(DiagnosticDescriptor Descriptor, string FilePath, TextSpan Span, LinePositionSpan LineSpan, string Arg0, string Arg1, string Arg2)
+{
+  public static DiagnosticInfo Create(DiagnosticDescriptor descriptor, Location? location, string arg0, string arg1 = "", string arg2 = "")
+  {
+    location ??= Location.None;
+    var lineSpan = location.GetLineSpan();
+    return new DiagnosticInfo(descriptor, lineSpan.Path ?? string.Empty, location.SourceSpan, lineSpan.Span, arg0, arg1, arg2);
+  }
+
+  public Diagnostic ToDiagnostic()
+  {
+    var location = FilePath.Length == 0 ? Location.None : Location.Create(FilePath, Span, LineSpan);
+    return Diagnostic.Create(Descriptor, location, Arg0, Arg1, Arg2);
+  }
+}
@@ -0,0 +1,51 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections;
+using System.Collections.Generic;
+
+namespace Lite.StateMachine.Generators;
+
+/// <summary>Value-equality array, so incremental pipeline outputs are cached across edits.</summary>
+/// <typeparam name="T">Element type.</typeparam>
+internal readonly struct EquatableArray<T> : IEquatable<EquatableArray<T>>, IEnumerable<T>
+  where T : IEquatable<T>
+{
+  private readonly T[]? _items;
+
+  public EquatableArray(T[] items) => _items = items;
+
+  public int Count => _items?.Length ?? 0;
+
+  public bool Equals(EquatableArray<T> other)
+  {
+    var a = _items ?? [];
+    var b = other._items ?? [];
+    if (a.Length != b.Length)
+      return false;
+
+    for (int i = 0; i < a.Length; i++)
+    {
+      if (!a[i].Equals(b[i]))
+        return false;
+    }
+
+    return true;
+  }
+
+  public override bool Equals(object? obj) => obj is EquatableArray<T> other && Equals(other);
+
+  public override int GetHashCode()
+  {
+    var hash = 17;
+    foreach (var item in _items ?? [])
+      hash = (hash * 31) + item.GetHashCode();
+
+    return hash;
+  }
+
+  public IEnumerator<T> GetEnumerator() => ((IEnumerable<T>)(_items ?? [])).GetEnumerator();
+
+  IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+}
@@ -0,0 +1,9 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+namespace System.Runtime.CompilerServices;
+
+/// <summary>Enables records and init-only setters on netstandard2.0.</summary>
+internal static class IsExternalInit
+{
+}
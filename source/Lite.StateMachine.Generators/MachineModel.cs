@@ -0,0 +1,10 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+namespace Lite.StateMachine.Generators;
+
+/// <summary>Output of the transform step.</summary>
+/// <param name="HintName">Generated file name.</param>
+/// <param name="Source">Generated source, or empty when the topology has errors.</param>
+/// <param name="Diagnostics">Topology errors.</param>
+internal sealed record MachineModel(string HintName, string Source, EquatableArray<DiagnosticInfo> Diagnostics);
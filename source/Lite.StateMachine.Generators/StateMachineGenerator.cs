@@ -0,0 +1,436 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+using System.Threading;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+
+namespace Lite.StateMachine.Generators;
+
+/// <summary>
+///   Emits <c>CreateStateMachine(...)</c> for classes marked with <c>[GeneratedStateMachine]</c>, registering each
+///   <c>[GeneratedState]</c> with a direct <c>new()</c> factory (no reflection, trimming/AOT safe).
+///   Topology mistakes surface as compile errors instead of run time exceptions.
+/// </summary>
+/// <remarks>
+///   The emitted machine runs on the regular <c>StateMachine</c> runtime. A specialized, switch-based runner is
+///   a separate follow-up (see <c>Concept-Designs.md</c>, MK-3).
+/// </remarks>
+[Generator]
+public sealed class StateMachineGenerator : IIncrementalGenerator
+{
+  private const string MachineAttribute = "Lite.StateMachine.GeneratedStateMachineAttribute";
+  private const string StateAttribute = "Lite.StateMachine.GeneratedStateAttribute";
+  private const string StateInterface = "Lite.StateMachine.IState`1";
+
+  /// <inheritdoc/>
+  public void Initialize(IncrementalGeneratorInitializationContext context)
+  {
+    var machines = context.SyntaxProvider.ForAttributeWithMetadataName(
+      MachineAttribute,
+      static (node, _) => node is ClassDeclarationSyntax,
+      static (ctx, ct) => Transform(ctx, ct));
+
+    context.RegisterSourceOutput(machines, static (spc, model) =>
+    {
+      foreach (var diagnostic in model.Diagnostics)
+        spc.ReportDiagnostic(diagnostic.ToDiagnostic());
+
+      if (model.Source.Length > 0)
+        spc.AddSource(model.HintName, model.Source);
+    });
+  }
+
+  private static MachineModel Transform(GeneratorAttributeSyntaxContext ctx, CancellationToken ct)
+  {
+    var machine = (INamedTypeSymbol)ctx.TargetSymbol;
+    var hintName = machine.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat).Replace("global::", string.Empty) + ".g.cs";
+    var diagnostics = new List<DiagnosticInfo>();
+
+    var stateIdType = ctx.Attributes[0].ConstructorArguments.Length == 1
+      ? ctx.Attributes[0].ConstructorArguments[0].Value as INamedTypeSymbol
+      : null;
+
+    if (stateIdType is null || stateIdType.TypeKind != TypeKind.Enum || !CanExtend(machine, ct))
+    {
+      diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.InvalidMachine, ctx.TargetNode.GetLocation(), machine.Name, stateIdType?.Name ?? "?"));
+      return new MachineModel(hintName, string.Empty, new([.. diagnostics]));
+    }
+
+    var stateInterface = ctx.SemanticModel.Compilation.GetTypeByMetadataName(StateInterface)?.Construct(stateIdType);
+    var states = ReadStates(machine, stateIdType, stateInterface, diagnostics, ct);
+    Validate(states, diagnostics);
+
+    var source = diagnostics.Count == 0 ? Emit(machine, stateIdType, states) : string.Empty;
+    return new MachineModel(hintName, source, new([.. diagnostics]));
+  }
+
+  /// <summary>Gets whether a partial declaration can be emitted for the class and every type containing it.</summary>
+  /// <param name="machine">Machine class.</param>
+  /// <param name="ct">Cancellation token.</param>
+  /// <returns>True if they're all non-generic partial classes or structs.</returns>
+  private static bool CanExtend(INamedTypeSymbol machine, CancellationToken ct)
+  {
+    for (var type = machine; type is not null; type = type.ContainingType)
+    {
+      if (type.IsGenericType || type.TypeKind is not (TypeKind.Class or TypeKind.Struct))
+        return false;
+
+      var isPartial = false;
+      foreach (var reference in type.DeclaringSyntaxReferences)
+      {
+        if (reference.GetSyntax(ct) is TypeDeclarationSyntax declaration
+          && declaration.Modifiers.Any(Microsoft.CodeAnalysis.CSharp.SyntaxKind.PartialKeyword))
+        {
+          isPartial = true;
+          break;
+        }
+      }
+
+      if (!isPartial)
+        return false;
+    }
+
+    return true;
+  }
+
+  private static List<StateModel> ReadStates(INamedTypeSymbol machine, INamedTypeSymbol stateIdType, INamedTypeSymbol? stateInterface, List<DiagnosticInfo> diagnostics, CancellationToken ct)
+  {
+    var states = new List<StateModel>();
+    foreach (var attr in machine.GetAttributes())
+    {
+      ct.ThrowIfCancellationRequested();
+      if (attr.AttributeClass?.ToDisplayString() != StateAttribute || attr.ConstructorArguments.Length != 2)
+        continue;
+
+      var location = attr.ApplicationSyntaxReference?.GetSyntax(ct).GetLocation();
+      var id = ReadStateId(attr.ConstructorArguments[0], "stateId", stateIdType, location, diagnostics);
+      var stateType = attr.ConstructorArguments[1].Value as INamedTypeSymbol;
+      if (id is null)
+        continue;
+
+      if (stateType is null || !IsConstructibleState(stateType, stateInterface))
+      {
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.InvalidStateType, location, stateType?.ToDisplayString() ?? "?", stateIdType.Name));
+        continue;
+      }
+
+      var state = new StateModel(id, stateType.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat), location);
+      foreach (var named in attr.NamedArguments)
+      {
+        switch (named.Key)
+        {
+          case "OnSuccess": state.OnSuccess = ReadStateId(named.Value, named.Key, stateIdType, location, diagnostics); break;
+          case "OnError": state.OnError = ReadStateId(named.Value, named.Key, stateIdType, location, diagnostics); break;
+          case "OnFailure": state.OnFailure = ReadStateId(named.Value, named.Key, stateIdType, location, diagnostics); break;
+          case "Parent": state.Parent = ReadStateId(named.Value, named.Key, stateIdType, location, diagnostics); break;
+          case "InitialSubState":
+            state.InitialSubState = ReadStateId(named.Value, named.Key, stateIdType, location, diagnostics);
+            state.IsCompositeDeclared = true;
+            break;
+
+          case "JoinPolicy": state.JoinPolicy = named.Value.Value?.ToString() ?? "0"; break;
+          case "Regions": state.Regions = ReadRegions(named.Value, stateIdType, location, diagnostics); break;
+          case "Lifetime": state.Lifetime = named.Value.Value?.ToString() ?? "0"; break;
+        }
+      }
+
+      states.Add(state);
+    }
+
+    return states;
+  }
+
+  private static List<StateIdModel>? ReadRegions(TypedConstant value, INamedTypeSymbol stateIdType, Location? location, List<DiagnosticInfo> diagnostics)
+  {
+    if (value.IsNull || value.Kind != TypedConstantKind.Array)
+      return value.IsNull ? null : [];
+
+    var regions = new List<StateIdModel>();
+    foreach (var element in value.Values)
+    {
+      if (ReadStateId(element, "Regions", stateIdType, location, diagnostics) is { } id)
+        regions.Add(id);
+    }
+
+    return regions;
+  }
+
+  private static StateIdModel? ReadStateId(TypedConstant value, string argName, INamedTypeSymbol stateIdType, Location? location, List<DiagnosticInfo> diagnostics)
+  {
+    if (value.IsNull)
+      return null;
+
+    if (value.Kind != TypedConstantKind.Enum || !SymbolEqualityComparer.Default.Equals(value.Type, stateIdType))
+    {
+      diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.InvalidStateId, location, argName, stateIdType.Name));
+      return null;
+    }
+
+    var typeName = stateIdType.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+    foreach (var member in stateIdType.GetMembers())
+    {
+      if (member is IFieldSymbol { HasConstantValue: true } field && Equals(field.ConstantValue, value.Value))
+        return new StateIdModel(value.Value!, field.Name, $"{typeName}.{field.Name}");
+    }
+
+    // Not a named member (i.e. a cast value); parenthesized so a negative value isn't parsed as a subtraction
+    var literal = Convert.ToString(value.Value, CultureInfo.InvariantCulture)!;
+    return new StateIdModel(value.Value!, literal, $"(({typeName})({literal}))");
+  }
+
+  private static bool IsConstructibleState(INamedTypeSymbol stateType, INamedTypeSymbol? stateInterface)
+  {
+    if (stateType.TypeKind != TypeKind.Class || stateType.IsAbstract || stateType.IsUnboundGenericType)
+      return false;
+
+    var isState = false;
+    foreach (var iface in stateType.AllInterfaces)
+    {
+      if (SymbolEqualityComparer.Default.Equals(iface, stateInterface))
+      {
+        isState = true;
+        break;
+      }
+    }
+
+    if (!isState)
+      return false;
+
+    foreach (var ctor in stateType.InstanceConstructors)
+    {
+      if (ctor.Parameters.Length == 0 && ctor.DeclaredAccessibility is Accessibility.Public or Accessibility.Internal)
+        return true;
+    }
+
+    return false;
+  }
+
+  private static void Validate(List<StateModel> states, List<DiagnosticInfo> diagnostics)
+  {
+    var byId = new Dictionary<object, StateModel>();
+    foreach (var state in states)
+    {
+      if (byId.ContainsKey(state.Id.Value))
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.DuplicateState, state.Location, state.Id.Name));
+      else
+        byId[state.Id.Value] = state;
+    }
+
+    foreach (var state in states)
+    {
+      CheckRegistered(state, state.OnSuccess, "OnSuccess maps to");
+      CheckRegistered(state, state.OnError, "OnError maps to");
+      CheckRegistered(state, state.OnFailure, "OnFailure maps to");
+      CheckRegistered(state, state.InitialSubState, "has initial sub-state");
+
+      // MissingInitialSubStateException
+      if ((state.IsCompositeDeclared && state.InitialSubState is null) || state.Regions is { Count: 0 })
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.MissingInitialSubState, state.Location, state.Id.Name));
+
+      if (state.Regions is { } regions)
+        CheckRegions(state, regions);
+
+      // Sub-state must live under a composite
+      if (state.Parent is { } parentId)
+      {
+        if (!byId.TryGetValue(parentId.Value, out var parent) || !parent.IsComposite)
+        {
+          diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.ParentMustBeComposite, state.Location, parentId.Name, state.Id.Name));
+        }
+        else
+        {
+          CheckSibling(state, parent, state.OnSuccess);
+          CheckSibling(state, parent, state.OnError);
+          CheckSibling(state, parent, state.OnFailure);
+        }
+      }
+
+      // Composite's first child must be registered under it
+      if (state.InitialSubState is { } childId
+        && byId.TryGetValue(childId.Value, out var child)
+        && !Equals(child.Parent?.Value, state.Id.Value))
+      {
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.OrphanSubState, state.Location, childId.Name, state.Id.Name));
+      }
+    }
+
+    void CheckRegions(StateModel state, List<StateIdModel> regions)
+    {
+      if (state.IsCompositeDeclared)
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.InvalidParallelComposite, state.Location, state.Id.Name, "can't also set InitialSubState"));
+
+      // Regions run concurrently on one node table, so no sub-state may be reachable from two of them
+      var regionOf = new Dictionary<object, int>();
+      var pending = new Stack<StateModel>();
+      for (int r = 0; r < regions.Count; r++)
+      {
+        CheckRegistered(state, regions[r], "has region");
+        if (!byId.TryGetValue(regions[r].Value, out var first))
+          continue;
+
+        if (!Equals(first.Parent?.Value, state.Id.Value))
+        {
+          diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.OrphanSubState, state.Location, first.Id.Name, state.Id.Name));
+          continue;
+        }
+
+        pending.Push(first);
+        while (pending.Count > 0)
+        {
+          var node = pending.Pop();
+          if (regionOf.TryGetValue(node.Id.Value, out var seen))
+          {
+            if (seen != r)
+              diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.InvalidParallelComposite, state.Location, state.Id.Name, $"reaches '{node.Id.Name}' from more than one region"));
+
+            continue;
+          }
+
+          regionOf[node.Id.Value] = r;
+          foreach (var next in new[] { node.OnSuccess, node.OnError, node.OnFailure })
+          {
+            // Non-siblings are reported as disjointed
+            if (next is not null && byId.TryGetValue(next.Value, out var nextState) && Equals(nextState.Parent?.Value, state.Id.Value))
+              pending.Push(nextState);
+          }
+        }
+      }
+    }
+
+    void CheckRegistered(StateModel state, StateIdModel? target, string relation)
+    {
+      if (target is not null && !byId.ContainsKey(target.Value))
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.UnregisteredState, state.Location, state.Id.Name, relation, target.Name));
+    }
+
+    void CheckSibling(StateModel state, StateModel parent, StateIdModel? target)
+    {
+      if (target is not null && byId.TryGetValue(target.Value, out var next) && !Equals(next.Parent?.Value, parent.Id.Value))
+        diagnostics.Add(DiagnosticInfo.Create(DiagnosticDescriptors.DisjointedNextSubState, state.Location, state.Id.Name, target.Name, parent.Id.Name));
+    }
+  }
+
+  private static string Emit(INamedTypeSymbol machine, INamedTypeSymbol stateIdType, List<StateModel> states)
+  {
+    var idType = stateIdType.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+    var sb = new StringBuilder();
+    sb.AppendLine("// <auto-generated/>");
+    sb.AppendLine("#nullable enable");
+    sb.AppendLine();
+
+    if (!machine.ContainingNamespace.IsGlobalNamespace)
+    {
+      sb.Append("namespace ").Append(machine.ContainingNamespace.ToDisplayString()).AppendLine(";");
+      sb.AppendLine();
+    }
+
+    // Outer-most first
+    var containers = new List<INamedTypeSymbol>();
+    for (var type = machine; type is not null; type = type.ContainingType)
+      containers.Insert(0, type);
+
+    var indent = string.Empty;
+    foreach (var type in containers)
+    {
+      sb.Append(indent).Append("partial ").Append(type.IsRecord ? "record " : string.Empty).Append(type.TypeKind == TypeKind.Struct ? "struct " : "class ").AppendLine(type.Name);
+      sb.Append(indent).AppendLine("{");
+      indent += "  ";
+    }
+
+    sb.Append(indent).AppendLine("/// <summary>Creates a state machine with the compile-time validated topology.</summary>");
+    sb.Append(indent).AppendLine("/// <param name=\"eventAggregator\">Optional event aggregator for command states.</param>");
+    sb.Append(indent).AppendLine("/// <param name=\"isContextPersistent\">Is substate-added context persists when returning to the parent.</param>");
+    sb.Append(indent).AppendLine("/// <returns>New state machine with every state registered.</returns>");
+    sb.Append(indent).AppendLine("[global::System.CodeDom.Compiler.GeneratedCode(\"Lite.StateMachine.Generators\", \"1.0\")]");
+    sb.Append(indent).Append("public static global::Lite.StateMachine.StateMachine<").Append(idType).AppendLine("> CreateStateMachine(global::Lite.StateMachine.IEventAggregator? eventAggregator = null, bool isContextPersistent = true)");
+    sb.Append(indent).AppendLine("{");
+    sb.Append(indent).Append("  var machine = new global::Lite.StateMachine.StateMachine<").Append(idType).AppendLine(">(containerFactory: null, eventAggregator, isContextPersistent);");
+
+    foreach (var state in states)
+    {
+      if (state.Regions is { } regions)
+      {
+        sb.Append(indent).Append("  machine.RegisterParallelComposite<").Append(state.TypeName).Append(">(static () => new ").Append(state.TypeName).Append("(), ")
+          .Append(state.Id.Expression).Append(", ")
+          .Append("new ").Append(idType).Append("[] { ");
+
+        for (int r = 0; r < regions.Count; r++)
+          sb.Append(r == 0 ? string.Empty : ", ").Append(regions[r].Expression);
+
+        sb.Append(" }, ")
+          .Append("(global::Lite.StateMachine.JoinPolicy)").Append(state.JoinPolicy).Append(", ")
+          .Append(Expr(state.OnSuccess)).Append(", ")
+          .Append(Expr(state.OnError)).Append(", ")
+          .Append(Expr(state.OnFailure)).Append(", ")
+          .Append("parentStateId: ").Append(Expr(state.Parent)).AppendLine(");");
+        continue;
+      }
+
+      sb.Append(indent).Append("  machine.RegisterState<").Append(state.TypeName).Append(">(static () => new ").Append(state.TypeName).Append("(), ")
+        .Append(state.Id.Expression).Append(", ")
+        .Append(Expr(state.OnSuccess)).Append(", ")
+        .Append(Expr(state.OnError)).Append(", ")
+        .Append(Expr(state.OnFailure)).Append(", ")
+        .Append("parentStateId: ").Append(Expr(state.Parent)).Append(", ")
+        .Append("isCompositeParent: ").Append(state.InitialSubState is null ? "false" : "true").Append(", ")
+        .Append("initialChildStateId: ").Append(Expr(state.InitialSubState)).Append(", ")
+        .Append("lifetime: (global::Lite.StateMachine.StateLifetime)").Append(state.Lifetime).AppendLine(");");
+    }
+
+    sb.Append(indent).AppendLine("  return machine;");
+    sb.Append(indent).AppendLine("}");
+
+    foreach (var _ in containers)
+    {
+      indent = indent.Substring(2);
+      sb.Append(indent).AppendLine("}");
+    }
+
+    return sb.ToString();
+
+    static string Expr(StateIdModel? id) => id?.Expression ?? "null";
+  }
+
+  /// <summary>Enum value as read from an attribute argument.</summary>
+  /// <param name="Value">Underlying constant value.</param>
+  /// <param name="Name">Member name, for diagnostics.</param>
+  /// <param name="Expression">Fully qualified C# expression.</param>
+  private sealed record StateIdModel(object Value, string Name, string Expression);
+
+  /// <summary>One <c>[GeneratedState]</c>.</summary>
+  private sealed class StateModel(StateIdModel id, string typeName, Location? location)
+  {
+    public StateIdModel Id { get; } = id;
+
+    public StateIdModel? InitialSubState { get; set; }
+
+    /// <summary>Gets a value indicating whether it has an initial sub-state or at least one region.</summary>
+    public bool IsComposite => InitialSubState is not null || Regions is { Count: > 0 };
+
+    /// <summary>Gets or sets a value indicating whether <c>InitialSubState</c> was set, even to NULL.</summary>
+    public bool IsCompositeDeclared { get; set; }
+
+    public string JoinPolicy { get; set; } = "0";
+
+    public string Lifetime { get; set; } = "0";
+
+    public Location? Location { get; } = location;
+
+    public StateIdModel? OnError { get; set; }
+
+    public StateIdModel? OnFailure { get; set; }
+
+    public StateIdModel? OnSuccess { get; set; }
+
+    public StateIdModel? Parent { get; set; }
+
+    public List<StateIdModel>? Regions { get; set; }
+
+    public string TypeName { get; } = typeName;
+  }
+}
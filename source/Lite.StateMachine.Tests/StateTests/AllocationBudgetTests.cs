@@ -0,0 +1,251 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Reflection;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData.States;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+/// <summary>Allocation budgets for the transition hot path; a per-hop collection, TCS or closure fails these.</summary>
+/// <remarks>
+///   Each machine is measured twice in steady state, with a short and a long loop, so per-run costs cancel out and
+///   only the bytes of the extra transitions remain. States complete synchronously, so the run stays on the test's
+///   thread and <see cref="GC.GetAllocatedBytesForCurrentThread"/> isn't polluted by tests running in parallel.
+///   Budgets only apply to Release builds (as CI runs them); Debug compiles async methods to classes.
+/// </remarks>
+[TestClass]
+public class AllocationBudgetTests : TestBase
+{
+  /// <summary>Extra loops in the long run.</summary>
+  private const int ExtraCycles = 1_000;
+
+  /// <summary>Loops in the short run.</summary>
+  private const int ShortCycles = 10;
+
+  private enum BudgetKey
+  {
+    Counter,
+    MaxCounter,
+    Messages,
+  }
+
+  private enum BudgetStateId
+  {
+    State1,
+    State2,
+    State2_Sub1,
+    State2_Sub2,
+    State2_Sub2_Sub1,
+    State2_Sub2_Sub2,
+    State3,
+  }
+
+  [TestInitialize]
+  public void RequireOptimizedBuild()
+  {
+    var debuggable = typeof(StateMachine<>).Assembly.GetCustomAttribute<DebuggableAttribute>();
+    if (debuggable?.IsJITOptimizerDisabled == true)
+      Assert.Inconclusive("Allocation budgets are only measured against a Release build of Lite.StateMachine.");
+  }
+
+  /// <summary>Entering a command state subscribes to the aggregator, which has a fixed cost; each message must not add to it.</summary>
+  [TestMethod]
+  public void Budget_CommandStateMessages_ZeroPerMessageTest()
+  {
+    // Assemble
+    var machine = new StateMachine<BudgetStateId>(eventAggregator: new EventAggregator())
+    {
+      IsMessageRoutingEnabled = true,
+    }
+      .RegisterState<PingState>(BudgetStateId.State1, BudgetStateId.State3)
+      .RegisterState<LoopState>(BudgetStateId.State3, onSuccess: null, onError: BudgetStateId.State1);
+
+    for (int i = 0; i < 3; i++)
+      Measure(machine, cycles: 1, messages: ShortCycles + ExtraCycles);
+
+    // Act
+    var shortRun = Measure(machine, cycles: 1, messages: ShortCycles);
+    var longRun = Measure(machine, cycles: 1, messages: ShortCycles + ExtraCycles);
+
+    // Assert
+    Assert.AreEqual(0, longRun - shortRun, $"Bytes allocated by {ExtraCycles} extra messages.");
+  }
+
+  /// <summary>Command state entry, with and without the per-run routing index.</summary>
+  /// <param name="isMessageRoutingEnabled">Route through the per-run index.</param>
+  /// <param name="bytesPerEntry">Budget per command state entry (subscription and queue).</param>
+  [TestMethod]
+  [DataRow(true, 128)]
+  [DataRow(false, 768)]
+  public void Budget_CommandStateEntry_WithinBudgetTest(bool isMessageRoutingEnabled, int bytesPerEntry)
+  {
+    // Assemble
+    var machine = new StateMachine<BudgetStateId>(eventAggregator: new EventAggregator())
+    {
+      IsMessageRoutingEnabled = isMessageRoutingEnabled,
+    }
+      .RegisterState<PingState>(BudgetStateId.State1, BudgetStateId.State3)
+      .RegisterState<LoopState>(BudgetStateId.State3, onSuccess: null, onError: BudgetStateId.State1);
+
+    // Act
+    var perCycle = MeasurePerCycle(machine, messages: 1);
+
+    // Assert
+    Assert.IsLessThanOrEqualTo(bytesPerEntry, perCycle, $"Bytes allocated per command state entry (routing: {isMessageRoutingEnabled}).");
+  }
+
+  /// <summary>Nested composites, including the context scopes dropped by non-persistent parents.</summary>
+  /// <param name="isContextPersistent">Keep the sub-states' context.</param>
+  [TestMethod]
+  [DataRow(true)]
+  [DataRow(false)]
+  public void Budget_CompositeStates_ZeroPerTransitionTest(bool isContextPersistent)
+  {
+    // Assemble
+    var machine = new StateMachine<BudgetStateId>(isContextPersistent: isContextPersistent)
+      .RegisterState<SuccessState<BudgetStateId>>(BudgetStateId.State1, BudgetStateId.State2)
+      .RegisterComposite<ParentState<BudgetStateId>>(BudgetStateId.State2, BudgetStateId.State2_Sub1, onSuccess: BudgetStateId.State3)
+      .RegisterSubState<ChildState>(BudgetStateId.State2_Sub1, BudgetStateId.State2, onSuccess: BudgetStateId.State2_Sub2)
+      .RegisterSubComposite<ParentState<BudgetStateId>>(BudgetStateId.State2_Sub2, BudgetStateId.State2, BudgetStateId.State2_Sub2_Sub1)
+      .RegisterSubState<ChildState>(BudgetStateId.State2_Sub2_Sub1, BudgetStateId.State2_Sub2, onSuccess: BudgetStateId.State2_Sub2_Sub2)
+      .RegisterSubState<ChildState>(BudgetStateId.State2_Sub2_Sub2, BudgetStateId.State2_Sub2)
+      .RegisterState<LoopState>(BudgetStateId.State3, onSuccess: null, onError: BudgetStateId.State1);
+
+    // Act
+    var perCycle = MeasurePerCycle(machine, messages: 0);
+
+    // Assert
+    Assert.AreEqual(0, perCycle, "Bytes allocated per loop of 7 transitions.");
+  }
+
+  /// <summary>Leaf transitions, without a logger and with one filtering out the per-transition (Debug) messages.</summary>
+  /// <param name="hasWarningLogger">Configure a console logger at Warning.</param>
+  [TestMethod]
+  [DataRow(false)]
+  [DataRow(true)]
+  public void Budget_LeafStates_ZeroPerTransitionTest(bool hasWarningLogger)
+  {
+    // Assemble
+    using var loggerFactory = LoggerFactory.Create(b => b.SetMinimumLevel(LogLevel.Warning).AddSimpleConsole());
+    var logger = hasWarningLogger ? loggerFactory.CreateLogger<StateMachine<BudgetStateId>>() : null;
+    var machine = new StateMachine<BudgetStateId>(logger: logger)
+      .RegisterState<SuccessState<BudgetStateId>>(BudgetStateId.State1, BudgetStateId.State2)
+      .RegisterState<SuccessState<BudgetStateId>>(BudgetStateId.State2, BudgetStateId.State3)
+      .RegisterState<LoopState>(BudgetStateId.State3, onSuccess: null, onError: BudgetStateId.State1);
+
+    // Act
+    var perCycle = MeasurePerCycle(machine, messages: 0);
+
+    // Assert
+    Assert.AreEqual(0, perCycle, $"Bytes allocated per loop of 3 transitions (logger: {hasWarningLogger}).");
+  }
+
+  private static long Measure(StateMachine<BudgetStateId> machine, int cycles, int messages)
+  {
+    // Parameters are created before measuring; only the run is counted
+    machine.Context.Parameters = new()
+    {
+      { BudgetKey.Counter, 0 },
+      { BudgetKey.MaxCounter, cycles - 1 },
+      { BudgetKey.Messages, messages },
+    };
+
+    var before = GC.GetAllocatedBytesForCurrentThread();
+    var run = machine.RunAsync(BudgetStateId.State1);
+    var allocated = GC.GetAllocatedBytesForCurrentThread() - before;
+
+    Assert.IsTrue(run.IsCompletedSuccessfully, "Run must complete synchronously to be measured on this thread.");
+    return allocated;
+  }
+
+  /// <summary>Bytes allocated per loop, once the machine's instances, tables and pools are warm.</summary>
+  private static long MeasurePerCycle(StateMachine<BudgetStateId> machine, int messages)
+  {
+    for (int i = 0; i < 3; i++)
+      Measure(machine, ShortCycles + ExtraCycles, messages);
+
+    var shortRun = Measure(machine, ShortCycles, messages);
+    var longRun = Measure(machine, ShortCycles + ExtraCycles, messages);
+    return (longRun - shortRun) / ExtraCycles;
+  }
+
+  private class ChildState : IState<BudgetStateId>
+  {
+    public Task OnEnter(Context<BudgetStateId> context)
+    {
+      // Added to the child's scope; dropped again by non-persistent parents
+      context.Parameters.SafeAdd(BudgetKey.Messages, 0);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<BudgetStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<BudgetStateId> context) => Task.CompletedTask;
+  }
+
+  /// <summary>Loops back through <see cref="Result.Error"/> until the counter passes its maximum.</summary>
+  private class LoopState : IState<BudgetStateId>
+  {
+    public Task OnEnter(Context<BudgetStateId> context)
+    {
+      var counter = context.ParameterAsInt(BudgetKey.Counter) + 1;
+      context.Parameters.SafeAdd(BudgetKey.Counter, counter);
+      context.NextState(counter > context.ParameterAsInt(BudgetKey.MaxCounter) ? Result.Success : Result.Error);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<BudgetStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<BudgetStateId> context) => Task.CompletedTask;
+  }
+
+  private class PingMessage;
+
+  /// <summary>Publishes the same message to itself <see cref="BudgetKey.Messages"/> times and completes once all are handled.</summary>
+  private class PingState : ICommandState<BudgetStateId>
+  {
+    private static readonly PingMessage Ping = new();
+    private static readonly Type[] Subscriptions = [typeof(PingMessage)];
+
+    private int _expected;
+    private int _handled;
+
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => Subscriptions;
+
+    public int? TimeoutMs => 60_000;
+
+    public Task OnEnter(Context<BudgetStateId> context)
+    {
+      _handled = 0;
+      _expected = context.ParameterAsInt(BudgetKey.Messages);
+      for (int i = 0; i < _expected; i++)
+        context.EventAggregator?.Publish(Ping);
+
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<BudgetStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<BudgetStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<BudgetStateId> context, object message)
+    {
+      if (++_handled == _expected)
+        context.NextState(Result.Success);
+
+      return Task.CompletedTask;
+    }
+
+    public Task OnTimeout(Context<BudgetStateId> context)
+    {
+      context.NextState(Result.Failure);
+      return Task.CompletedTask;
+    }
+  }
+}
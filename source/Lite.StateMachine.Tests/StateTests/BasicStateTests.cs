@@ -2,7 +2,11 @@
 // See the LICENSE file in the project root for more information.
 
 using System;
+using System.Buffers;
+using System.IO;
 using System.Linq;
+using System.Text;
+using System.Threading;
 using System.Threading.Tasks;
 using Lite.StateMachine.Tests.TestData;
 using Lite.StateMachine.Tests.TestData.States;
@@ -136,6 +140,106 @@ public class BasicStateTests : TestBase
     Assert.IsTrue(enums.SequenceEqual(machine.States), "States should be registered for execution in the same order as the defined enums, StateId 1 => 2 => 3.");
   }
 
+  /// <summary>Registering after <see cref="StateMachine{TStateId}.Build"/> recompiles the transition table on the next run.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Basic_RegisterAfterBuild_Executes123_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<BasicStateId>()
+      .RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2, BasicStateId.State3)
+      .Build();
+
+    machine.RegisterState<BasicState3>(BasicStateId.State3);
+    machine.AddContext(new()
+    {
+      { ParameterType.Counter, 0 },
+      { ParameterType.TestExecutionOrder, true },
+    });
+
+    // Act
+    await machine.RunAsync(BasicStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    AssertMachineNotNull(machine);
+    Assert.AreEqual(9, machine.Context.ParameterAsInt(ParameterType.Counter));
+  }
+
+  /// <summary>Sparse (hand-numbered) enums fall back to the non-dense state lookup.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Basic_SparseStateIds_Executes_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<SparseStateId>()
+      .RegisterState<SparseState>(SparseStateId.First, SparseStateId.Middle)
+      .RegisterState<SparseState>(SparseStateId.Middle, SparseStateId.Last)
+      .RegisterState<SparseState>(SparseStateId.Last)
+      .AddContext(new() { { ParameterType.Counter, 0 } });
+
+    // Act
+    await machine.RunAsync(SparseStateId.First, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(3, machine.Context.ParameterAsInt(ParameterType.Counter));
+    Assert.AreEqual(SparseStateId.Middle, machine.Context.PreviousStateId);
+  }
+
+  /// <summary>An enum spanning the whole <see cref="long"/> range doesn't overflow the dense lookup's span.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Basic_FullRangeLongStateIds_Executes_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<WideStateId>()
+      .RegisterState<SuccessState<WideStateId>>(WideStateId.Min, WideStateId.Max)
+      .RegisterState<SuccessState<WideStateId>>(WideStateId.Max);
+
+    // Act
+    await machine.RunAsync(WideStateId.Min, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(WideStateId.Max, machine.Context.CurrentStateId);
+    Assert.AreEqual(WideStateId.Min, machine.Context.PreviousStateId);
+  }
+
+  /// <summary>States setting their result inside OnEnter never wait, so the whole run completes synchronously.</summary>
+  [TestMethod]
+  public void Basic_ResultSetInOnEnter_CompletesSynchronously_SuccessTest()
+  {
+    // Assemble
+    var machine = new StateMachine<SparseStateId>()
+      .RegisterState<SparseState>(SparseStateId.First, SparseStateId.Middle)
+      .RegisterState<SparseState>(SparseStateId.Middle, SparseStateId.Last)
+      .RegisterState<SparseState>(SparseStateId.Last)
+      .AddContext(new() { { ParameterType.Counter, 0 } });
+
+    // Act
+    var task = machine.RunAsync(SparseStateId.First, TestContext.CancellationToken);
+
+    // Assert
+    Assert.IsTrue(task.IsCompletedSuccessfully, "No state awaited, so the run should not have yielded.");
+    Assert.AreEqual(3, machine.Context.ParameterAsInt(ParameterType.Counter));
+  }
+
+  /// <summary>A result set from another thread while OnEnter returns is either awaited or read, never read half-set.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Basic_ResultSetFromOtherThread_NeverReadEarly_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<SparseStateId>()
+      .RegisterState<RacingState>(SparseStateId.First, SparseStateId.First)
+      .AddContext(new() { { ParameterType.Counter, 0 } });
+
+    // Act
+    await machine.RunAsync(SparseStateId.First, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(RacingState.Entries, machine.Context.ParameterAsInt(ParameterType.Counter));
+  }
+
   [TestMethod]
   public void ExportUml_SuccessTest()
   {
@@ -164,6 +268,44 @@ public class BasicStateTests : TestBase
     Console.WriteLine(umlLegend);
   }
 
+  [TestMethod]
+  public void ExportUml_StreamsCachedOutput_UntilRegistrationChanges_SuccessTest()
+  {
+    // Assemble
+    var machine = new StateMachine<BasicStateId>()
+      .RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2);
+
+    // Act
+    var first = machine.ExportUml([BasicStateId.State1]);
+    var second = machine.ExportUml([BasicStateId.State1]);
+
+    var textWriter = new StringWriter();
+    machine.ExportUml(textWriter, [BasicStateId.State1]);
+
+    var bufferWriter = new ArrayBufferWriter<byte>();
+    machine.ExportUml(bufferWriter, [BasicStateId.State1]);
+
+    var mermaid = machine.ExportMermaid([BasicStateId.State1]);
+
+    machine.RegisterState<BasicState3>(BasicStateId.State3);
+    var afterRegister = machine.ExportUml([BasicStateId.State1]);
+
+    // Assert
+    Assert.AreSame(first, second, "Unchanged topology and options should reuse the cached export.");
+    Assert.AreEqual(first, textWriter.ToString());
+    Assert.AreEqual(first, Encoding.UTF8.GetString(bufferWriter.WrittenSpan));
+    Assert.AreNotSame(first, machine.ExportUml([BasicStateId.State2]));
+
+    Assert.StartsWith("stateDiagram-v2", mermaid);
+    Assert.Contains("[*] --> State1", mermaid);
+    Assert.Contains("State1 --> State2 : Success", mermaid);
+    Assert.Contains("State2 --> [*]", mermaid);
+
+    Assert.DoesNotContain("State3", first);
+    Assert.Contains("State3", afterRegister);
+  }
+
   [TestMethod]
   public async Task HungState_Proceeds_DefaultStateTimeout_SuccessTestAsync()
   {
@@ -196,4 +338,52 @@ public class BasicStateTests : TestBase
     Assert.HasCount(enums.Count(), machine.States);
     Assert.IsTrue(enums.All(k => machine.States.Contains(k)));
   }
+
+  private enum SparseStateId
+  {
+    First = -50,
+    Middle = 10_000,
+    Last = 1_000_000,
+  }
+
+  private enum WideStateId : long
+  {
+    Min = long.MinValue,
+    Max = long.MaxValue,
+  }
+
+  /// <summary>Re-enters itself, its result set on the thread pool racing OnEnter's return, until <see cref="Entries"/>.</summary>
+  private class RacingState : IState<SparseStateId>
+  {
+    public const int Entries = 5_000;
+
+    public Task OnEnter(Context<SparseStateId> context)
+    {
+      var count = context.ParameterAsInt(ParameterType.Counter) + 1;
+      context.Parameters[ParameterType.Counter] = count;
+      if (count == Entries)
+        context.NextStates.OnSuccess = null;
+
+      ThreadPool.UnsafeQueueUserWorkItem(static c => c.NextState(Result.Success), context, preferLocal: false);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<SparseStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<SparseStateId> context) => Task.CompletedTask;
+  }
+
+  private class SparseState : IState<SparseStateId>
+  {
+    public Task OnEnter(Context<SparseStateId> context)
+    {
+      context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<SparseStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<SparseStateId> context) => Task.CompletedTask;
+  }
 }
@@ -0,0 +1,301 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class CheckpointTests : TestBase
+{
+  private enum CheckpointKey
+  {
+    Counter,
+    Homed,
+    Visited,
+  }
+
+  private enum CheckpointStateId
+  {
+    Start,
+    Parent,
+    Homing,
+    Calibrate,
+    Work,
+    Done,
+  }
+
+  /// <summary>A fresh machine (i.e. after a restart) resumes inside the composite without repeating the completed states.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Resume_InsideComposite_SkipsCompletedStates_SuccessTestAsync()
+  {
+    // Assemble
+    var serializer = new CounterSerializer();
+    var checkpoint = new ArrayBufferWriter<byte>();
+    var visited = new List<CheckpointStateId>();
+
+    var machine = CreateMachine(visited);
+    machine.CheckpointHandler = run =>
+    {
+      // Invoked on every transition; keep the one taken entering Calibrate
+      if (run.Context.CurrentStateId == CheckpointStateId.Calibrate)
+        run.WriteCheckpoint(checkpoint, serializer);
+    };
+
+    await machine.RunAsync(CheckpointStateId.Start, TestContext.CancellationToken);
+    CollectionAssert.AreEqual(
+      new[] { CheckpointStateId.Start, CheckpointStateId.Parent, CheckpointStateId.Homing, CheckpointStateId.Calibrate, CheckpointStateId.Work, CheckpointStateId.Done },
+      visited);
+
+    var resumedVisits = new List<CheckpointStateId>();
+    var resumed = CreateMachine(resumedVisits);
+
+    // Act
+    await resumed.ResumeAsync(checkpoint.WrittenMemory, serializer, TestContext.CancellationToken);
+
+    // Assert
+    // Parent is re-entered, then its sub-states continue at Calibrate instead of Homing
+    CollectionAssert.AreEqual(
+      new[] { CheckpointStateId.Parent, CheckpointStateId.Calibrate, CheckpointStateId.Work, CheckpointStateId.Done },
+      resumedVisits);
+
+    // Start, Parent and Homing had counted before the checkpoint
+    Assert.AreEqual(7, resumed.Context.ParameterAsInt(CheckpointKey.Counter));
+    Assert.AreEqual(CheckpointStateId.Parent, resumed.Context.PreviousStateId);
+  }
+
+  /// <summary>A completed run's checkpoint restores overrides and context without entering a state.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Resume_CompletedRun_RestoresOverridesOnly_SuccessTestAsync()
+  {
+    // Assemble
+    var serializer = new CounterSerializer();
+    var machine = new StateMachine<CheckpointStateId>()
+      .RegisterState<SkipParentState>(CheckpointStateId.Start, CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Done)
+      .AddContext(new() { { CheckpointKey.Visited, new List<CheckpointStateId>() } });
+
+    await machine.RunAsync(CheckpointStateId.Start, TestContext.CancellationToken);
+
+    var checkpoint = new ArrayBufferWriter<byte>();
+    machine.WriteCheckpoint(checkpoint, serializer);
+
+    var visited = new List<CheckpointStateId>();
+    var resumed = new StateMachine<CheckpointStateId>()
+      .RegisterState<SkipParentState>(CheckpointStateId.Start, CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Done)
+      .AddContext(new() { { CheckpointKey.Visited, visited } });
+
+    // Act
+    await resumed.ResumeAsync(checkpoint.WrittenMemory, serializer, TestContext.CancellationToken);
+
+    var roundTrip = new ArrayBufferWriter<byte>();
+    resumed.WriteCheckpoint(roundTrip, serializer);
+
+    // Assert
+    Assert.IsEmpty(visited);
+    Assert.AreEqual(2, resumed.Context.ParameterAsInt(CheckpointKey.Counter));
+    CollectionAssert.AreEqual(checkpoint.WrittenSpan.ToArray(), roundTrip.WrittenSpan.ToArray());
+  }
+
+  /// <summary>Overrides the run made since are replaced by the checkpoint's, not merged with them.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Resume_ClearsOverridesNotInCheckpoint_SuccessTestAsync()
+  {
+    // Assemble
+    var serializer = new CounterSerializer();
+    var machine = new StateMachine<CheckpointStateId>()
+      .RegisterState<SkipParentState>(CheckpointStateId.Start, CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Done)
+      .AddContext(new() { { CheckpointKey.Visited, new List<CheckpointStateId>() } });
+
+    // Before any state ran; no overrides
+    var checkpoint = new ArrayBufferWriter<byte>();
+    machine.WriteCheckpoint(checkpoint, serializer);
+
+    await machine.RunAsync(CheckpointStateId.Start, TestContext.CancellationToken);
+
+    var overridden = new ArrayBufferWriter<byte>();
+    machine.WriteCheckpoint(overridden);
+
+    // Act
+    await machine.ResumeAsync(checkpoint.WrittenMemory, serializer, TestContext.CancellationToken);
+
+    var roundTrip = new ArrayBufferWriter<byte>();
+    machine.WriteCheckpoint(roundTrip, serializer);
+
+    // Assert
+    // Completed (no levels), so the override count follows the 8 byte header
+    Assert.AreEqual(1, BinaryPrimitives.ReadInt32LittleEndian(overridden.WrittenSpan[8..]), "Run left Start's OnSuccess override");
+    Assert.AreEqual(0, BinaryPrimitives.ReadInt32LittleEndian(roundTrip.WrittenSpan[8..]), "Start's OnSuccess override should be gone");
+  }
+
+  /// <summary>A non-persistent context restores each composite's keys into its scope, so they're still dropped when it exits.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Resume_NonPersistentContext_RestoresCompositeScopes_SuccessTestAsync()
+  {
+    // Assemble
+    var serializer = new CounterSerializer();
+    var checkpoint = new ArrayBufferWriter<byte>();
+    var machine = CreateMachine([], isContextPersistent: false);
+    machine.CheckpointHandler = run =>
+    {
+      if (run.Context.CurrentStateId == CheckpointStateId.Calibrate)
+        run.WriteCheckpoint(checkpoint, serializer);
+    };
+
+    await machine.RunAsync(CheckpointStateId.Start, TestContext.CancellationToken);
+    Assert.IsFalse(machine.Context.Parameters.ContainsKey(CheckpointKey.Homed), "Dropped with the Parent's scope");
+
+    var resumed = CreateMachine([], isContextPersistent: false);
+
+    // Act
+    await resumed.ResumeAsync(checkpoint.WrittenMemory, serializer, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(7, resumed.Context.ParameterAsInt(CheckpointKey.Counter), "Added outside of the Parent; kept");
+    Assert.IsFalse(resumed.Context.Parameters.ContainsKey(CheckpointKey.Homed), "Added inside the Parent; dropped");
+  }
+
+  /// <summary>Resuming an already used machine replaces its context; stale keys and scopes left open are dropped, <c>AddContext</c> entries kept.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Resume_UsedMachine_ReplacesContext_SuccessTestAsync()
+  {
+    // Assemble
+    var serializer = new CounterSerializer();
+    var checkpoint = new ArrayBufferWriter<byte>();
+    var visited = new List<CheckpointStateId>();
+    var machine = CreateMachine(visited, isContextPersistent: false);
+    machine.CheckpointHandler = run =>
+    {
+      if (run.Context.CurrentStateId == CheckpointStateId.Calibrate)
+        run.WriteCheckpoint(checkpoint, serializer);
+    };
+
+    await machine.RunAsync(CheckpointStateId.Start, TestContext.CancellationToken);
+    machine.CheckpointHandler = null;
+
+    // As left by a run cancelled inside a composite
+    machine.Context.Parameters.PushScope();
+    machine.Context.Parameters.Set("Stale", true);
+    visited.Clear();
+
+    // Act
+    await machine.ResumeAsync(checkpoint.WrittenMemory, serializer, TestContext.CancellationToken);
+
+    // Assert
+    CollectionAssert.AreEqual(
+      new[] { CheckpointStateId.Parent, CheckpointStateId.Calibrate, CheckpointStateId.Work, CheckpointStateId.Done },
+      visited);
+
+    Assert.AreEqual(7, machine.Context.ParameterAsInt(CheckpointKey.Counter));
+    Assert.IsFalse(machine.Context.Parameters.ContainsKey("Stale"));
+    Assert.AreEqual(0, machine.Context.Parameters.ScopeCount, "Nothing left open under the resumed composite");
+    Assert.HasCount(2, machine.Context.Parameters, "Counter and the AddContext Visited list");
+  }
+
+  [TestMethod]
+  public async Task Resume_InvalidCheckpoint_ThrowsTestAsync()
+  {
+    // Assemble
+    var machine = CreateMachine([]);
+
+    // Act/Assert
+    await Assert.ThrowsExactlyAsync<InvalidCheckpointException>(() =>
+      machine.ResumeAsync(new byte[] { 1, 2, 3, 4, 5, 6, 7, 8 }, cancellationToken: TestContext.CancellationToken));
+  }
+
+  private static StateMachine<CheckpointStateId> CreateMachine(List<CheckpointStateId> visited, bool isContextPersistent = true) =>
+    new StateMachine<CheckpointStateId>(isContextPersistent: isContextPersistent)
+      .RegisterState<LogState>(CheckpointStateId.Start, CheckpointStateId.Parent)
+      .RegisterComposite<LogState>(CheckpointStateId.Parent, CheckpointStateId.Homing, onSuccess: CheckpointStateId.Done)
+      .RegisterSubState<HomingState>(CheckpointStateId.Homing, CheckpointStateId.Parent, onSuccess: CheckpointStateId.Calibrate)
+      .RegisterSubState<LogState>(CheckpointStateId.Calibrate, CheckpointStateId.Parent, onSuccess: CheckpointStateId.Work)
+      .RegisterSubState<LogState>(CheckpointStateId.Work, CheckpointStateId.Parent)
+      .RegisterState<LogState>(CheckpointStateId.Done)
+      .AddContext(new() { { CheckpointKey.Visited, visited } });
+
+  /// <summary>Only the counter and homed flag are persisted; the visited log is re-added by the restarted machine.</summary>
+  private class CounterSerializer : IContextSerializer
+  {
+    private const int RecordSize = 1 + sizeof(int);
+
+    public void Deserialize(ReadOnlySpan<byte> data, PropertyBag bag)
+    {
+      for (; data.Length >= RecordSize; data = data[RecordSize..])
+        bag.Set((CheckpointKey)data[0], BinaryPrimitives.ReadInt32LittleEndian(data[1..]));
+    }
+
+    public void Serialize(PropertyBag bag, IBufferWriter<byte> writer)
+    {
+      foreach (var key in new[] { CheckpointKey.Counter, CheckpointKey.Homed })
+      {
+        if (!bag.TryGetValue(key, out int value))
+          continue;
+
+        var span = writer.GetSpan(RecordSize);
+        span[0] = (byte)key;
+        BinaryPrimitives.WriteInt32LittleEndian(span[1..], value);
+        writer.Advance(RecordSize);
+      }
+    }
+  }
+
+  /// <summary>Adds <see cref="CheckpointKey.Homed"/>, scoped to the composite when the context isn't persistent.</summary>
+  private class HomingState : LogState
+  {
+    public override Task OnEnter(Context<CheckpointStateId> context)
+    {
+      context.Parameters.Set(CheckpointKey.Homed, 1);
+      return base.OnEnter(context);
+    }
+  }
+
+  private class LogState : IState<CheckpointStateId>
+  {
+    public virtual Task OnEnter(Context<CheckpointStateId> context)
+    {
+      ((List<CheckpointStateId>)context.Parameters[CheckpointKey.Visited]!).Add(context.CurrentStateId);
+      context.Parameters.Set(CheckpointKey.Counter, context.ParameterAsInt(CheckpointKey.Counter) + 1);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<CheckpointStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<CheckpointStateId> context)
+    {
+      // Composite parents decide on exit
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Overrides its transition to skip <see cref="CheckpointStateId.Parent"/>.</summary>
+  private class SkipParentState : IState<CheckpointStateId>
+  {
+    public Task OnEnter(Context<CheckpointStateId> context)
+    {
+      context.Parameters.Set(CheckpointKey.Counter, context.ParameterAsInt(CheckpointKey.Counter) + 1);
+      context.NextStates.OnSuccess = CheckpointStateId.Done;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<CheckpointStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<CheckpointStateId> context) => Task.CompletedTask;
+  }
+}
@@ -3,6 +3,8 @@
 
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
 using Lite.StateMachine.Tests.TestData;
@@ -17,6 +19,19 @@ namespace Lite.StateMachine.Tests.StateTests;
 [TestClass]
 public class CommandStateTests : TestBase
 {
+  /// <summary>Allowed Stopwatch vs. Environment.TickCount64 disagreement.</summary>
+  private const int TimerWheelSlackMs = 20;
+
+  private enum QueueParam
+  {
+    Batches,
+    Handled,
+    InOrder,
+    LargestBatch,
+    MaxConcurrent,
+    TimedOut,
+  }
+
   [TestMethod]
   public async Task BasicState_Override_Executes_SuccessAsync()
   {
@@ -140,6 +155,158 @@ public class CommandStateTests : TestBase
     Assert.AreEqual(100, counter);
   }
 
+  /// <summary>Queued messages are handled one at a time, in order, with publishers waiting when full.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task MessageQueue_Wait_HandlesAllMessagesSerialized_SuccessTestAsync()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    var machine = new StateMachine<StateId>(eventAggregator: events)
+    {
+      MessageQueueCapacity = 2,
+      MessageQueueFullMode = System.Threading.Channels.BoundedChannelFullMode.Wait,
+    };
+
+    machine.RegisterState<QueuedState>(StateId.State1);
+
+    // Act
+    await machine.RunAsync(StateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    var ctx = machine.Context;
+    Assert.AreEqual(QueuedState.MessageCount, ctx.ParameterAsInt(QueueParam.Handled));
+    Assert.AreEqual(1, ctx.ParameterAsInt(QueueParam.MaxConcurrent));
+    Assert.IsTrue(ctx.ParameterAsBool(QueueParam.InOrder));
+  }
+
+  /// <summary>A full queue drops messages instead of blocking the publisher; the state times out.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task MessageQueue_DropWrite_DropsWhenFull_SuccessTestAsync()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    var machine = new StateMachine<StateId>(eventAggregator: events)
+    {
+      DefaultCommandTimeoutMs = 500,
+      MessageQueueCapacity = 1,
+      MessageQueueFullMode = System.Threading.Channels.BoundedChannelFullMode.DropWrite,
+    };
+
+    machine.RegisterState<QueuedState>(StateId.State1);
+
+    // Act
+    await machine.RunAsync(StateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    var ctx = machine.Context;
+    Assert.IsTrue(ctx.ParameterAsBool(QueueParam.TimedOut));
+    Assert.IsLessThan(QueuedState.MessageCount, ctx.ParameterAsInt(QueueParam.Handled));
+    Assert.AreEqual(1, ctx.ParameterAsInt(QueueParam.MaxConcurrent));
+  }
+
+  /// <summary>Command timeouts of many concurrent machines are all serviced by the shared timer wheel.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task CommandTimeout_ManyMachines_AllTimeOut_SuccessTestAsync()
+  {
+    // Assemble
+    const int MachineCount = 200;
+    var machines = Enumerable.Range(0, MachineCount)
+      .Select(_ => new StateMachine<StateId>(eventAggregator: new EventAggregator()) { DefaultCommandTimeoutMs = 100 }
+        .RegisterState<TimeoutOnlyState>(StateId.State1))
+      .ToArray();
+
+    // Act
+    var sw = Stopwatch.StartNew();
+    await Task.WhenAll(machines.Select(m => m.RunAsync(StateId.State1, TestContext.CancellationToken)));
+    sw.Stop();
+
+    // Assert
+    Assert.IsTrue(machines.All(m => m.Context.ParameterAsBool(QueueParam.TimedOut)));
+    Assert.IsGreaterThanOrEqualTo(100 - TimerWheelSlackMs, sw.ElapsedMilliseconds);
+  }
+
+  /// <summary>Batch states receive queued messages in groups no larger than their batch size, in order.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task MessageBatch_DrainsQueueInBatches_SuccessTestAsync()
+  {
+    // Assemble - Queue disabled; batch states use an unbounded one regardless
+    var events = new EventAggregator();
+    var machine = new StateMachine<StateId>(eventAggregator: events);
+    machine.RegisterState<BatchedState>(StateId.State1);
+
+    // Act
+    await machine.RunAsync(StateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    var ctx = machine.Context;
+    Assert.AreEqual(BatchedState.MessageCount, ctx.ParameterAsInt(QueueParam.Handled));
+    Assert.IsTrue(ctx.ParameterAsBool(QueueParam.InOrder));
+    Assert.IsLessThanOrEqualTo(BatchedState.BatchSize, ctx.ParameterAsInt(QueueParam.LargestBatch));
+    Assert.IsLessThan(BatchedState.MessageCount, ctx.ParameterAsInt(QueueParam.Batches));
+    Assert.AreEqual(1, ctx.ParameterAsInt(QueueParam.MaxConcurrent));
+  }
+
+  /// <summary>Routed command states receive messages by interface, across re-entries, and only while active.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task MessageRouting_DeliversByInterface_OnlyWhileActive_SuccessTestAsync()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    var machine = new StateMachine<StateId>(eventAggregator: events)
+    {
+      DefaultCommandTimeoutMs = 3000,
+      IsMessageRoutingEnabled = true,
+    };
+
+    machine
+      .RegisterState<RoutedState>(StateId.State1, StateId.State2)
+      .RegisterState<RoutedState>(StateId.State2, StateId.State3)
+      .RegisterState<RoutedState>(StateId.State3);
+
+    // Act
+    await machine.RunAsync(StateId.State1, TestContext.CancellationToken);
+    await machine.RunAsync(StateId.State3, TestContext.CancellationToken);
+    events.Publish(new UnlockCommand());
+
+    // Assert
+    var ctx = machine.Context;
+    Assert.AreEqual(4, ctx.ParameterAsInt(QueueParam.Handled));
+    Assert.IsFalse(ctx.ParameterAsBool(QueueParam.TimedOut));
+  }
+
+  /// <summary>Each transient instance's own subscriptions are routed, not the first instance's.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task MessageRouting_TransientInstances_RoutesEachInstancesSubscription_SuccessTestAsync()
+  {
+    // Assemble
+    var created = 0;
+    var events = new EventAggregator();
+    var machine = new StateMachine<StateId>(
+      _ => new SubscribingState(created++ % 2 == 0 ? new UnlockCommand() : new CancelCommand()),
+      events)
+    {
+      DefaultCommandTimeoutMs = 3000,
+      IsMessageRoutingEnabled = true,
+    };
+
+    machine.RegisterState<SubscribingState>(StateId.State1, lifetime: StateLifetime.Transient);
+
+    // Act
+    for (int i = 0; i < 3; i++)
+      await machine.RunAsync(StateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(3, created);
+    Assert.AreEqual(3, machine.Context.ParameterAsInt(QueueParam.Handled));
+    Assert.IsFalse(machine.Context.ParameterAsBool(QueueParam.TimedOut));
+  }
+
 #pragma warning disable SA1124 // Do not use regions
   #region Infinite Loop Test State Classes
 
@@ -184,4 +351,216 @@ public class CommandStateTests : TestBase
   }
 
   #endregion Infinite Loop Test State Classes
+
+  #region Message Queue Test State Classes
+
+  /// <summary>Publishes a burst of messages to itself and handles them slowly.</summary>
+  private class QueuedState : ICommandState<StateId>
+  {
+    public const int MessageCount = 10;
+
+    private int _concurrent;
+    private int _handled;
+    private bool _inOrder = true;
+    private int _lastCounter;
+    private int _maxConcurrent;
+    private bool _timedOut;
+
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(UnlockCommand)];
+
+    public Task OnEnter(Context<StateId> context)
+    {
+      for (int i = 1; i <= MessageCount; i++)
+        context.EventAggregator?.Publish(new UnlockCommand { Counter = i });
+
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<StateId> context)
+    {
+      context.Parameters.Set(QueueParam.Handled, _handled);
+      context.Parameters.Set(QueueParam.InOrder, _inOrder);
+      context.Parameters.Set(QueueParam.MaxConcurrent, _maxConcurrent);
+      context.Parameters.Set(QueueParam.TimedOut, _timedOut);
+      return Task.CompletedTask;
+    }
+
+    public async Task OnMessage(Context<StateId> context, object message)
+    {
+      _maxConcurrent = Math.Max(_maxConcurrent, Interlocked.Increment(ref _concurrent));
+
+      // Slow handler
+      await Task.Delay(5);
+
+      var counter = ((UnlockCommand)message).Counter;
+      _inOrder &= counter > _lastCounter;
+      _lastCounter = counter;
+      _handled++;
+
+      Interlocked.Decrement(ref _concurrent);
+      if (_handled == MessageCount)
+        context.NextState(Result.Success);
+    }
+
+    public Task OnTimeout(Context<StateId> context)
+    {
+      _timedOut = true;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Publishes a burst of messages to itself and handles them in batches.</summary>
+  private class BatchedState : IBatchCommandState<StateId>
+  {
+    public const int BatchSize = 4;
+    public const int MessageCount = 10;
+
+    private int _batches;
+    private int _concurrent;
+    private int _handled;
+    private bool _inOrder = true;
+    private int _largestBatch;
+    private int _lastCounter;
+    private int _maxConcurrent;
+
+    public int MaxBatchLingerMs => 50;
+
+    public int MaxBatchSize => BatchSize;
+
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(UnlockCommand)];
+
+    public Task OnEnter(Context<StateId> context)
+    {
+      for (int i = 1; i <= MessageCount; i++)
+        context.EventAggregator?.Publish(new UnlockCommand { Counter = i });
+
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<StateId> context)
+    {
+      context.Parameters.Set(QueueParam.Batches, _batches);
+      context.Parameters.Set(QueueParam.Handled, _handled);
+      context.Parameters.Set(QueueParam.InOrder, _inOrder);
+      context.Parameters.Set(QueueParam.LargestBatch, _largestBatch);
+      context.Parameters.Set(QueueParam.MaxConcurrent, _maxConcurrent);
+      return Task.CompletedTask;
+    }
+
+    public async Task OnMessageBatch(Context<StateId> context, ReadOnlyMemory<object> messages)
+    {
+      _maxConcurrent = Math.Max(_maxConcurrent, Interlocked.Increment(ref _concurrent));
+      _batches++;
+      _largestBatch = Math.Max(_largestBatch, messages.Length);
+
+      for (int i = 0; i < messages.Length; i++)
+      {
+        var counter = ((UnlockCommand)messages.Span[i]).Counter;
+        _inOrder &= counter > _lastCounter;
+        _lastCounter = counter;
+        _handled++;
+      }
+
+      // Slow handler
+      await Task.Delay(5);
+
+      Interlocked.Decrement(ref _concurrent);
+      if (_handled == MessageCount)
+        context.NextState(Result.Success);
+    }
+
+    public Task OnTimeout(Context<StateId> context)
+    {
+      context.NextState(Result.Error);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Subscribes by interface and publishes a concrete message to itself.</summary>
+  private class RoutedState : ICommandState<StateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(ICustomCommand)];
+
+    public Task OnEnter(Context<StateId> context)
+    {
+      context.EventAggregator?.Publish(new UnlockCommand());
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<StateId> context, object message)
+    {
+      context.Parameters.Set(QueueParam.Handled, context.ParameterAsInt(QueueParam.Handled) + 1);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnTimeout(Context<StateId> context)
+    {
+      context.Parameters.Set(QueueParam.TimedOut, true);
+      context.NextState(Result.Failure);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Subscribes to only the type of the message it publishes to itself.</summary>
+  private class SubscribingState(object outgoing) : ICommandState<StateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [outgoing.GetType()];
+
+    public Task OnEnter(Context<StateId> context)
+    {
+      context.EventAggregator?.Publish(outgoing);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<StateId> context, object message)
+    {
+      context.Parameters.Set(QueueParam.Handled, context.ParameterAsInt(QueueParam.Handled) + 1);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnTimeout(Context<StateId> context)
+    {
+      context.Parameters.Set(QueueParam.TimedOut, true);
+      context.NextState(Result.Failure);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Waits for its command timeout.</summary>
+  private class TimeoutOnlyState : ICommandState<StateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(UnlockResponse)];
+
+    public Task OnEnter(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnEntering(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<StateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<StateId> context, object message) => Task.CompletedTask;
+
+    public Task OnTimeout(Context<StateId> context)
+    {
+      context.Parameters.Set(QueueParam.TimedOut, true);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+  }
+
+  #endregion Message Queue Test State Classes
 }
@@ -56,6 +56,24 @@ public class ContextTests : TestBase
     Assert.IsTrue(enums.SequenceEqual(machine.States), "States should be registered for execution in the same order as the defined enums, StateId 1 => 2 => 3.");
   }
 
+  /// <summary>The object-key overloads kept for binary compatibility read the same entries as the typed ones.</summary>
+  [TestMethod]
+  public void ParameterAs_ObjectKey_MatchesTypedKeyTest()
+  {
+    // Assemble
+    var machine = new StateMachine<CtxStateId>()
+      .AddContext(new() { { ParameterType.Param1, 7 }, { ParameterKeyTest, true } });
+
+    // Act
+    object key = ParameterType.Param1;
+
+    // Assert
+    Assert.AreEqual(machine.Context.ParameterAsInt(ParameterType.Param1), machine.Context.ParameterAsInt(key));
+    Assert.AreEqual(7, machine.Context.ParameterAsInt(key));
+    Assert.IsTrue(machine.Context.ParameterAsBool((object)ParameterKeyTest));
+    Assert.AreEqual(-1, machine.Context.ParameterAsInt((object)ParameterCounter, -1));
+  }
+
   private class CtxState1 : StateBase<CtxState1, CtxStateId>
   {
     public override Task OnEnter(Context<CtxStateId> context)
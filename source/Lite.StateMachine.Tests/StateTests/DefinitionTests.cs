@@ -0,0 +1,101 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Linq;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData;
+using Lite.StateMachine.Tests.TestData.States;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class DefinitionTests : TestBase
+{
+  /// <summary>One definition, many concurrent runs, each with its own context and state instances.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Definition_ConcurrentRuns_Executes123_SuccessTestAsync()
+  {
+    // Assemble
+    var definition = new StateMachine<BasicStateId>()
+      .RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2, BasicStateId.State3)
+      .RegisterState<BasicState3>(BasicStateId.State3)
+      .BuildDefinition();
+
+    var runs = Enumerable.Range(0, 16)
+      .Select(_ => definition.CreateRun(parameters: new() { { ParameterType.Counter, 0 }, { ParameterType.TestExecutionOrder, true } }))
+      .ToArray();
+
+    // Act
+    await Task.WhenAll(runs.Select(r => r.RunAsync(BasicStateId.State1, TestContext.CancellationToken)));
+
+    // Assert
+    foreach (var run in runs)
+    {
+      Assert.AreEqual(9, run.Context.ParameterAsInt(ParameterType.Counter));
+      Assert.AreEqual(BasicStateId.State2, run.Context.PreviousStateId);
+    }
+  }
+
+  /// <summary>The definition is a snapshot; it's rebuilt only after registrations change.</summary>
+  [TestMethod]
+  public void Definition_Snapshot_RebuiltOnRegistrationTest()
+  {
+    // Assemble
+    var machine = new StateMachine<BasicStateId>()
+      .RegisterState<BasicState1>(BasicStateId.State1, BasicStateId.State2);
+
+    // Act
+    var first = machine.BuildDefinition();
+    var same = machine.BuildDefinition();
+    machine.RegisterState<BasicState2>(BasicStateId.State2);
+    var rebuilt = machine.BuildDefinition();
+
+    // Assert
+    Assert.AreSame(first, same);
+    Assert.AreNotSame(first, rebuilt);
+    Assert.HasCount(1, first.States);
+    Assert.IsTrue(new[] { BasicStateId.State1, BasicStateId.State2 }.SequenceEqual(rebuilt.States));
+  }
+
+  /// <summary>Sub-state mapping outside its composite is rejected when the definition is built, before any state runs.</summary>
+  [TestMethod]
+  public void Definition_DisjointedSubState_ThrowsOnBuildTest()
+  {
+    // Assemble
+    var machine = new StateMachine<CompositeL1StateId>()
+      .RegisterState<CompositeL1_State1>(CompositeL1StateId.State1, CompositeL1StateId.State2)
+      .RegisterComposite<CompositeL1_State2>(CompositeL1StateId.State2, CompositeL1StateId.State2_Sub1, CompositeL1StateId.State3)
+      .RegisterSubState<CompositeL1_State2_Sub1>(CompositeL1StateId.State2_Sub1, CompositeL1StateId.State2, onSuccess: CompositeL1StateId.State3)
+      .RegisterState<CompositeL1_State3>(CompositeL1StateId.State3);
+
+    // Act/Assert
+    Assert.ThrowsExactly<DisjointedNextSubStateException>(() => machine.BuildDefinition());
+  }
+
+  /// <summary>Composite whose initial child isn't one of its sub-states is rejected when the definition is built.</summary>
+  [TestMethod]
+  public void Definition_OrphanSubState_ThrowsOnBuildTest()
+  {
+    // Assemble
+    var machine = new StateMachine<CompositeL1StateId>()
+      .RegisterComposite<CompositeL1_State2>(CompositeL1StateId.State2, CompositeL1StateId.State2_Sub1)
+      .RegisterState<CompositeL1_State2_Sub1>(CompositeL1StateId.State2_Sub1);
+
+    // Act/Assert
+    Assert.ThrowsExactly<OrphanSubStateException>(() => machine.BuildDefinition());
+  }
+
+  /// <summary>Composite without an initial child is rejected when the definition is built.</summary>
+  [TestMethod]
+  public void Definition_MissingInitialSubState_ThrowsOnBuildTest()
+  {
+    // Assemble
+    var machine = new StateMachine<CompositeL1StateId>()
+      .RegisterState<CompositeL1_State2>(CompositeL1StateId.State2, null, null, null, isCompositeParent: true, initialChildStateId: null);
+
+    // Act/Assert
+    Assert.ThrowsExactly<MissingInitialSubStateException>(() => machine.BuildDefinition());
+  }
+}
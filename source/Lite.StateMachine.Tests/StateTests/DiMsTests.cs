@@ -6,6 +6,7 @@ using System.Diagnostics;
 using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
+using Lite.StateMachine.Adapters;
 using Lite.StateMachine.Tests.TestData;
 using Lite.StateMachine.Tests.TestData.Services;
 using Lite.StateMachine.Tests.TestData.States;
@@ -58,6 +59,33 @@ public class DiMsTests : TestBase
     Assert.IsTrue(enums.SequenceEqual(machine.States), "States should be registered for execution in the same order as the defined enums, StateId 1 => 2 => 3.");
   }
 
+  /// <summary>States are created through factories the <see cref="MsDiResolver"/> compiles once per registration.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Basic_FlatStates_ServiceResolver_SuccessTestAsync()
+  {
+    // Assemble with Dependency Injection
+    var services = new ServiceCollection()
+      .AddLogging()
+      .AddSingleton<IMessageService, MessageService>()
+      .AddTransient<BasicDiState1>()
+      .AddTransient<BasicDiState2>()
+      .AddTransient<BasicDiState3>()
+      .BuildServiceProvider();
+
+    var machine = new StateMachine<BasicStateId>(new MsDiResolver(services))
+      .RegisterState<BasicDiState1>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicDiState2>(BasicStateId.State2, BasicStateId.State3)
+      .RegisterState<BasicDiState3>(BasicStateId.State3);
+
+    // Act
+    await machine.RunAsync(BasicStateId.State1, cancellationToken: TestContext.CancellationToken);
+
+    // Assert
+    var msgService = services.GetRequiredService<IMessageService>();
+    Assert.AreEqual(9, msgService.Counter1, "Message service should have 9 from the 3 states.");
+  }
+
   [TestMethod]
   public async Task Basic_GeneratesExportUml_SuccessTestAsync()
   {
@@ -0,0 +1,121 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Lite.StateMachine.Tests.TestData.Models;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class EventAggregatorTests : TestBase
+{
+  /// <summary>Generic, typed and wildcard subscribers all receive both publish paths.</summary>
+  [TestMethod]
+  public void Publish_GenericAndObject_ReachAllSubscribers_SuccessTest()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    var received = new List<string>();
+
+    using var generic = events.Subscribe<SensorReading>(msg => received.Add($"generic:{msg.Value}"));
+    using var typed = events.Subscribe(msg => received.Add($"typed:{((SensorReading)msg).Value}"), typeof(SensorReading));
+    using var wildcard = events.Subscribe(msg => received.Add($"wildcard:{msg.GetType().Name}"));
+
+    // Act
+    events.Publish(new SensorReading(1));
+    events.Publish((object)new SensorReading(2));
+    events.Publish(new UnlockCommand());
+
+    // Assert
+    string[] expected =
+    [
+      "generic:1", "typed:1", "wildcard:SensorReading",
+      "generic:2", "typed:2", "wildcard:SensorReading",
+      "wildcard:UnlockCommand",
+    ];
+
+    Assert.IsTrue(expected.SequenceEqual(received), string.Join(", ", received));
+  }
+
+  /// <summary>Value-type messages to generic subscribers neither lock nor box.</summary>
+  [TestMethod]
+  public void Publish_GenericValueType_DoesNotAllocate_SuccessTest()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    long total = 0;
+    using var sub = events.Subscribe<SensorReading>(msg => total += msg.Value);
+
+    // Warm-up (JIT, static caches)
+    events.Publish(new SensorReading(0));
+
+    // Act
+    var before = GC.GetAllocatedBytesForCurrentThread();
+    for (int i = 1; i <= 1_000; i++)
+      events.Publish(new SensorReading(i));
+
+    var allocated = GC.GetAllocatedBytesForCurrentThread() - before;
+
+    // Assert
+    Assert.AreEqual(500_500, total);
+    Assert.AreEqual(0, allocated);
+  }
+
+  /// <summary>Custom aggregators implementing <c>Publish&lt;T&gt;(T)</c> still get the generic calls made through the interface.</summary>
+  [TestMethod]
+  public void Publish_CustomAggregator_GenericOverloadImplementedTest()
+  {
+    // Assemble
+    var custom = new RecordingAggregator();
+    IEventAggregator events = custom;
+
+    // Act
+    events.Publish(new SensorReading(1));
+    events.Publish((object)new SensorReading(2));
+
+    // Assert
+    CollectionAssert.AreEqual(new[] { "generic:SensorReading", "object:SensorReading" }, custom.Calls);
+  }
+
+  /// <summary>Unsubscribing from inside a handler doesn't affect the publish in progress.</summary>
+  [TestMethod]
+  public void Unsubscribe_DuringPublish_SuccessTest()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    var count = 0;
+    IDisposable? first = null;
+    first = events.Subscribe<SensorReading>(_ =>
+    {
+      count++;
+      first!.Dispose();
+    });
+
+    using var second = events.Subscribe<SensorReading>(_ => count++);
+
+    // Act
+    events.Publish(new SensorReading(1));
+    events.Publish(new SensorReading(2));
+
+    // Assert - first handler only ran once
+    Assert.AreEqual(3, count);
+  }
+
+  private readonly record struct SensorReading(int Value);
+
+  /// <summary>Third-party aggregator overriding the generic publish.</summary>
+  private sealed class RecordingAggregator : IEventAggregator
+  {
+    public List<string> Calls { get; } = [];
+
+    public void Publish(object message) => Calls.Add($"object:{message.GetType().Name}");
+
+    public void Publish<T>(T message) => Calls.Add($"generic:{typeof(T).Name}");
+
+    public IDisposable Subscribe(Action<object> handler) => throw new NotSupportedException();
+
+    public IDisposable Subscribe(Action<object> handler, params Type[] messageTypes) => throw new NotSupportedException();
+  }
+}
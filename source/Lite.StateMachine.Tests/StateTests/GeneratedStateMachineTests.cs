@@ -0,0 +1,65 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData;
+using Lite.StateMachine.Tests.TestData.States;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+/// <summary>Machines emitted by the Lite.StateMachine.Generators source generator.</summary>
+[TestClass]
+public partial class GeneratedStateMachineTests : TestBase
+{
+  /// <summary>Same topology as <see cref="CompositeStateTest.Level1_Basic_RegisterHelpers_SuccessTestAsync"/>, minus the registration code.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Generated_Composite_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = CompositeL1Flow.CreateStateMachine();
+
+    // Act
+    await machine.RunAsync(CompositeL1StateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    AssertMachineNotNull(machine);
+    Assert.HasCount(5, machine.States);
+    Assert.AreEqual(CompositeL1StateId.State2, machine.Context.PreviousStateId);
+    Assert.AreEqual(CompositeStateTest.SUCCESS, machine.Context.Parameters[CompositeStateTest.ParameterSubStateEntered]);
+  }
+
+  /// <summary>The composite's sub-states run as concurrent regions, declared with <c>Regions</c>.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Generated_ParallelComposite_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = CompositeL1ParallelFlow.CreateStateMachine();
+
+    // Act
+    await machine.RunAsync(CompositeL1StateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    AssertMachineNotNull(machine);
+    Assert.HasCount(5, machine.States);
+    Assert.AreEqual(CompositeL1StateId.State2, machine.Context.PreviousStateId);
+    Assert.AreEqual(CompositeStateTest.SUCCESS, machine.Context.Parameters[CompositeStateTest.ParameterSubStateEntered]);
+  }
+
+  [GeneratedStateMachine(typeof(CompositeL1StateId))]
+  [GeneratedState(CompositeL1StateId.State1, typeof(CompositeL1_State1), OnSuccess = CompositeL1StateId.State2)]
+  [GeneratedState(CompositeL1StateId.State2, typeof(CompositeL1_State2), InitialSubState = CompositeL1StateId.State2_Sub1, OnSuccess = CompositeL1StateId.State3)]
+  [GeneratedState(CompositeL1StateId.State2_Sub1, typeof(CompositeL1_State2_Sub1), Parent = CompositeL1StateId.State2, OnSuccess = CompositeL1StateId.State2_Sub2)]
+  [GeneratedState(CompositeL1StateId.State2_Sub2, typeof(CompositeL1_State2_Sub2), Parent = CompositeL1StateId.State2)]
+  [GeneratedState(CompositeL1StateId.State3, typeof(CompositeL1_State3), Lifetime = StateLifetime.Transient)]
+  private static partial class CompositeL1Flow;
+
+  [GeneratedStateMachine(typeof(CompositeL1StateId))]
+  [GeneratedState(CompositeL1StateId.State1, typeof(CompositeL1_State1), OnSuccess = CompositeL1StateId.State2)]
+  [GeneratedState(CompositeL1StateId.State2, typeof(CompositeL1_State2), Regions = [CompositeL1StateId.State2_Sub1, CompositeL1StateId.State2_Sub2], OnSuccess = CompositeL1StateId.State3)]
+  [GeneratedState(CompositeL1StateId.State2_Sub1, typeof(CompositeL1_State2_Sub1), Parent = CompositeL1StateId.State2)]
+  [GeneratedState(CompositeL1StateId.State2_Sub2, typeof(CompositeL1_State2_Sub2), Parent = CompositeL1StateId.State2)]
+  [GeneratedState(CompositeL1StateId.State3, typeof(CompositeL1_State3))]
+  private static partial class CompositeL1ParallelFlow;
+}
@@ -0,0 +1,116 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Immutable;
+using System.IO;
+using System.Linq;
+using Lite.StateMachine.Generators;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+/// <summary>Compile-time topology errors reported by the Lite.StateMachine.Generators source generator.</summary>
+[TestClass]
+public class GeneratorDiagnosticTests : TestBase
+{
+  /// <summary>Declarations shared by every test source.</summary>
+  private const string Preamble = """
+    using System.Threading.Tasks;
+    using Lite.StateMachine;
+
+    public enum Id { A, B, C, D }
+
+    public enum Other { X }
+
+    public class S : IState<Id>
+    {
+      public Task OnEnter(Context<Id> context) => Task.CompletedTask;
+
+      public Task OnEntering(Context<Id> context) => Task.CompletedTask;
+
+      public Task OnExit(Context<Id> context) => Task.CompletedTask;
+    }
+
+    """;
+
+  /// <summary>Each topology mistake is reported as its own diagnostic, and nothing is emitted.</summary>
+  /// <param name="expectedId">Expected diagnostic id.</param>
+  /// <param name="declaration">Machine declaration.</param>
+  [TestMethod]
+  [DataRow("LSM001", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S))] public class Flow { }", DisplayName = "LSM001 Not partial")]
+  [DataRow("LSM001", "[GeneratedStateMachine(typeof(int))][GeneratedState(Id.A, typeof(S))] public partial class Flow { }", DisplayName = "LSM001 State Id not an enum")]
+  [DataRow("LSM001", "public partial class Outer<T> { [GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S))] public partial class Flow { } }", DisplayName = "LSM001 Generic container")]
+  [DataRow("LSM001", "public class Outer { [GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S))] public partial class Flow { } }", DisplayName = "LSM001 Container not partial")]
+  [DataRow("LSM002", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(string))] public partial class Flow { }", DisplayName = "LSM002 Not a state")]
+  [DataRow("LSM003", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Other.X, typeof(S))] public partial class Flow { }", DisplayName = "LSM003 Wrong State Id type")]
+  [DataRow("LSM004", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S))][GeneratedState(Id.A, typeof(S))] public partial class Flow { }", DisplayName = "LSM004 Duplicate")]
+  [DataRow("LSM005", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), OnSuccess = Id.B)] public partial class Flow { }", DisplayName = "LSM005 Unregistered")]
+  [DataRow("LSM006", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S))][GeneratedState(Id.B, typeof(S), Parent = Id.A)] public partial class Flow { }", DisplayName = "LSM006 Parent not composite")]
+  [DataRow("LSM007", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), InitialSubState = Id.B)][GeneratedState(Id.B, typeof(S))] public partial class Flow { }", DisplayName = "LSM007 Orphan")]
+  [DataRow("LSM008", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), InitialSubState = Id.B)][GeneratedState(Id.B, typeof(S), Parent = Id.A, OnSuccess = Id.C)][GeneratedState(Id.C, typeof(S))] public partial class Flow { }", DisplayName = "LSM008 Disjointed")]
+  [DataRow("LSM009", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), InitialSubState = null)] public partial class Flow { }", DisplayName = "LSM009 Null initial sub-state")]
+  [DataRow("LSM009", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), Regions = new object[0])] public partial class Flow { }", DisplayName = "LSM009 No regions")]
+  [DataRow("LSM010", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), InitialSubState = Id.B, Regions = new object[] { Id.B })][GeneratedState(Id.B, typeof(S), Parent = Id.A)] public partial class Flow { }", DisplayName = "LSM010 Both initial sub-state and regions")]
+  [DataRow("LSM010", "[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), Regions = new object[] { Id.B, Id.C })][GeneratedState(Id.B, typeof(S), Parent = Id.A, OnSuccess = Id.C)][GeneratedState(Id.C, typeof(S), Parent = Id.A)] public partial class Flow { }", DisplayName = "LSM010 Overlapping regions")]
+  public void Generator_InvalidTopology_ReportsDiagnosticTest(string expectedId, string declaration)
+  {
+    // Act
+    var diagnostics = RunGenerator(declaration, out var generatedCount, out _);
+
+    // Assert
+    var ids = string.Join(", ", diagnostics.Select(d => d.Id).Distinct());
+    Assert.AreEqual(expectedId, ids);
+    Assert.IsTrue(diagnostics.All(d => d.Severity == DiagnosticSeverity.Error));
+    Assert.AreEqual(0, generatedCount);
+  }
+
+  /// <summary>Valid composite and parallel composite topologies emit code that compiles.</summary>
+  /// <param name="declaration">Machine declaration.</param>
+  [TestMethod]
+  [DataRow("[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), InitialSubState = Id.B, OnSuccess = Id.D)][GeneratedState(Id.B, typeof(S), Parent = Id.A, OnSuccess = Id.C)][GeneratedState(Id.C, typeof(S), Parent = Id.A)][GeneratedState(Id.D, typeof(S))] public static partial class Flow;", DisplayName = "Composite")]
+  [DataRow("[GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S), Regions = new object[] { Id.B, Id.C }, JoinPolicy = JoinPolicy.FailFast, OnSuccess = Id.D)][GeneratedState(Id.B, typeof(S), Parent = Id.A)][GeneratedState(Id.C, typeof(S), Parent = Id.A)][GeneratedState(Id.D, typeof(S))] public static partial class Flow;", DisplayName = "Parallel composite")]
+  [DataRow("[GeneratedStateMachine(typeof(Id))][GeneratedState((Id)(-1), typeof(S), OnSuccess = (Id)7)][GeneratedState((Id)7, typeof(S))] public static partial class Flow;", DisplayName = "Cast values")]
+  [DataRow("public partial struct Outer { [GeneratedStateMachine(typeof(Id))][GeneratedState(Id.A, typeof(S))] internal static partial class Flow; }", DisplayName = "Nested")]
+  public void Generator_ValidTopology_CompilesTest(string declaration)
+  {
+    // Act
+    var diagnostics = RunGenerator(declaration, out var generatedCount, out var output);
+
+    // Assert
+    Assert.IsEmpty(diagnostics);
+    Assert.AreEqual(1, generatedCount);
+
+    var errors = output.GetDiagnostics(TestContext.CancellationToken).Where(d => d.Severity == DiagnosticSeverity.Error).ToList();
+    Assert.IsEmpty(errors, string.Join(Environment.NewLine, errors));
+  }
+
+  /// <summary>Run the generator over <see cref="Preamble"/> and a declaration.</summary>
+  /// <param name="declaration">Machine declaration.</param>
+  /// <param name="generatedCount">Number of generated sources.</param>
+  /// <param name="output">Compilation including the generated sources.</param>
+  /// <returns>Generator diagnostics.</returns>
+  private ImmutableArray<Diagnostic> RunGenerator(string declaration, out int generatedCount, out Compilation output)
+  {
+    // Everything the test itself runs on, which includes Lite.StateMachine
+    var references = ((string)AppContext.GetData("TRUSTED_PLATFORM_ASSEMBLIES")!)
+      .Split(Path.PathSeparator)
+      .Append(typeof(StateMachine<>).Assembly.Location)
+      .Distinct()
+      .Select(path => MetadataReference.CreateFromFile(path));
+
+    var compilation = CSharpCompilation.Create(
+      "GeneratorTest",
+      [CSharpSyntaxTree.ParseText(Preamble + declaration, cancellationToken: TestContext.CancellationToken)],
+      references,
+      new CSharpCompilationOptions(OutputKind.DynamicallyLinkedLibrary, nullableContextOptions: NullableContextOptions.Enable));
+
+    var driver = CSharpGeneratorDriver.Create(new StateMachineGenerator())
+      .RunGeneratorsAndUpdateCompilation(compilation, out output, out _, TestContext.CancellationToken);
+
+    var result = driver.GetRunResult();
+    generatedCount = result.GeneratedTrees.Length;
+    return result.Diagnostics;
+  }
+}
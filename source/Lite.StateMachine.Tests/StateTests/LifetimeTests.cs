@@ -0,0 +1,214 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData;
+using Lite.StateMachine.Tests.TestData.Models;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class LifetimeTests : TestBase
+{
+  private enum LifeStateId
+  {
+    State1,
+    State2,
+    State3,
+  }
+
+  [TestMethod]
+  public async Task Lifetime_Singleton_ReusedAcrossRuns_SuccessTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var machine = CreateMachine(tracker, StateLifetime.Singleton);
+
+    // Act
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(3, tracker.Created);
+    Assert.AreEqual(0, tracker.Disposed);
+    Assert.AreEqual(6, machine.Context.ParameterAsInt(ParameterType.Counter));
+  }
+
+  [TestMethod]
+  public async Task Lifetime_Transient_DisposedOnExit_SuccessTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var machine = CreateMachine(tracker, StateLifetime.Transient);
+
+    // Act
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(6, tracker.Created);
+    Assert.AreEqual(6, tracker.Disposed);
+  }
+
+  [TestMethod]
+  public async Task Lifetime_Pooled_ResetAndReused_SuccessTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var definition = CreateMachine(tracker, StateLifetime.Pooled).BuildDefinition();
+
+    // Act - Separate runs share the registration's pool
+    await definition.CreateRun().RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+    await definition.CreateRun().RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(3, tracker.Created);
+    Assert.AreEqual(6, tracker.Reset);
+    Assert.AreEqual(0, tracker.Disposed);
+  }
+
+  [TestMethod]
+  public async Task Lifetime_Pooled_FailedResetIsDisposed_SuccessTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker { CanReset = false };
+    var machine = CreateMachine(tracker, StateLifetime.Pooled);
+
+    // Act
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(6, tracker.Created);
+    Assert.AreEqual(6, tracker.Disposed);
+  }
+
+  /// <summary>A transient command state isn't disposed while an OnMessage running on the publisher's thread is still in it.</summary>
+  /// <param name="isRouted">Route messages through the run's single subscription.</param>
+  [TestMethod]
+  [DataRow(false, DisplayName = "Subscription")]
+  [DataRow(true, DisplayName = "Message routing")]
+  public async Task Lifetime_Transient_DisposedAfterInFlightMessage_SuccessTestAsync(bool isRouted)
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var machine = new StateMachine<LifeStateId>(_ => new SlowMessageState(tracker), new EventAggregator())
+    {
+      IsMessageRoutingEnabled = isRouted,
+    };
+
+    machine.RegisterState<SlowMessageState>(LifeStateId.State1, lifetime: StateLifetime.Transient);
+
+    // Act
+    await machine.RunAsync(LifeStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(1, machine.Context.ParameterAsInt(ParameterType.Counter), "OnMessage ran on a disposed instance");
+    Assert.AreEqual(1, tracker.Disposed);
+  }
+
+  private static StateMachine<LifeStateId> CreateMachine(Tracker tracker, StateLifetime lifetime) =>
+    new StateMachine<LifeStateId>(containerFactory: _ => new TrackedState(tracker))
+      .RegisterState<TrackedState>(LifeStateId.State1, LifeStateId.State2, lifetime: lifetime)
+      .RegisterState<TrackedState>(LifeStateId.State2, LifeStateId.State3, lifetime: lifetime)
+      .RegisterState<TrackedState>(LifeStateId.State3, lifetime: lifetime);
+
+  /// <summary>Per-test counters; tests run in parallel so nothing static.</summary>
+  private sealed class Tracker
+  {
+    private int _created;
+    private int _disposed;
+    private int _reset;
+
+    public bool CanReset { get; init; } = true;
+
+    public int Created => _created;
+
+    public int Disposed => _disposed;
+
+    public int Reset => _reset;
+
+    public void OnCreated() => Interlocked.Increment(ref _created);
+
+    public void OnDisposed() => Interlocked.Increment(ref _disposed);
+
+    public void OnReset() => Interlocked.Increment(ref _reset);
+  }
+
+  private sealed class TrackedState : IState<LifeStateId>, IResettableState, IAsyncDisposable
+  {
+    private readonly Tracker _tracker;
+
+    public TrackedState(Tracker tracker)
+    {
+      _tracker = tracker;
+      _tracker.OnCreated();
+    }
+
+    public ValueTask DisposeAsync()
+    {
+      _tracker.OnDisposed();
+      return ValueTask.CompletedTask;
+    }
+
+    public Task OnEnter(Context<LifeStateId> context)
+    {
+      context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<LifeStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<LifeStateId> context) => Task.CompletedTask;
+
+    public bool TryReset()
+    {
+      _tracker.OnReset();
+      return _tracker.CanReset;
+    }
+  }
+
+  /// <summary>Decides from OnMessage, then keeps working after the decision.</summary>
+  private sealed class SlowMessageState : ICommandState<LifeStateId>, IAsyncDisposable
+  {
+    private readonly Tracker _tracker;
+    private bool _isDisposed;
+
+    public SlowMessageState(Tracker tracker)
+    {
+      _tracker = tracker;
+      _tracker.OnCreated();
+    }
+
+    public ValueTask DisposeAsync()
+    {
+      _isDisposed = true;
+      _tracker.OnDisposed();
+      return ValueTask.CompletedTask;
+    }
+
+    public Task OnEnter(Context<LifeStateId> context)
+    {
+      context.EventAggregator?.Publish(new UnlockCommand());
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<LifeStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<LifeStateId> context) => Task.CompletedTask;
+
+    public async Task OnMessage(Context<LifeStateId> context, object message)
+    {
+      context.NextState(Result.Success);
+      await Task.Delay(50);
+
+      if (!_isDisposed)
+        context.Parameters[ParameterType.Counter] = 1;
+    }
+
+    public Task OnTimeout(Context<LifeStateId> context) => Task.CompletedTask;
+  }
+}
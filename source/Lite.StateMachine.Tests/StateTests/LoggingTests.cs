@@ -0,0 +1,248 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData.States;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class LoggingTests : TestBase
+{
+  private enum LogStateId
+  {
+    State1,
+    State2,
+    State2_Sub1,
+    State3,
+  }
+
+  /// <summary>Command state timeouts and exceptions swallowed from <c>OnMessage</c> are logged, with the exception.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Logging_CommandTimeoutAndMessageFault_LoggedTestAsync()
+  {
+    // Assemble
+    var logger = new CaptureLogger<StateMachine<LogStateId>>(LogLevel.Information);
+    var machine = new StateMachine<LogStateId>(eventAggregator: new EventAggregator(), logger: logger)
+      .RegisterState<ThrowingCommandState>(LogStateId.State1);
+
+    // Act
+    await machine.RunAsync(LogStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    var fault = logger.Entries.Single(e => e.EventId == 5);
+    Assert.AreEqual(LogLevel.Error, fault.Level);
+    Assert.IsInstanceOfType<InvalidOperationException>(fault.Exception);
+    Assert.AreEqual("Command state 'State1' threw handling PingMessage; the message was dropped", fault.Message);
+
+    var timeout = logger.Entries.Single(e => e.EventId == 2);
+    Assert.AreEqual("Command state 'State1' timed out", timeout.Message);
+  }
+
+  /// <summary>An exception from a timer-fired <c>OnTimeout</c> has no caller to rethrow to, so it's logged.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Logging_OnTimeoutFault_LoggedTestAsync()
+  {
+    // Assemble
+    var logger = new CaptureLogger<StateMachine<LogStateId>>(LogLevel.Error);
+    var machine = new StateMachine<LogStateId>(eventAggregator: new EventAggregator(), logger: logger)
+    {
+      DefaultStateTimeoutMs = 500,
+    }
+      .RegisterState<TimeoutThrowingCommandState>(LogStateId.State1);
+
+    // Act
+    await machine.RunAsync(LogStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    var entry = logger.Entries.Single();
+    Assert.AreEqual(7, entry.EventId);
+    Assert.AreEqual("Command state 'State1' threw from OnTimeout; the state keeps waiting for a decision", entry.Message);
+    Assert.IsInstanceOfType<InvalidOperationException>(entry.Exception);
+  }
+
+  /// <summary>A state deciding nothing within <see cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/> is a warning.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Logging_StateTimeout_LoggedAsWarningTestAsync()
+  {
+    // Assemble
+    var clock = new VirtualTimeProvider();
+    var logger = new CaptureLogger<StateMachine<LogStateId>>(LogLevel.Warning);
+    var machine = new StateMachine<LogStateId>(logger: logger)
+    {
+      DefaultStateTimeoutMs = 1_000,
+      TimeProvider = clock,
+    }
+      .RegisterState<HungState<LogStateId>>(LogStateId.State1, LogStateId.State3)
+      .RegisterState<SuccessState<LogStateId>>(LogStateId.State3);
+
+    // Act
+    var run = machine.RunAsync(LogStateId.State1, TestContext.CancellationToken);
+    clock.Advance(TimeSpan.FromSeconds(2));
+    await run.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken);
+
+    // Assert
+    var entry = logger.Entries.Single();
+    Assert.AreEqual(LogLevel.Warning, entry.Level);
+    Assert.AreEqual("State 'State1' made no decision within 1000 ms; ending the run", entry.Message);
+  }
+
+  /// <summary>Each hop logs its state, result and next state by name; the last child's next is its parent.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Logging_Transitions_LoggedByNameTestAsync()
+  {
+    // Assemble
+    var logger = new CaptureLogger<StateMachine<LogStateId>>(LogLevel.Debug);
+    var machine = new StateMachine<LogStateId>(logger: logger)
+      .RegisterState<SuccessState<LogStateId>>(LogStateId.State1, LogStateId.State2)
+      .RegisterComposite<ParentState<LogStateId>>(LogStateId.State2, LogStateId.State2_Sub1, onSuccess: LogStateId.State3)
+      .RegisterSubState<SuccessState<LogStateId>>(LogStateId.State2_Sub1, LogStateId.State2)
+      .RegisterState<SuccessState<LogStateId>>(LogStateId.State3);
+
+    // Act
+    await machine.RunAsync(LogStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    string[] expected =
+    [
+      "State 'State1' completed with Success; next 'State2'",
+      "State 'State2_Sub1' completed with Success; next 'State2'",
+      "State 'State2' completed with Success; next 'State3'",
+      "State 'State3' completed with Success; next '(end)'",
+    ];
+
+    CollectionAssert.AreEqual(expected, logger.Entries.Select(e => e.Message).ToArray());
+    Assert.IsTrue(logger.Entries.All(e => e.Level == LogLevel.Debug && e.EventId == 1));
+  }
+
+  /// <summary>Below the configured level nothing is formatted or written; only the level is checked.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Logging_WarningLevel_NothingWrittenTestAsync()
+  {
+    // Assemble
+    var logger = new CaptureLogger<StateMachine<LogStateId>>(LogLevel.Warning);
+    var machine = new StateMachine<LogStateId>(logger: logger)
+      .RegisterState<SuccessState<LogStateId>>(LogStateId.State1, LogStateId.State2)
+      .RegisterState<SuccessState<LogStateId>>(LogStateId.State2, LogStateId.State3)
+      .RegisterState<SuccessState<LogStateId>>(LogStateId.State3);
+
+    // Act
+    await machine.RunAsync(LogStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(0, logger.LogCalls);
+    Assert.HasCount(3, logger.IsEnabledCalls.Where(l => l == LogLevel.Debug).ToList());
+  }
+
+  /// <summary>Exceptions thrown by event aggregator subscribers are logged and the rest still receive the message.</summary>
+  [TestMethod]
+  public void Logging_SubscriberFault_LoggedTest()
+  {
+    // Assemble
+    var logger = new CaptureLogger<EventAggregator>(LogLevel.Error);
+    var events = new EventAggregator(logger);
+    var received = 0;
+    using var throwing = events.Subscribe<PingMessage>(_ => throw new InvalidOperationException("Boom"));
+    using var wildcard = events.Subscribe(_ => received++);
+
+    // Act
+    events.Publish(new PingMessage());
+
+    // Assert
+    Assert.AreEqual(1, received);
+    var entry = logger.Entries.Single();
+    Assert.AreEqual(6, entry.EventId);
+    Assert.AreEqual("Subscriber threw handling PingMessage; publishing continues", entry.Message);
+    Assert.IsInstanceOfType<InvalidOperationException>(entry.Exception);
+  }
+
+  /// <summary>Records written entries and level checks.</summary>
+  /// <typeparam name="T">Category type.</typeparam>
+  /// <param name="minLevel">Lowest enabled level.</param>
+  private sealed class CaptureLogger<T>(LogLevel minLevel) : ILogger<T>
+  {
+    private readonly object _lockGate = new();
+
+    public List<(LogLevel Level, int EventId, string Message, Exception? Exception)> Entries { get; } = [];
+
+    public List<LogLevel> IsEnabledCalls { get; } = [];
+
+    public int LogCalls { get; private set; }
+
+    public IDisposable? BeginScope<TState>(TState state)
+      where TState : notnull => null;
+
+    public bool IsEnabled(LogLevel logLevel)
+    {
+      lock (_lockGate)
+        IsEnabledCalls.Add(logLevel);
+
+      return logLevel >= minLevel;
+    }
+
+    public void Log<TState>(LogLevel logLevel, EventId eventId, TState state, Exception? exception, Func<TState, Exception?, string> formatter)
+    {
+      lock (_lockGate)
+      {
+        LogCalls++;
+        if (logLevel >= minLevel)
+          Entries.Add((logLevel, eventId.Id, formatter(state, exception), exception));
+      }
+    }
+  }
+
+  private class PingMessage;
+
+  /// <summary>Throws on its own message, then times out.</summary>
+  private class ThrowingCommandState : ICommandState<LogStateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(PingMessage)];
+
+    public int? TimeoutMs => 50;
+
+    public Task OnEnter(Context<LogStateId> context)
+    {
+      context.EventAggregator?.Publish(new PingMessage());
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<LogStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<LogStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<LogStateId> context, object message) => throw new InvalidOperationException("Boom");
+
+    public Task OnTimeout(Context<LogStateId> context)
+    {
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Throws from OnTimeout; left by <see cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/>.</summary>
+  private class TimeoutThrowingCommandState : ICommandState<LogStateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(PingMessage)];
+
+    public int? TimeoutMs => 20;
+
+    public Task OnEnter(Context<LogStateId> context) => Task.CompletedTask;
+
+    public Task OnEntering(Context<LogStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<LogStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<LogStateId> context, object message) => Task.CompletedTask;
+
+    public Task OnTimeout(Context<LogStateId> context) => throw new InvalidOperationException("Boom");
+  }
+}
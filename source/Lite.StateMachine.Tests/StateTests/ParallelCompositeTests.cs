@@ -0,0 +1,239 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class ParallelCompositeTests : TestBase
+{
+  private enum ParallelKey
+  {
+    Barrier,
+    Claimed,
+    LastChildResult,
+    RegionResults,
+    Token,
+  }
+
+  private enum ParallelStateId
+  {
+    Cell,
+    Conveyor,
+    ConveyorDone,
+    Gripper,
+    Vision,
+    Done,
+  }
+
+  /// <summary>Regions run concurrently; the parent's OnExit sees each region's outcome and their merged context.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Parallel_JoinAll_RunsRegionsConcurrently_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<ParallelStateId>()
+      .RegisterParallelComposite<ParentState>(
+        ParallelStateId.Cell,
+        [ParallelStateId.Conveyor, ParallelStateId.Gripper, ParallelStateId.Vision],
+        onSuccess: ParallelStateId.Done)
+      .RegisterSubState<BarrierState>(ParallelStateId.Conveyor, ParallelStateId.Cell, onSuccess: ParallelStateId.ConveyorDone)
+      .RegisterSubState<MarkState>(ParallelStateId.ConveyorDone, ParallelStateId.Cell)
+      .RegisterSubState<BarrierState>(ParallelStateId.Gripper, ParallelStateId.Cell)
+      .RegisterSubState<BarrierState>(ParallelStateId.Vision, ParallelStateId.Cell)
+      .RegisterState<MarkState>(ParallelStateId.Done)
+      .AddContext(new() { { ParallelKey.Barrier, new Barrier(3) } });
+
+    // Act
+    await machine.RunAsync(ParallelStateId.Cell, TestContext.CancellationToken);
+
+    // Assert
+    var parameters = machine.Context.Parameters;
+    Assert.AreEqual(Result.Success, parameters[ParallelKey.LastChildResult]);
+
+    // Each region's own keys were merged back
+    foreach (var stateId in new[] { ParallelStateId.Conveyor, ParallelStateId.ConveyorDone, ParallelStateId.Gripper, ParallelStateId.Vision, ParallelStateId.Done })
+      Assert.IsTrue(parameters.ContainsKey(stateId), $"Missing context from {stateId}");
+
+    var regions = (IReadOnlyList<RegionResult<ParallelStateId>>)parameters[ParallelKey.RegionResults]!;
+    Assert.HasCount(3, regions);
+    Assert.AreEqual(new RegionResult<ParallelStateId>(ParallelStateId.Conveyor, ParallelStateId.ConveyorDone, Result.Success), regions[0]);
+    Assert.AreEqual(ParallelStateId.Gripper, regions[1].RegionStateId);
+    Assert.AreEqual(Result.Success, regions[1].LastChildResult);
+    Assert.AreEqual(ParallelStateId.Vision, regions[2].RegionStateId);
+    Assert.AreEqual(Result.Success, regions[2].LastChildResult);
+  }
+
+  /// <summary>A failing region cancels the others, and its result is the parent's LastChildResult.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Parallel_FailFast_CancelsOtherRegionsTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<ParallelStateId>()
+      .RegisterParallelComposite<ParentState>(ParallelStateId.Cell, [ParallelStateId.Conveyor, ParallelStateId.Gripper], JoinPolicy.FailFast)
+      .RegisterSubState<HangingState>(ParallelStateId.Conveyor, ParallelStateId.Cell)
+      .RegisterSubState<FailingState>(ParallelStateId.Gripper, ParallelStateId.Cell);
+
+    // Act
+    await machine.RunAsync(ParallelStateId.Cell, TestContext.CancellationToken);
+
+    // Assert
+    var parameters = machine.Context.Parameters;
+    Assert.AreEqual(Result.Failure, parameters[ParallelKey.LastChildResult]);
+
+    var regions = (IReadOnlyList<RegionResult<ParallelStateId>>)parameters[ParallelKey.RegionResults]!;
+    Assert.IsNull(regions[0].LastChildResult, "Hanging region should have been cancelled");
+    Assert.AreEqual(Result.Failure, regions[1].LastChildResult);
+  }
+
+  /// <summary>The first region to finish wins; the rest are cancelled.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Parallel_Any_FirstRegionWinsTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<ParallelStateId>()
+      .RegisterParallelComposite<ParentState>(ParallelStateId.Cell, [ParallelStateId.Conveyor, ParallelStateId.Vision], JoinPolicy.Any)
+      .RegisterSubState<HangingState>(ParallelStateId.Conveyor, ParallelStateId.Cell)
+      .RegisterSubState<MarkState>(ParallelStateId.Vision, ParallelStateId.Cell);
+
+    // Act
+    await machine.RunAsync(ParallelStateId.Cell, TestContext.CancellationToken);
+
+    // Assert
+    var parameters = machine.Context.Parameters;
+    Assert.AreEqual(Result.Success, parameters[ParallelKey.LastChildResult]);
+    Assert.IsTrue(parameters.ContainsKey(ParallelStateId.Vision));
+
+    var regions = (IReadOnlyList<RegionResult<ParallelStateId>>)parameters[ParallelKey.RegionResults]!;
+    Assert.IsNull(regions[0].LastChildResult);
+    Assert.AreEqual(Result.Success, regions[1].LastChildResult);
+  }
+
+  /// <summary>A key a region removed is removed from the parent, unless a later region changed it.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Parallel_RegionRemovesKey_MergedIntoParentTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<ParallelStateId>()
+      .RegisterParallelComposite<ParentState>(ParallelStateId.Cell, [ParallelStateId.Conveyor, ParallelStateId.Gripper])
+      .RegisterSubState<RemovingState>(ParallelStateId.Conveyor, ParallelStateId.Cell)
+      .RegisterSubState<TokenState>(ParallelStateId.Gripper, ParallelStateId.Cell)
+      .AddContext(new() { { ParallelKey.Claimed, true }, { ParallelKey.Token, "parent" } });
+
+    // Act
+    await machine.RunAsync(ParallelStateId.Cell, TestContext.CancellationToken);
+
+    // Assert
+    var parameters = machine.Context.Parameters;
+    Assert.IsFalse(parameters.ContainsKey(ParallelKey.Claimed), "Removed by the Conveyor region");
+    Assert.AreEqual("gripper", parameters[ParallelKey.Token], "Removed by Conveyor, then changed by the later Gripper region");
+    Assert.IsTrue(parameters.ContainsKey(ParallelStateId.Gripper));
+  }
+
+  /// <summary>Regions share one node table, so a sub-state reachable from two regions is rejected when built.</summary>
+  [TestMethod]
+  public void Parallel_SharedSubState_ThrowsOnBuildTest()
+  {
+    // Assemble
+    var machine = new StateMachine<ParallelStateId>()
+      .RegisterParallelComposite<ParentState>(ParallelStateId.Cell, [ParallelStateId.Conveyor, ParallelStateId.Gripper])
+      .RegisterSubState<MarkState>(ParallelStateId.Conveyor, ParallelStateId.Cell, onSuccess: ParallelStateId.ConveyorDone)
+      .RegisterSubState<MarkState>(ParallelStateId.Gripper, ParallelStateId.Cell, onSuccess: ParallelStateId.ConveyorDone)
+      .RegisterSubState<MarkState>(ParallelStateId.ConveyorDone, ParallelStateId.Cell);
+
+    // Act/Assert
+    Assert.ThrowsExactly<DisjointedNextSubStateException>(() => machine.BuildDefinition());
+  }
+
+  /// <summary>Completes once every region has arrived; never completes if regions run one at a time.</summary>
+  private sealed class Barrier(int count)
+  {
+    private readonly TaskCompletionSource _allArrived = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    private int _remaining = count;
+
+    public Task ArriveAsync()
+    {
+      if (Interlocked.Decrement(ref _remaining) == 0)
+        _allArrived.TrySetResult();
+
+      return _allArrived.Task.WaitAsync(TimeSpan.FromSeconds(5));
+    }
+  }
+
+  private class MarkState : IState<ParallelStateId>
+  {
+    public virtual Task OnEnter(Context<ParallelStateId> context)
+    {
+      context.Parameters[context.CurrentStateId] = true;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<ParallelStateId> context) => Task.CompletedTask;
+
+    public virtual Task OnExit(Context<ParallelStateId> context) => Task.CompletedTask;
+  }
+
+  private class BarrierState : MarkState
+  {
+    public override async Task OnEnter(Context<ParallelStateId> context)
+    {
+      await ((Barrier)context.Parameters[ParallelKey.Barrier]!).ArriveAsync();
+      await base.OnEnter(context);
+    }
+  }
+
+  private class FailingState : MarkState
+  {
+    public override Task OnEnter(Context<ParallelStateId> context)
+    {
+      context.NextState(Result.Failure);
+      return Task.CompletedTask;
+    }
+  }
+
+  /// <summary>Never completes; left to the join policy to cancel.</summary>
+  private class HangingState : MarkState
+  {
+    public override Task OnEnter(Context<ParallelStateId> context) => Task.CompletedTask;
+  }
+
+  private class RemovingState : MarkState
+  {
+    public override Task OnEnter(Context<ParallelStateId> context)
+    {
+      context.Parameters.Remove(ParallelKey.Claimed);
+      context.Parameters.Remove(ParallelKey.Token);
+      return base.OnEnter(context);
+    }
+  }
+
+  private class TokenState : MarkState
+  {
+    public override Task OnEnter(Context<ParallelStateId> context)
+    {
+      context.Parameters[ParallelKey.Token] = "gripper";
+      return base.OnEnter(context);
+    }
+  }
+
+  private class ParentState : MarkState
+  {
+    public override Task OnEnter(Context<ParallelStateId> context) => Task.CompletedTask;
+
+    public override Task OnExit(Context<ParallelStateId> context)
+    {
+      context.Parameters[ParallelKey.LastChildResult] = context.LastChildResult;
+      context.Parameters[ParallelKey.RegionResults] = context.RegionResults;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+  }
+}
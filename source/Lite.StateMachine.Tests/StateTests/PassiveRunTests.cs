@@ -0,0 +1,231 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class PassiveRunTests : TestBase
+{
+  private enum OrderKey
+  {
+    Counter,
+    Visited,
+  }
+
+  private enum OrderStateId
+  {
+    Created,
+    Paid,
+    Fulfillment,
+    Pick,
+    Pack,
+    Done,
+  }
+
+  /// <summary>States only advance as triggers and messages are posted; messages reach the waiting command state by type.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Passive_TransitionsOnPostedInput_SuccessTestAsync()
+  {
+    // Assemble
+    var visited = new List<OrderStateId>();
+    var runtime = new StateMachineRuntime<OrderStateId>(new StateMachine<OrderStateId>()
+      .RegisterState<WaitingState>(OrderStateId.Created, OrderStateId.Paid)
+      .RegisterState<PaymentState>(OrderStateId.Paid, OrderStateId.Fulfillment)
+      .RegisterComposite<CompositeState>(OrderStateId.Fulfillment, OrderStateId.Pick, onSuccess: OrderStateId.Done)
+      .RegisterSubState<WaitingState>(OrderStateId.Pick, OrderStateId.Fulfillment, onSuccess: OrderStateId.Pack)
+      .RegisterSubState<AutoState>(OrderStateId.Pack, OrderStateId.Fulfillment)
+      .RegisterState<AutoState>(OrderStateId.Done));
+
+    // Act
+    var run = runtime.Start(OrderStateId.Created, new() { { OrderKey.Visited, visited } });
+    Assert.IsTrue(run.Post(Result.Success));
+    Assert.IsTrue(run.Post("not a payment"));
+    Assert.IsTrue(run.Post(new PaymentMessage()));
+    Assert.IsTrue(run.Post(Result.Success));
+
+    await run.Completion.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken);
+
+    // Assert
+    CollectionAssert.AreEqual(
+      new[] { OrderStateId.Created, OrderStateId.Paid, OrderStateId.Fulfillment, OrderStateId.Pick, OrderStateId.Pack, OrderStateId.Done },
+      visited);
+
+    Assert.AreEqual(1, run.Context.ParameterAsInt(OrderKey.Counter), "Only the payment should have been delivered.");
+    Assert.AreEqual(OrderStateId.Fulfillment, run.Context.PreviousStateId);
+    Assert.IsFalse(run.Post(Result.Success), "Completed runs don't accept input.");
+  }
+
+  /// <summary>Parked machines cost no running instance; each completes once its trigger is posted.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Passive_ManyIdleMachines_SuccessTestAsync()
+  {
+    // Assemble
+    const int InstanceCount = 10_000;
+    var runtime = new StateMachineRuntime<OrderStateId>(new StateMachine<OrderStateId>()
+      .RegisterState<WaitingState>(OrderStateId.Created, OrderStateId.Done)
+      .RegisterState<AutoState>(OrderStateId.Done));
+
+    var runs = new StateMachineRun<OrderStateId>[InstanceCount];
+    for (int i = 0; i < InstanceCount; i++)
+      runs[i] = runtime.Start(OrderStateId.Created, new() { { OrderKey.Visited, new List<OrderStateId>() } });
+
+    Assert.AreEqual(0, runtime.ActiveCount);
+
+    // Act
+    foreach (var run in runs)
+      run.Post(Result.Success);
+
+    await Task.WhenAll(runs.Select(r => r.Completion)).WaitAsync(TimeSpan.FromSeconds(30), TestContext.CancellationToken);
+
+    // Assert
+    foreach (var run in runs)
+      Assert.AreEqual(OrderStateId.Done, run.Context.CurrentStateId);
+  }
+
+  /// <summary>An exception thrown by a state faults the run's completion.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Passive_StateThrows_FaultsCompletionTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<OrderStateId>()
+      .RegisterState<WaitingState>(OrderStateId.Created, OrderStateId.Done)
+      .RegisterState<ThrowingState>(OrderStateId.Done)
+      .AddContext(new() { { OrderKey.Visited, new List<OrderStateId>() } });
+
+    // Act
+    var run = machine.Start(OrderStateId.Created);
+    run.Post(Result.Success);
+
+    // Assert
+    await Assert.ThrowsExactlyAsync<InvalidOperationException>(() => run.Completion.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken));
+    Assert.ThrowsExactly<InvalidOperationException>(() => machine.Start(OrderStateId.Created));
+  }
+
+  /// <summary>A faulted run releases the transient instances its entered states held, as a sequential run does.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Passive_StateThrows_ReleasesInstancesTestAsync()
+  {
+    // Assemble
+    var disposed = new List<Type>();
+    var machine = new StateMachine<OrderStateId>(type => type == typeof(DisposableCompositeState)
+      ? new DisposableCompositeState(disposed)
+      : new DisposableThrowingState(disposed))
+      .RegisterState<DisposableCompositeState>(OrderStateId.Fulfillment, null, null, null, isCompositeParent: true, initialChildStateId: OrderStateId.Pick, lifetime: StateLifetime.Transient)
+      .RegisterSubState<DisposableThrowingState>(OrderStateId.Pick, OrderStateId.Fulfillment, lifetime: StateLifetime.Transient)
+      .AddContext(new() { { OrderKey.Visited, new List<OrderStateId>() } });
+
+    // Act
+    var run = machine.Start(OrderStateId.Fulfillment);
+
+    // Assert
+    await Assert.ThrowsExactlyAsync<InvalidOperationException>(() => run.Completion.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken));
+    CollectionAssert.AreEqual(new[] { typeof(DisposableThrowingState), typeof(DisposableCompositeState) }, disposed, "Innermost first");
+  }
+
+  private static void Visit(Context<OrderStateId> context) =>
+    ((List<OrderStateId>)context.Parameters[OrderKey.Visited]!).Add(context.CurrentStateId);
+
+  /// <summary>Completes on entry.</summary>
+  private class AutoState : IState<OrderStateId>
+  {
+    public Task OnEnter(Context<OrderStateId> context)
+    {
+      Visit(context);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<OrderStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<OrderStateId> context) => Task.CompletedTask;
+  }
+
+  private class CompositeState : IState<OrderStateId>
+  {
+    public Task OnEnter(Context<OrderStateId> context)
+    {
+      Visit(context);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<OrderStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<OrderStateId> context)
+    {
+      context.NextState(context.LastChildResult ?? Result.Failure);
+      return Task.CompletedTask;
+    }
+  }
+
+  private class DisposableCompositeState(List<Type> disposed) : CompositeState, IDisposable
+  {
+    public void Dispose() => disposed.Add(GetType());
+  }
+
+  private class DisposableThrowingState(List<Type> disposed) : ThrowingState, IDisposable
+  {
+    public void Dispose() => disposed.Add(GetType());
+  }
+
+  private class PaymentMessage;
+
+  private class PaymentState : ICommandState<OrderStateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(PaymentMessage)];
+
+    public Task OnEnter(Context<OrderStateId> context)
+    {
+      Visit(context);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<OrderStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<OrderStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<OrderStateId> context, object message)
+    {
+      context.Parameters.Set(OrderKey.Counter, context.ParameterAsInt(OrderKey.Counter) + 1);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnTimeout(Context<OrderStateId> context)
+    {
+      context.NextState(Result.Failure);
+      return Task.CompletedTask;
+    }
+  }
+
+  private class ThrowingState : IState<OrderStateId>
+  {
+    public Task OnEnter(Context<OrderStateId> context) => throw new InvalidOperationException("Boom");
+
+    public Task OnEntering(Context<OrderStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<OrderStateId> context) => Task.CompletedTask;
+  }
+
+  /// <summary>Waits for a posted trigger.</summary>
+  private class WaitingState : IState<OrderStateId>
+  {
+    public Task OnEnter(Context<OrderStateId> context)
+    {
+      Visit(context);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<OrderStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<OrderStateId> context) => Task.CompletedTask;
+  }
+}
@@ -0,0 +1,131 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Linq;
+using Lite.StateMachine.Tests.TestData;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class PropertyBagTests : TestBase
+{
+  private enum SignedKey : short
+  {
+    Negative = -2,
+    Positive = 2,
+  }
+
+  /// <summary>Typed and object members read and write the same entries.</summary>
+  [TestMethod]
+  public void TypedAndObjectAccess_AreInterchangeable_SuccessTest()
+  {
+    // Assemble
+    var bag = new PropertyBag
+    {
+      { ParameterType.Counter, 1 },
+      { "Name", "Lite" },
+    };
+
+    // Act
+    bag[ParameterType.KeyTest] = 42;
+    bag.Set(ParameterType.Counter, bag.Get(ParameterType.Counter, 0) + 1);
+
+    // Assert
+    Assert.AreEqual(2, bag[ParameterType.Counter]);
+    Assert.AreEqual(42, bag.Get(ParameterType.KeyTest, 0));
+    Assert.AreEqual("Lite", bag.Get("Name", string.Empty));
+    Assert.IsTrue(bag.ContainsKey(ParameterType.Counter));
+    Assert.IsTrue(bag.ContainsKey((object)ParameterType.Counter));
+    Assert.IsTrue(bag.Keys.SequenceEqual([ParameterType.Counter, "Name", ParameterType.KeyTest]));
+  }
+
+  /// <summary>Enum keys and their underlying integer values don't collide.</summary>
+  [TestMethod]
+  public void EnumAndIntKeys_AreDistinct_SuccessTest()
+  {
+    // Assemble
+    var bag = new PropertyBag();
+
+    // Act
+    bag.Set(ParameterType.Counter, "enum");
+    bag.Set((int)ParameterType.Counter, "int");
+    bag.Set(SignedKey.Negative, -1.5d);
+
+    // Assert
+    Assert.HasCount(3, bag);
+    Assert.AreEqual("enum", bag[ParameterType.Counter]);
+    Assert.AreEqual("int", bag[0]);
+    Assert.AreEqual(-1.5d, bag.Get(SignedKey.Negative, 0d));
+    Assert.AreEqual(SignedKey.Negative, bag.Keys.OfType<SignedKey>().Single());
+  }
+
+  /// <summary>Mismatched types fall back to default; NULL values are only returned for nullable types.</summary>
+  [TestMethod]
+  public void TypeMismatch_ReturnsDefault_SuccessTest()
+  {
+    // Assemble
+    var bag = new PropertyBag();
+    bag.SafeAdd(ParameterType.Counter, 5L);
+    bag.SafeAdd(ParameterType.KeyTest, null);
+
+    // Act/Assert
+    Assert.AreEqual(-1, bag.Get(ParameterType.Counter, -1));
+    Assert.AreEqual(5L, bag.Get(ParameterType.Counter, 0L));
+    Assert.IsFalse(bag.TryGetValue(ParameterType.KeyTest, out int _));
+    Assert.IsTrue(bag.TryGetValue(ParameterType.KeyTest, out string? nullValue));
+    Assert.IsNull(nullValue);
+    Assert.ThrowsExactly<ArgumentException>(() => bag.Add(ParameterType.Counter, 1));
+  }
+
+  /// <summary>A scope removes only the keys it added; one the child removes and adds back still belongs to the outer scope.</summary>
+  [TestMethod]
+  public void Scope_RemoveAndReAddOuterKey_KeptOnPopTest()
+  {
+    // Assemble
+    var bag = new PropertyBag();
+    bag.Set(ParameterType.Counter, 1);
+    var outer = bag.PushScope();
+    bag.Set(ParameterType.KeyTest, 2);
+    var inner = bag.PushScope();
+
+    // Act
+    Assert.IsTrue(bag.Remove(ParameterType.Counter));
+    bag.Set(ParameterType.Counter, 10);
+    Assert.IsTrue(bag.Remove(ParameterType.KeyTest));
+    bag.Add(ParameterType.KeyTest, 20);
+    bag.Set("Child", true);
+    bag.PopScope(inner);
+
+    // Assert
+    Assert.AreEqual(10, bag.Get(ParameterType.Counter, 0), "Root key re-added by the child survives");
+    Assert.AreEqual(20, bag.Get(ParameterType.KeyTest, 0), "Outer scope's key re-added by the child survives the inner scope");
+    Assert.IsFalse(bag.ContainsKey("Child"));
+
+    bag.PopScope(outer);
+    Assert.HasCount(1, bag);
+    Assert.AreEqual(10, bag.Get(ParameterType.Counter, 0));
+    Assert.AreEqual(0, bag.ScopeCount);
+  }
+
+  /// <summary>Keys a scope added are removed on pop, even when removed and added again within it.</summary>
+  [TestMethod]
+  public void Scope_RemoveAndReAddScopedKey_RemovedOnPopTest()
+  {
+    // Assemble
+    var bag = new PropertyBag { { ParameterType.Counter, 1 } };
+    var scope = bag.PushScope();
+    bag.Set(ParameterType.KeyTest, 2);
+
+    // Act
+    bag.Remove(ParameterType.KeyTest);
+    bag.Set(ParameterType.KeyTest, 3);
+    bag.Clear();
+    bag[ParameterType.Counter] = 4;
+    bag.PopScope(scope);
+
+    // Assert
+    Assert.HasCount(1, bag);
+    Assert.AreEqual(4, bag[ParameterType.Counter], "Root key cleared and re-added by the child survives");
+  }
+}
@@ -0,0 +1,241 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class RuntimeTests : TestBase
+{
+  /// <summary>Degree of parallelism of the batch tests.</summary>
+  private const int BatchParallelism = 4;
+
+  private enum RunStateId
+  {
+    Start,
+    Work,
+    Done,
+  }
+
+  /// <summary>Many instances share one definition while keeping their own context.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Runtime_StartsManyInstances_SuccessTestAsync()
+  {
+    // Assemble
+    const int InstanceCount = 1000;
+    var runtime = new StateMachineRuntime<RunStateId>(new StateMachine<RunStateId>()
+      .RegisterState<CountingState>(RunStateId.Start, RunStateId.Work)
+      .RegisterState<CountingState>(RunStateId.Work, RunStateId.Done)
+      .RegisterState<CountingState>(RunStateId.Done));
+
+    // Act
+    var machines = await Task.WhenAll(Enumerable.Range(0, InstanceCount)
+      .Select(i => runtime.StartAsync(RunStateId.Start, new() { { ParameterType.Counter, i } }, cancellationToken: TestContext.CancellationToken)));
+
+    // Assert
+    Assert.AreEqual(0, runtime.ActiveCount);
+    for (int i = 0; i < InstanceCount; i++)
+    {
+      Assert.AreEqual(i + 3, machines[i].Context.ParameterAsInt(ParameterType.Counter));
+      Assert.AreEqual(RunStateId.Work, machines[i].Context.PreviousStateId);
+    }
+  }
+
+  /// <summary>A state's NextStates override only affects its own instance.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Runtime_NextStateOverride_IsPerInstance_SuccessTestAsync()
+  {
+    // Assemble
+    var runtime = new StateMachineRuntime<RunStateId>(new StateMachine<RunStateId>()
+      .RegisterState<SkippingState>(RunStateId.Start, RunStateId.Work)
+      .RegisterState<CountingState>(RunStateId.Work, RunStateId.Done)
+      .RegisterState<CountingState>(RunStateId.Done));
+
+    // Act
+    var skipped = await runtime.StartAsync(RunStateId.Start, new() { { ParameterType.Counter, 0 }, { ParameterType.TestExecutionOrder, true } }, cancellationToken: TestContext.CancellationToken);
+    var normal = await runtime.StartAsync(RunStateId.Start, new() { { ParameterType.Counter, 0 } }, cancellationToken: TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(1, skipped.Context.ParameterAsInt(ParameterType.Counter));
+    Assert.AreEqual(3, normal.Context.ParameterAsInt(ParameterType.Counter));
+  }
+
+  /// <summary>Breaking out of a batch stops it, even over endless input.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Runtime_RunManyBreak_StopsBatchTestAsync()
+  {
+    // Assemble
+    var runtime = new StateMachineRuntime<RunStateId>(new StateMachine<RunStateId>()
+      .RegisterState<CountingState>(RunStateId.Start, RunStateId.Work)
+      .RegisterState<CountingState>(RunStateId.Work));
+
+    var inputs = Enumerable.Range(0, int.MaxValue).Select(i => new PropertyBag { { ParameterType.Counter, i } });
+    var received = 0;
+
+    // Act
+    await foreach (var result in runtime.RunManyAsync(inputs, RunStateId.Start, new() { MaxDegreeOfParallelism = BatchParallelism }, TestContext.CancellationToken))
+    {
+      if (++received == 10)
+        break;
+    }
+
+    // Assert
+    Assert.AreEqual(10, received);
+    Assert.AreEqual(0, runtime.ActiveCount);
+  }
+
+  /// <summary>An item throwing is reported with its input, while the rest of the batch completes.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Runtime_RunManyFaultingItem_ReportedAndBatchContinuesTestAsync()
+  {
+    // Assemble
+    const int ItemCount = 50;
+    var runtime = new StateMachineRuntime<RunStateId>(new StateMachine<RunStateId>()
+      .RegisterState<CountingState>(RunStateId.Start, RunStateId.Work)
+      .RegisterState<FaultingState>(RunStateId.Work, RunStateId.Done)
+      .RegisterState<CountingState>(RunStateId.Done));
+
+    // Negative counters fault in Work
+    var inputs = Enumerable.Range(0, ItemCount).Select(i => new PropertyBag { { ParameterType.Counter, i % 10 == 3 ? -10 : i } });
+    var faulted = new List<int>();
+    var completed = 0;
+
+    // Act
+    await foreach (var result in runtime.RunManyAsync(inputs, RunStateId.Start, new() { MaxDegreeOfParallelism = BatchParallelism }, TestContext.CancellationToken))
+    {
+      if (result.IsSuccess)
+      {
+        Assert.AreEqual(result.Index + 3, result.Context.ParameterAsInt(ParameterType.Counter));
+        completed++;
+        continue;
+      }
+
+      Assert.IsInstanceOfType<InvalidOperationException>(result.Exception);
+      Assert.AreEqual(RunStateId.Work, result.FinalStateId);
+      faulted.Add(result.Index);
+    }
+
+    // Assert
+    faulted.Sort();
+    CollectionAssert.AreEqual(new[] { 3, 13, 23, 33, 43 }, faulted);
+    Assert.AreEqual(ItemCount - faulted.Count, completed);
+  }
+
+  /// <summary>Every input runs once on a pooled instance, starting from the registered transitions and a clean context.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Runtime_RunManyPooled_StreamsEveryItemTestAsync()
+  {
+    // Assemble
+    const int ItemCount = 500;
+    var runtime = new StateMachineRuntime<RunStateId>(new StateMachine<RunStateId>()
+      .RegisterState<SkippingState>(RunStateId.Start, RunStateId.Work)
+      .RegisterState<CountingState>(RunStateId.Work, RunStateId.Done)
+      .RegisterState<CountingState>(RunStateId.Done));
+
+    // Every 7th item overrides its NextStates, ending after Start
+    var inputs = Enumerable.Range(0, ItemCount).Select(i => i % 7 == 0
+      ? new PropertyBag { { ParameterType.Counter, i }, { ParameterType.TestExecutionOrder, true } }
+      : new PropertyBag { { ParameterType.Counter, i } });
+
+    var counters = new int?[ItemCount];
+    var contexts = new HashSet<Context<RunStateId>>(ReferenceEqualityComparer.Instance);
+
+    // Act
+    await foreach (var result in runtime.RunManyAsync(inputs, RunStateId.Start, new() { MaxDegreeOfParallelism = BatchParallelism }, TestContext.CancellationToken))
+    {
+      Assert.IsTrue(result.IsSuccess);
+      Assert.IsNull(counters[result.Index], $"Item {result.Index} reported twice.");
+      Assert.AreEqual(result.Index % 7 == 0 ? RunStateId.Start : RunStateId.Done, result.FinalStateId);
+      Assert.IsEmpty(result.Context.Errors);
+      counters[result.Index] = result.Context.ParameterAsInt(ParameterType.Counter);
+      contexts.Add(result.Context);
+    }
+
+    // Assert
+    Assert.AreEqual(0, runtime.ActiveCount);
+    Assert.IsLessThanOrEqualTo((2 * BatchParallelism) + 1, contexts.Count);
+    for (int i = 0; i < ItemCount; i++)
+      Assert.AreEqual(i % 7 == 0 ? i + 1 : i + 3, counters[i], $"Item {i}");
+  }
+
+  /// <summary>Registering on the template after creating the runtime doesn't affect the shared definition.</summary>
+  [TestMethod]
+  public void Runtime_RegisterAfterCreate_DefinitionUnchangedTest()
+  {
+    // Assemble
+    var template = new StateMachine<RunStateId>()
+      .RegisterState<CountingState>(RunStateId.Start);
+
+    var runtime = new StateMachineRuntime<RunStateId>(template);
+
+    // Act
+    template.RegisterState<CountingState>(RunStateId.Work);
+
+    // Assert
+    Assert.HasCount(1, runtime.Definition.States);
+    Assert.HasCount(2, template.BuildDefinition().States);
+  }
+
+  private class CountingState : IState<RunStateId>
+  {
+    public Task OnEnter(Context<RunStateId> context)
+    {
+      context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<RunStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<RunStateId> context) => Task.CompletedTask;
+  }
+
+  /// <summary>Counts, throwing on a negative counter.</summary>
+  private class FaultingState : IState<RunStateId>
+  {
+    public Task OnEnter(Context<RunStateId> context)
+    {
+      if (context.ParameterAsInt(ParameterType.Counter) < 0)
+        throw new InvalidOperationException("Negative counter");
+
+      context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<RunStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<RunStateId> context) => Task.CompletedTask;
+  }
+
+  /// <summary>Ends the run after this state when <see cref="ParameterType.TestExecutionOrder"/> is set.</summary>
+  private class SkippingState : IState<RunStateId>
+  {
+    public Task OnEnter(Context<RunStateId> context)
+    {
+      if (context.ParameterAsBool(ParameterType.TestExecutionOrder))
+        context.NextStates.OnSuccess = null;
+
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<RunStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<RunStateId> context)
+    {
+      context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+      return Task.CompletedTask;
+    }
+  }
+}
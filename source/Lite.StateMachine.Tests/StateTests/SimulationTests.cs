@@ -0,0 +1,271 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class SimulationTests : TestBase
+{
+  /// <summary>Timer wheel resolution.</summary>
+  private const int TimerWheelTickMs = 10;
+
+  /// <summary>Command state timeout of the waiting state.</summary>
+  private const int WaitTimeoutMs = 1_000;
+
+  private enum SimKey
+  {
+    Attempts,
+    Clock,
+    Id,
+    Log,
+  }
+
+  private enum SimStateId
+  {
+    Waiting,
+    Retry,
+    Done,
+  }
+
+  /// <summary>Hours of command state timeouts run in virtual time, without waiting on the wall clock.</summary>
+  [TestMethod]
+  public void Simulation_CommandTimeouts_RunInVirtualTimeTest()
+  {
+    // Assemble
+    const int Hours = 2;
+    var sim = new StateMachineSimulation<SimStateId>(new StateMachine<SimStateId>()
+      .RegisterState<WaitingState>(SimStateId.Waiting, SimStateId.Done, onError: SimStateId.Retry)
+      .RegisterState<RetryState>(SimStateId.Retry, SimStateId.Waiting)
+      .RegisterState<DoneState>(SimStateId.Done));
+
+    var run = sim.Start(SimStateId.Waiting, NewParameters(0, int.MaxValue, [], sim.TimeProvider));
+    var wallClock = Stopwatch.StartNew();
+
+    // Act
+    sim.Advance(TimeSpan.FromHours(Hours));
+    var isCompleted = sim.IsCompleted;
+    run.Post(new PingMessage());
+    sim.RunUntilIdle();
+
+    // Assert
+    Assert.IsFalse(isCompleted, "Timeouts retry until the message arrives.");
+    Assert.IsTrue(sim.IsCompleted);
+    Assert.IsLessThan(TimeSpan.FromSeconds(30), wallClock.Elapsed);
+    Assert.AreEqual(TimeSpan.FromHours(Hours), sim.TimeProvider.Elapsed);
+    Assert.AreEqual(SimStateId.Done, run.Context.CurrentStateId);
+
+    // Wheel ticks are never early, at most one late per attempt
+    var attempts = int.MaxValue - run.Context.ParameterAsInt(SimKey.Attempts);
+    Assert.IsGreaterThan(Hours * 3_600 * 1_000 / (WaitTimeoutMs + TimerWheelTickMs), attempts);
+    Assert.IsLessThanOrEqualTo(Hours * 3_600 * 1_000 / WaitTimeoutMs, attempts);
+  }
+
+  /// <summary>Interleaved messages and timeouts of many instances replay in the same order, at the same virtual times.</summary>
+  [TestMethod]
+  public void Simulation_ManyInstances_ReplaysIdenticallyTest()
+  {
+    // Act
+    var first = Simulate(out var firstRuns);
+    var second = Simulate(out _);
+
+    // Assert
+    CollectionAssert.AreEqual(first, second);
+    for (int i = 0; i < firstRuns.Count; i++)
+    {
+      // Messages were posted to every third instance, all before its third timeout
+      var expected = i % 3 == 0 ? SimStateId.Done : SimStateId.Retry;
+      Assert.AreEqual(expected, firstRuns[i].Context.CurrentStateId, $"Instance {i}");
+      Assert.IsTrue(firstRuns[i].Completion.IsCompletedSuccessfully);
+    }
+  }
+
+  /// <summary>A timeout armed between ticks, while the wheel is already turning, counts from the clock rather than the last tick.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Simulation_ArmedMidTick_NeverEarlyTestAsync()
+  {
+    // Assemble
+    const int TimeoutMs = 100;
+    var clock = new VirtualTimeProvider();
+    var keepTurning = NewHungMachine(clock, TimeoutMs * 10);
+    var machine = NewHungMachine(clock, TimeoutMs);
+
+    var turning = keepTurning.RunAsync(SimStateId.Waiting, TestContext.CancellationToken);
+    clock.Advance(TimeSpan.FromMilliseconds(TimerWheelTickMs / 2));
+
+    // Act
+    var run = machine.RunAsync(SimStateId.Waiting, TestContext.CancellationToken);
+    clock.Advance(TimeSpan.FromMilliseconds(TimeoutMs - 1));
+    var completedEarly = await Task.WhenAny(run, Task.Delay(200, TestContext.CancellationToken)) == run;
+    clock.Advance(TimeSpan.FromMilliseconds(1 + TimerWheelTickMs));
+    await run.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken);
+
+    // Assert
+    Assert.IsFalse(completedEarly, "Timeout armed mid-tick mustn't elapse early.");
+    Assert.IsFalse(turning.IsCompleted);
+    clock.Advance(TimeSpan.FromMilliseconds(TimeoutMs * 10));
+    await turning.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken);
+  }
+
+  /// <summary><see cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/> of a regular run elapses as the virtual clock is advanced.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Simulation_RunAsyncStateTimeout_ElapsesOnAdvanceTestAsync()
+  {
+    // Assemble
+    var clock = new VirtualTimeProvider();
+    var trace = new TransitionTrace<SimStateId>();
+    var machine = new StateMachine<SimStateId>()
+    {
+      DefaultStateTimeoutMs = 5_000,
+      TimeProvider = clock,
+      Trace = trace,
+    }
+      .RegisterState<HungState>(SimStateId.Waiting, SimStateId.Done)
+      .RegisterState<DoneState>(SimStateId.Done)
+      .AddContext(NewParameters(0, 0, [], clock));
+
+    // Act
+    var run = machine.RunAsync(SimStateId.Waiting, TestContext.CancellationToken);
+    clock.Advance(TimeSpan.FromMilliseconds(4_900));
+    var isCompletedEarly = run.IsCompleted;
+    clock.Advance(TimeSpan.FromMilliseconds(100 + TimerWheelTickMs));
+    await run.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken);
+
+    // Assert
+    Assert.IsFalse(isCompletedEarly, "State timeout mustn't elapse early.");
+    Assert.AreEqual(SimStateId.Waiting, machine.Context.CurrentStateId);
+
+    var record = trace.Snapshot().Single();
+    Assert.IsNull(record.Result);
+    Assert.IsGreaterThanOrEqualTo(TimeSpan.FromSeconds(5), Stopwatch.GetElapsedTime(0, record.Duration));
+  }
+
+  private static StateMachine<SimStateId> NewHungMachine(VirtualTimeProvider clock, int stateTimeoutMs) =>
+    new StateMachine<SimStateId>()
+    {
+      DefaultStateTimeoutMs = stateTimeoutMs,
+      TimeProvider = clock,
+    }
+      .RegisterState<HungState>(SimStateId.Waiting)
+      .AddContext(NewParameters(0, 0, [], clock));
+
+  private static PropertyBag NewParameters(int id, int maxAttempts, List<string> log, VirtualTimeProvider clock) => new()
+  {
+    { SimKey.Attempts, maxAttempts },
+    { SimKey.Clock, clock },
+    { SimKey.Id, id },
+    { SimKey.Log, log },
+  };
+
+  /// <summary>Run 20 instances: every third gets a message, the others fail after 3 timeouts.</summary>
+  /// <param name="runs">Instances started.</param>
+  /// <returns>Log of every state entered, by instance and virtual time.</returns>
+  private static List<string> Simulate(out IReadOnlyList<StateMachineRun<SimStateId>> runs)
+  {
+    const int InstanceCount = 20;
+    var log = new List<string>();
+    var sim = new StateMachineSimulation<SimStateId>(new StateMachine<SimStateId>()
+      .RegisterState<WaitingState>(SimStateId.Waiting, SimStateId.Done, onError: SimStateId.Retry)
+      .RegisterState<RetryState>(SimStateId.Retry, SimStateId.Waiting)
+      .RegisterState<DoneState>(SimStateId.Done));
+
+    for (int i = 0; i < InstanceCount; i++)
+      sim.Start(SimStateId.Waiting, NewParameters(i, 3, log, sim.TimeProvider));
+
+    for (int i = 0; i < InstanceCount; i++)
+    {
+      sim.Advance(TimeSpan.FromMilliseconds(130));
+      if (i % 3 == 0)
+        sim.Runs[i].Post(new PingMessage());
+    }
+
+    Assert.IsTrue(sim.RunUntilComplete(TimeSpan.FromMinutes(1)));
+    runs = sim.Runs;
+    return log;
+  }
+
+  private static void Visit(Context<SimStateId> context)
+  {
+    var clock = (VirtualTimeProvider)context.Parameters[SimKey.Clock]!;
+    ((List<string>)context.Parameters[SimKey.Log]!).Add($"{context.ParameterAsInt(SimKey.Id)}:{context.CurrentStateId}@{clock.Elapsed.TotalMilliseconds}");
+  }
+
+  private class DoneState : IState<SimStateId>
+  {
+    public Task OnEnter(Context<SimStateId> context)
+    {
+      Visit(context);
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<SimStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<SimStateId> context) => Task.CompletedTask;
+  }
+
+  /// <summary>Never decides; left by <see cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/>.</summary>
+  private class HungState : IState<SimStateId>
+  {
+    public Task OnEnter(Context<SimStateId> context) => Task.CompletedTask;
+
+    public Task OnEntering(Context<SimStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<SimStateId> context) => Task.CompletedTask;
+  }
+
+  private class PingMessage;
+
+  /// <summary>Counts down the attempts left, failing once they're used up.</summary>
+  private class RetryState : IState<SimStateId>
+  {
+    public Task OnEnter(Context<SimStateId> context)
+    {
+      Visit(context);
+      var attemptsLeft = context.ParameterAsInt(SimKey.Attempts) - 1;
+      context.Parameters.Set(SimKey.Attempts, attemptsLeft);
+      context.NextState(attemptsLeft > 0 ? Result.Success : Result.Failure);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<SimStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<SimStateId> context) => Task.CompletedTask;
+  }
+
+  private class WaitingState : ICommandState<SimStateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(PingMessage)];
+
+    public int? TimeoutMs => WaitTimeoutMs;
+
+    public Task OnEnter(Context<SimStateId> context)
+    {
+      Visit(context);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<SimStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<SimStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<SimStateId> context, object message)
+    {
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnTimeout(Context<SimStateId> context)
+    {
+      context.NextState(Result.Error);
+      return Task.CompletedTask;
+    }
+  }
+}
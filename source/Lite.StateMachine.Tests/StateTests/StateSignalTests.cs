@@ -0,0 +1,133 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+/// <summary>The reusable signal each state entry waits on, in place of a <see cref="TaskCompletionSource{TResult}"/>.</summary>
+[TestClass]
+public class StateSignalTests : TestBase
+{
+  /// <summary>Each <see cref="StateSignal.Reset"/> starts a new version; the previous one's result and token don't carry over.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Signal_ReusedAcrossVersions_SuccessTestAsync()
+  {
+    // Assemble
+    var wheel = TimerWheel.For(new VirtualTimeProvider());
+    var signal = new StateSignal();
+
+    // Act/Assert
+    var first = signal.Version;
+    Assert.IsTrue(signal.TrySetResult(Result.Success));
+    Assert.IsFalse(signal.TrySetResult(Result.Failure), "Only the first result per entry is accepted");
+    Assert.AreEqual(Result.Success, await signal.WaitAsync(Timeout.Infinite, wheel, TestContext.CancellationToken));
+
+    signal.Reset();
+    var second = signal.Version;
+    Assert.AreNotEqual(first, second);
+    Assert.IsFalse(signal.IsCompleted);
+    Assert.IsFalse(signal.TryGetResult(out _));
+    Assert.IsFalse(signal.IsPending(first), "A stale entry's version is never pending");
+    Assert.IsTrue(signal.IsPending(second));
+
+    var wait = signal.WaitAsync(Timeout.Infinite, wheel, TestContext.CancellationToken);
+    Assert.IsFalse(wait.IsCompleted);
+
+    Assert.IsTrue(signal.TrySetResult(Result.Error));
+    Assert.AreEqual(Result.Error, await wait);
+  }
+
+  /// <summary>Cancellation racing a result settles on exactly one of them, and the waiter sees the one accepted.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Signal_CancellationRacesSetResult_OneWinsTestAsync()
+  {
+    // Assemble
+    const int Iterations = 2_000;
+    var wheel = TimerWheel.For(new VirtualTimeProvider());
+    var signal = new StateSignal();
+
+    for (int i = 0; i < Iterations; i++)
+    {
+      signal.Reset();
+      using var cts = new CancellationTokenSource();
+      var wait = signal.WaitAsync(Timeout.Infinite, wheel, cts.Token);
+
+      // Act
+      using var start = new Barrier(2);
+      var setter = Task.Run(
+        () =>
+        {
+          start.SignalAndWait(TestContext.CancellationToken);
+          return signal.TrySetResult(Result.Success);
+        },
+        TestContext.CancellationToken);
+
+      start.SignalAndWait(TestContext.CancellationToken);
+      cts.Cancel();
+
+      var accepted = await setter;
+      var result = await wait;
+
+      // Assert
+      Assert.AreEqual(accepted ? Result.Success : null, result, $"Iteration {i}");
+      Assert.IsFalse(signal.TrySetResult(Result.Failure));
+    }
+  }
+
+  /// <summary>A timeout expiring after the result was set is ignored, as is one armed for a previous version.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Signal_TimeoutAfterCompletion_IgnoredTestAsync()
+  {
+    // Assemble
+    var clock = new VirtualTimeProvider();
+    var wheel = TimerWheel.For(clock);
+    var signal = new StateSignal();
+
+    // Act - set, then let the armed timeout expire before the result is read
+    var wait = signal.WaitAsync(100, wheel, TestContext.CancellationToken);
+    Assert.IsTrue(signal.TrySetResult(Result.Success));
+    clock.Advance(TimeSpan.FromMilliseconds(200));
+
+    // Assert
+    Assert.AreEqual(Result.Success, await wait);
+
+    // Act - armed for one version, which completes unread; the next version waits with no timeout of its own
+    signal.Reset();
+    var first = signal.Version;
+    _ = signal.WaitAsync(100, wheel, TestContext.CancellationToken);
+    Assert.IsTrue(signal.TrySetResult(Result.Failure));
+
+    signal.Reset();
+    var second = signal.WaitAsync(Timeout.Infinite, wheel, TestContext.CancellationToken);
+    clock.Advance(TimeSpan.FromMilliseconds(200));
+
+    // Assert
+    Assert.IsTrue(signal.IsPending(signal.Version), $"Timeout armed for version {first} must not time out the next one");
+    Assert.IsTrue(signal.TrySetResult(Result.Error));
+    Assert.AreEqual(Result.Error, await second);
+  }
+
+  /// <summary>A timeout with no result set completes the wait with NULL.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Signal_TimeoutExpires_CompletesWithNullTestAsync()
+  {
+    // Assemble
+    var clock = new VirtualTimeProvider();
+    var signal = new StateSignal();
+
+    // Act
+    var wait = signal.WaitAsync(100, TimerWheel.For(clock), TestContext.CancellationToken);
+    clock.Advance(TimeSpan.FromMilliseconds(200));
+
+    // Assert
+    Assert.IsNull(await wait);
+    Assert.IsFalse(signal.TrySetResult(Result.Success), "The timeout claimed this entry");
+  }
+}
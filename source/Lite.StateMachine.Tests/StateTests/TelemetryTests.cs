@@ -0,0 +1,210 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using System.Linq;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData.States;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class TelemetryTests : TestBase
+{
+  private const int QueuedMessages = 8;
+
+  /// <summary>Names unique to this class, since listeners also see other tests running in parallel.</summary>
+  private enum TelemetryStateId
+  {
+    TelemetryStart,
+    TelemetryParent,
+    TelemetryChild,
+    TelemetryQueued,
+    TelemetryTimedOut,
+  }
+
+  /// <summary>Spans and metrics are emitted per state and composite once a listener is attached.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Telemetry_SpansAndMetrics_EmittedTestAsync()
+  {
+    // Assemble
+    var spans = new ConcurrentQueue<Activity>();
+    var transitions = new ConcurrentQueue<(string State, string Result)>();
+    var durations = new ConcurrentQueue<(string Instrument, string State)>();
+    string[] stateNames = [nameof(TelemetryStateId.TelemetryStart), nameof(TelemetryStateId.TelemetryParent), nameof(TelemetryStateId.TelemetryChild)];
+
+    using var activityListener = new ActivityListener
+    {
+      ShouldListenTo = source => source.Name == StateMachineTelemetry.Name,
+      Sample = (ref ActivityCreationOptions<ActivityContext> _) => ActivitySamplingResult.AllDataAndRecorded,
+      ActivityStopped = activity =>
+      {
+        if (stateNames.Contains(activity.OperationName))
+          spans.Enqueue(activity);
+      },
+    };
+
+    ActivitySource.AddActivityListener(activityListener);
+
+    using var meterListener = new MeterListener();
+    meterListener.InstrumentPublished = (instrument, listener) =>
+    {
+      if (instrument.Meter.Name == StateMachineTelemetry.Name)
+        listener.EnableMeasurementEvents(instrument);
+    };
+
+    meterListener.SetMeasurementEventCallback<long>((instrument, _, tags, _) =>
+    {
+      var state = Tag(tags, StateMachineTelemetry.StateTag);
+      if (instrument.Name == "lite.statemachine.transitions" && stateNames.Contains(state))
+        transitions.Enqueue((state!, Tag(tags, StateMachineTelemetry.ResultTag)!));
+    });
+
+    meterListener.SetMeasurementEventCallback<double>((instrument, _, tags, _) =>
+    {
+      var state = Tag(tags, StateMachineTelemetry.StateTag);
+      if (stateNames.Contains(state))
+        durations.Enqueue((instrument.Name, state!));
+    });
+
+    meterListener.Start();
+
+    var machine = new StateMachine<TelemetryStateId>()
+      .RegisterState<SuccessState<TelemetryStateId>>(TelemetryStateId.TelemetryStart, TelemetryStateId.TelemetryParent)
+      .RegisterComposite<ParentState<TelemetryStateId>>(TelemetryStateId.TelemetryParent, TelemetryStateId.TelemetryChild)
+      .RegisterSubState<SuccessState<TelemetryStateId>>(TelemetryStateId.TelemetryChild, TelemetryStateId.TelemetryParent);
+
+    // Act
+    await machine.RunAsync(TelemetryStateId.TelemetryStart, TestContext.CancellationToken);
+
+    // Assert
+    Assert.HasCount(3, spans);
+    var parent = spans.Single(a => a.OperationName == nameof(TelemetryStateId.TelemetryParent));
+    var child = spans.Single(a => a.OperationName == nameof(TelemetryStateId.TelemetryChild));
+    Assert.AreEqual(parent.SpanId, child.ParentSpanId, "Sub-state span should be nested in its composite's span");
+    Assert.AreEqual(true, parent.GetTagItem(StateMachineTelemetry.CompositeTag));
+    Assert.AreEqual("success", child.GetTagItem(StateMachineTelemetry.ResultTag));
+
+    Assert.HasCount(3, transitions);
+    Assert.IsTrue(transitions.All(t => t.Result == "success"));
+
+    foreach (var name in stateNames)
+    {
+      Assert.IsTrue(durations.Contains(("lite.statemachine.state.duration", name)), $"Missing dwell time for {name}");
+      Assert.IsTrue(durations.Contains(("lite.statemachine.state.on_enter.duration", name)), $"Missing OnEnter duration for {name}");
+      Assert.IsTrue(durations.Contains(("lite.statemachine.state.on_exit.duration", name)), $"Missing OnExit duration for {name}");
+    }
+  }
+
+  /// <summary>Command timeouts are counted and queued messages sampled, both tagged with the state.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Telemetry_CommandTimeoutsAndQueueDepth_RecordedTestAsync()
+  {
+    // Assemble
+    var timeouts = new ConcurrentQueue<long>();
+    var depths = new ConcurrentQueue<long>();
+
+    using var meterListener = new MeterListener();
+    meterListener.InstrumentPublished = (instrument, listener) =>
+    {
+      if (instrument.Meter.Name == StateMachineTelemetry.Name)
+        listener.EnableMeasurementEvents(instrument);
+    };
+
+    meterListener.SetMeasurementEventCallback<long>((instrument, value, tags, _) =>
+    {
+      var state = Tag(tags, StateMachineTelemetry.StateTag);
+      if (instrument.Name == "lite.statemachine.command.timeouts" && state == nameof(TelemetryStateId.TelemetryTimedOut))
+        timeouts.Enqueue(value);
+      else if (instrument.Name == "lite.statemachine.command.queue.depth" && state == nameof(TelemetryStateId.TelemetryQueued))
+        depths.Enqueue(value);
+    });
+
+    meterListener.Start();
+
+    var machine = new StateMachine<TelemetryStateId>(eventAggregator: new EventAggregator()) { MessageQueueCapacity = QueuedMessages * 2 }
+      .RegisterState<QueuedState>(TelemetryStateId.TelemetryQueued, TelemetryStateId.TelemetryTimedOut)
+      .RegisterState<TimedOutState>(TelemetryStateId.TelemetryTimedOut);
+
+    // Act
+    await machine.RunAsync(TelemetryStateId.TelemetryQueued, TestContext.CancellationToken);
+
+    // Assert
+    Assert.HasCount(1, timeouts);
+    Assert.AreEqual(1, timeouts.Single());
+
+    Assert.IsNotEmpty(depths);
+    Assert.IsTrue(depths.All(d => d is >= 1 and <= QueuedMessages), $"Unexpected depths: {string.Join(", ", depths)}");
+  }
+
+  private static string? Tag(ReadOnlySpan<KeyValuePair<string, object?>> tags, string key)
+  {
+    foreach (var tag in tags)
+    {
+      if (tag.Key == key)
+        return tag.Value as string;
+    }
+
+    return null;
+  }
+
+  private class PingMessage;
+
+  /// <summary>Queues <see cref="QueuedMessages"/> messages to itself and succeeds once all are handled.</summary>
+  private class QueuedState : ICommandState<TelemetryStateId>
+  {
+    private int _handled;
+
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(PingMessage)];
+
+    public Task OnEnter(Context<TelemetryStateId> context)
+    {
+      for (int i = 0; i < QueuedMessages; i++)
+        context.EventAggregator?.Publish(new PingMessage());
+
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<TelemetryStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<TelemetryStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<TelemetryStateId> context, object message)
+    {
+      if (++_handled == QueuedMessages)
+        context.NextState(Result.Success);
+
+      return Task.CompletedTask;
+    }
+
+    public Task OnTimeout(Context<TelemetryStateId> context) => Task.CompletedTask;
+  }
+
+  /// <summary>Waits for a message that never comes, then succeeds on its command timeout.</summary>
+  private class TimedOutState : ICommandState<TelemetryStateId>
+  {
+    public IReadOnlyCollection<Type> SubscribedMessageTypes => [typeof(PingMessage)];
+
+    public int? TimeoutMs => 20;
+
+    public Task OnEnter(Context<TelemetryStateId> context) => Task.CompletedTask;
+
+    public Task OnEntering(Context<TelemetryStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<TelemetryStateId> context) => Task.CompletedTask;
+
+    public Task OnMessage(Context<TelemetryStateId> context, object message) => Task.CompletedTask;
+
+    public Task OnTimeout(Context<TelemetryStateId> context)
+    {
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+  }
+}
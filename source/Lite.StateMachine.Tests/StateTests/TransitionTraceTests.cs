@@ -0,0 +1,238 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Buffers.Binary;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData.States;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class TransitionTraceTests : TestBase
+{
+  private enum TraceStateId
+  {
+    Start,
+    Parent,
+    Child,
+    Done,
+  }
+
+  /// <summary>Every completed state is recorded in completion order, composites after their children.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Trace_RecordsCompletedStates_SuccessTestAsync()
+  {
+    // Assemble
+    var trace = new TransitionTrace<TraceStateId>(16);
+    var machine = new StateMachine<TraceStateId>()
+      .RegisterState<SuccessState<TraceStateId>>(TraceStateId.Start, TraceStateId.Parent)
+      .RegisterComposite<ParentState<TraceStateId>>(TraceStateId.Parent, TraceStateId.Child, onSuccess: TraceStateId.Done)
+      .RegisterSubState<SuccessState<TraceStateId>>(TraceStateId.Child, TraceStateId.Parent)
+      .RegisterState<SuccessState<TraceStateId>>(TraceStateId.Done);
+
+    machine.Trace = trace;
+
+    // Act
+    await machine.RunAsync(TraceStateId.Start, TestContext.CancellationToken);
+
+    // Assert
+    var records = trace.Snapshot();
+    Assert.HasCount(4, records);
+    CollectionAssert.AreEqual(
+      new[] { TraceStateId.Start, TraceStateId.Child, TraceStateId.Parent, TraceStateId.Done },
+      Array.ConvertAll(records, r => r.StateId));
+
+    Assert.IsNull(records[0].PreviousStateId);
+    Assert.IsNull(records[1].PreviousStateId, "Initial sub-state has no previous state");
+    Assert.AreEqual(TraceStateId.Start, records[2].PreviousStateId);
+    Assert.AreEqual(TraceStateId.Parent, records[3].PreviousStateId);
+
+    foreach (var record in records)
+    {
+      Assert.AreEqual(Result.Success, record.Result);
+      Assert.IsGreaterThanOrEqualTo(0L, record.Duration);
+    }
+
+    Assert.IsGreaterThanOrEqualTo(records[0].Timestamp, records[1].Timestamp);
+    Assert.IsGreaterThanOrEqualTo(records[1].Duration, records[2].Duration, "Composite spans its children");
+  }
+
+  /// <summary>A state whose handler throws is recorded as faulted, along with the composite it was running in.</summary>
+  /// <param name="isPassive">Run passively instead of with RunAsync.</param>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  [DataRow(false, DisplayName = "RunAsync")]
+  [DataRow(true, DisplayName = "Passive")]
+  public async Task Trace_HandlerThrows_RecordsFaultedStatesTestAsync(bool isPassive)
+  {
+    // Assemble
+    var trace = new TransitionTrace<TraceStateId>(16);
+    var machine = new StateMachine<TraceStateId>()
+      .RegisterState<SuccessState<TraceStateId>>(TraceStateId.Start, TraceStateId.Parent)
+      .RegisterComposite<ParentState<TraceStateId>>(TraceStateId.Parent, TraceStateId.Child, onSuccess: TraceStateId.Done)
+      .RegisterSubState<ThrowingState>(TraceStateId.Child, TraceStateId.Parent)
+      .RegisterState<SuccessState<TraceStateId>>(TraceStateId.Done);
+
+    machine.Trace = trace;
+
+    // Act
+    if (isPassive)
+    {
+      var run = machine.Start(TraceStateId.Start);
+      await Assert.ThrowsExactlyAsync<InvalidOperationException>(() => run.Completion.WaitAsync(TimeSpan.FromSeconds(5), TestContext.CancellationToken));
+    }
+    else
+    {
+      await Assert.ThrowsExactlyAsync<InvalidOperationException>(() => machine.RunAsync(TraceStateId.Start, TestContext.CancellationToken));
+    }
+
+    // Assert
+    var records = trace.Snapshot();
+    CollectionAssert.AreEqual(
+      new[] { TraceStateId.Start, TraceStateId.Child, TraceStateId.Parent },
+      Array.ConvertAll(records, r => r.StateId));
+
+    Assert.IsFalse(records[0].IsFaulted);
+    Assert.AreEqual(Result.Success, records[0].Result);
+
+    Assert.IsTrue(records[1].IsFaulted);
+    Assert.IsNull(records[1].Result);
+    Assert.IsNull(records[1].PreviousStateId);
+
+    Assert.IsTrue(records[2].IsFaulted);
+    Assert.IsNull(records[2].Result);
+    Assert.AreEqual(TraceStateId.Start, records[2].PreviousStateId);
+  }
+
+  /// <summary>Records are on the machine's <see cref="TimeProvider"/> clock, and the binary header carries its frequency.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task Trace_CustomTimeProvider_WritesProviderFrequencyTestAsync()
+  {
+    // Assemble
+    var clock = new SteppingTimeProvider();
+    var trace = new TransitionTrace<TraceStateId>(8);
+    var machine = new StateMachine<TraceStateId>()
+    {
+      TimeProvider = clock,
+      Trace = trace,
+    }
+      .RegisterState<SuccessState<TraceStateId>>(TraceStateId.Start, TraceStateId.Done)
+      .RegisterState<SuccessState<TraceStateId>>(TraceStateId.Done);
+
+    // Act
+    await machine.RunAsync(TraceStateId.Start, TestContext.CancellationToken);
+
+    using var stream = new MemoryStream();
+    trace.WriteTo(stream);
+
+    // Assert
+    Assert.AreEqual(SteppingTimeProvider.Frequency, trace.TimestampFrequency);
+    Assert.AreEqual(SteppingTimeProvider.Frequency, BinaryPrimitives.ReadInt64LittleEndian(stream.ToArray().AsSpan(12)));
+
+    foreach (var record in trace.Snapshot())
+    {
+      Assert.IsGreaterThan(0L, record.Duration);
+      Assert.IsLessThanOrEqualTo(clock.Now, record.Timestamp + record.Duration, "Timestamps come from the machine's clock");
+    }
+  }
+
+  /// <summary>Once full, the oldest records are overwritten.</summary>
+  [TestMethod]
+  public void Trace_Wraparound_KeepsNewestTest()
+  {
+    // Assemble
+    var trace = new TransitionTrace<TraceStateId>(3);
+
+    // Act
+    for (var i = 0; i < 10; i++)
+      trace.Write(new((TraceStateId)(i % 4), null, Result.Success, i, 0, 0));
+
+    // Assert
+    Assert.AreEqual(4, trace.Capacity, "Capacity rounds up to a power of two");
+    Assert.AreEqual(4, trace.Count);
+    Assert.AreEqual(10, trace.TotalWritten);
+
+    var records = trace.Snapshot();
+    CollectionAssert.AreEqual(new long[] { 6, 7, 8, 9 }, Array.ConvertAll(records, r => r.Timestamp));
+
+    // Smaller destination gets the newest
+    Span<TransitionRecord<TraceStateId>> newest = stackalloc TransitionRecord<TraceStateId>[2];
+    Assert.AreEqual(2, trace.CopyTo(newest));
+    Assert.AreEqual(8, newest[0].Timestamp);
+    Assert.AreEqual(9, newest[1].Timestamp);
+  }
+
+  /// <summary>The binary export is a header followed by the raw records.</summary>
+  [TestMethod]
+  public void Trace_WriteTo_RoundTripsTest()
+  {
+    // Assemble
+    var trace = new TransitionTrace<TraceStateId>(8);
+    trace.Write(new(TraceStateId.Start, null, Result.Success, 100, 5, 1));
+    trace.Write(new(TraceStateId.Done, TraceStateId.Start, null, 200, 7, 2, isFaulted: true));
+
+    // Act
+    using var stream = new MemoryStream();
+    var written = trace.WriteTo(stream);
+
+    // Assert
+    var bytes = stream.ToArray();
+    Assert.AreEqual(2, written);
+    Assert.AreEqual(TransitionTrace<TraceStateId>.HeaderSize + (2 * TransitionTrace<TraceStateId>.RecordSize), bytes.Length);
+    Assert.AreEqual(TransitionTrace<TraceStateId>.Magic, BinaryPrimitives.ReadUInt32LittleEndian(bytes));
+    Assert.AreEqual(TransitionTrace<TraceStateId>.FormatVersion, BinaryPrimitives.ReadUInt16LittleEndian(bytes.AsSpan(4)));
+    Assert.AreEqual(TransitionTrace<TraceStateId>.RecordSize, BinaryPrimitives.ReadUInt16LittleEndian(bytes.AsSpan(6)));
+    Assert.AreEqual(2, BinaryPrimitives.ReadInt32LittleEndian(bytes.AsSpan(8)));
+    Assert.AreEqual(32, TransitionTrace<TraceStateId>.RecordSize, "Documented layout for an int State Id");
+
+    // Documented offsets
+    var second = bytes.AsSpan(TransitionTrace<TraceStateId>.HeaderSize + TransitionTrace<TraceStateId>.RecordSize);
+    Assert.AreEqual(200, MemoryMarshal.Read<long>(second));
+    Assert.AreEqual(7, MemoryMarshal.Read<long>(second[8..]));
+    Assert.AreEqual(2, MemoryMarshal.Read<int>(second[16..]));
+    Assert.AreEqual(2 | 4, second[21], "HasPreviousStateId | IsFaulted");
+    Assert.AreEqual((int)TraceStateId.Done, MemoryMarshal.Read<int>(second[24..]));
+    Assert.AreEqual((int)TraceStateId.Start, MemoryMarshal.Read<int>(second[28..]));
+
+    var records = MemoryMarshal.Cast<byte, TransitionRecord<TraceStateId>>(bytes.AsSpan(TransitionTrace<TraceStateId>.HeaderSize));
+    Assert.AreEqual(TraceStateId.Start, records[0].StateId);
+    Assert.AreEqual(Result.Success, records[0].Result);
+    Assert.AreEqual(TraceStateId.Done, records[1].StateId);
+    Assert.AreEqual(TraceStateId.Start, records[1].PreviousStateId);
+    Assert.IsNull(records[1].Result);
+    Assert.AreEqual(200, records[1].Timestamp);
+    Assert.AreEqual(7, records[1].Duration);
+    Assert.AreEqual(2, records[1].ThreadId);
+    Assert.IsFalse(records[0].IsFaulted);
+    Assert.IsTrue(records[1].IsFaulted);
+  }
+
+  /// <summary>Millisecond clock advancing one tick per read.</summary>
+  private sealed class SteppingTimeProvider : TimeProvider
+  {
+    public const long Frequency = 1000;
+
+    private long _now;
+
+    public long Now => Interlocked.Read(ref _now);
+
+    public override long TimestampFrequency => Frequency;
+
+    public override long GetTimestamp() => Interlocked.Increment(ref _now);
+  }
+
+  private class ThrowingState : IState<TraceStateId>
+  {
+    public Task OnEnter(Context<TraceStateId> context) => throw new InvalidOperationException("Boom");
+
+    public Task OnEntering(Context<TraceStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<TraceStateId> context) => Task.CompletedTask;
+  }
+}
@@ -0,0 +1,89 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData;
+using Lite.StateMachine.Tests.TestData.Models;
+using Lite.StateMachine.Tests.TestData.States;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class ValueStateTests : TestBase
+{
+  /// <summary>Value states and classic states can be mixed in the same machine.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task ValueState_MixedWithIState_Executes123_SuccessTestAsync()
+  {
+    // Assemble
+    var machine = new StateMachine<BasicStateId>()
+      .RegisterState<ValueState>(BasicStateId.State1, BasicStateId.State2)
+      .RegisterState<BasicState2>(BasicStateId.State2, BasicStateId.State3)
+      .RegisterState<ValueState>(BasicStateId.State3)
+      .AddContext(new()
+      {
+        { ParameterType.Counter, 0 },
+        { ParameterType.TestExecutionOrder, true },
+      });
+
+    // Act
+    await machine.RunAsync(BasicStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    AssertMachineNotNull(machine);
+    Assert.AreEqual(9, machine.Context.ParameterAsInt(ParameterType.Counter));
+    Assert.AreEqual(BasicStateId.State2, machine.Context.PreviousStateId);
+  }
+
+  /// <summary>Value command state receives its message through the ValueTask hook.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task ValueCommandState_OnMessage_Success_SuccessTestAsync()
+  {
+    // Assemble
+    var events = new EventAggregator();
+    var machine = new StateMachine<BasicStateId>(eventAggregator: events)
+      .RegisterState<ValueCommandState>(BasicStateId.State1, onSuccess: BasicStateId.State2, onError: null, subscriptionTypes: [typeof(UnlockResponse)])
+      .RegisterState<ValueState>(BasicStateId.State2)
+      .AddContext(new() { { ParameterType.Counter, 0 } });
+
+    events.Subscribe(msg =>
+    {
+      if (msg is UnlockCommand cmd)
+        events.Publish(new UnlockResponse { Counter = cmd.Counter + 1 });
+    });
+
+    // Act
+    await machine.RunAsync(BasicStateId.State1, TestContext.CancellationToken);
+
+    // Assert - 1 from OnMessage + 3 from ValueState
+    Assert.AreEqual(4, machine.Context.ParameterAsInt(ParameterType.Counter));
+    Assert.AreEqual(BasicStateId.State1, machine.Context.PreviousStateId);
+  }
+
+  /// <summary>Callers outside of the machine can still use the <see cref="IState{TStateId}"/> hooks.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task ValueState_IStateHooks_ForwardToValueTask_SuccessTestAsync()
+  {
+    // Assemble - Borrow a machine's context, then reset the counter
+    var machine = new StateMachine<BasicStateId>()
+      .RegisterState<ValueState>(BasicStateId.State1)
+      .AddContext(new() { { ParameterType.Counter, 0 } });
+
+    await machine.RunAsync(BasicStateId.State1, TestContext.CancellationToken);
+
+    var ctx = machine.Context;
+    ctx.Parameters[ParameterType.Counter] = 0;
+    IState<BasicStateId> state = new ValueState();
+
+    // Act
+    await state.OnEntering(ctx);
+    await state.OnEnter(ctx);
+    await state.OnExit(ctx);
+
+    // Assert
+    Assert.AreEqual(3, ctx.ParameterAsInt(ParameterType.Counter));
+  }
+}
@@ -0,0 +1,140 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.StateTests;
+
+[TestClass]
+public class WarmUpTests : TestBase
+{
+  private enum WarmStateId
+  {
+    State1,
+    State2,
+    State3,
+  }
+
+  /// <summary>Warming up creates every state once, and the run reuses them.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task WarmUp_AllStates_RunReusesInstances_SuccessTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var machine = CreateMachine(tracker);
+
+    // Act
+    await machine.WarmUpAsync(cancellationToken: TestContext.CancellationToken);
+    var createdAfterWarmUp = tracker.Created;
+    await machine.RunAsync(WarmStateId.State1, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(3, createdAfterWarmUp);
+    Assert.AreEqual(3, tracker.Warmed);
+    Assert.AreEqual(3, tracker.Created);
+    Assert.AreEqual(3, tracker.Entered);
+  }
+
+  /// <summary>Only the selected states are warmed, in parallel.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task WarmUp_SelectedStates_Parallel_SuccessTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var machine = CreateMachine(tracker);
+    var options = new WarmUpOptions<WarmStateId>
+    {
+      States = [WarmStateId.State2, WarmStateId.State3],
+      MaxDegreeOfParallelism = -1,
+    };
+
+    // Act
+    await machine.WarmUpAsync(options, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(2, tracker.Created);
+    Assert.AreEqual(2, tracker.Warmed);
+  }
+
+  /// <summary>A state listed more than once is created and warmed once, even in parallel.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous unit test.</returns>
+  [TestMethod]
+  public async Task WarmUp_DuplicateStates_Parallel_WarmedOnceTestAsync()
+  {
+    // Assemble
+    var tracker = new Tracker();
+    var machine = CreateMachine(tracker);
+    var options = new WarmUpOptions<WarmStateId>
+    {
+      States = [WarmStateId.State2, WarmStateId.State2, WarmStateId.State3, WarmStateId.State2],
+      MaxDegreeOfParallelism = -1,
+    };
+
+    // Act
+    await machine.WarmUpAsync(options, TestContext.CancellationToken);
+
+    // Assert
+    Assert.AreEqual(2, tracker.Created);
+    Assert.AreEqual(2, tracker.Warmed);
+  }
+
+  private static StateMachine<WarmStateId> CreateMachine(Tracker tracker) =>
+    new StateMachine<WarmStateId>(containerFactory: _ => new WarmState(tracker))
+      .RegisterState<WarmState>(WarmStateId.State1, WarmStateId.State2)
+      .RegisterState<WarmState>(WarmStateId.State2, WarmStateId.State3)
+      .RegisterState<WarmState>(WarmStateId.State3);
+
+  /// <summary>Per-test counters; tests run in parallel so nothing static.</summary>
+  private sealed class Tracker
+  {
+    private int _created;
+    private int _entered;
+    private int _warmed;
+
+    public int Created => _created;
+
+    public int Entered => _entered;
+
+    public int Warmed => _warmed;
+
+    public void OnCreated() => Interlocked.Increment(ref _created);
+
+    public void OnEntered() => Interlocked.Increment(ref _entered);
+
+    public void OnWarmed() => Interlocked.Increment(ref _warmed);
+  }
+
+  private sealed class WarmState : IState<WarmStateId>, IWarmable
+  {
+    private readonly Tracker _tracker;
+    private byte[]? _buffer;
+
+    public WarmState(Tracker tracker)
+    {
+      _tracker = tracker;
+      _tracker.OnCreated();
+    }
+
+    public Task OnEnter(Context<WarmStateId> context)
+    {
+      Assert.IsNotNull(_buffer, "Buffer should have been pre-allocated by warm-up.");
+      _tracker.OnEntered();
+      context.NextState(Result.Success);
+      return Task.CompletedTask;
+    }
+
+    public Task OnEntering(Context<WarmStateId> context) => Task.CompletedTask;
+
+    public Task OnExit(Context<WarmStateId> context) => Task.CompletedTask;
+
+    public Task WarmUpAsync(CancellationToken cancellationToken)
+    {
+      _buffer = new byte[1024];
+      _tracker.OnWarmed();
+      return Task.CompletedTask;
+    }
+  }
+}
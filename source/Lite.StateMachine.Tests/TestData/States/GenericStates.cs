@@ -0,0 +1,38 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine.Tests.TestData.States;
+
+#pragma warning disable SA1649 // File name should match first type name
+#pragma warning disable SA1402 // File may only contain a single type
+
+/// <summary>Leaf state exiting with <see cref="Result.Success"/>, for tests with their own State Id enum.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class SuccessState<TStateId> : StateBase<SuccessState<TStateId>, TStateId>
+  where TStateId : struct, Enum;
+
+/// <summary>Composite parent exiting with its last child's result.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class ParentState<TStateId> : StateBase<ParentState<TStateId>, TStateId>
+  where TStateId : struct, Enum
+{
+  public override Task OnExit(Context<TStateId> context)
+  {
+    context.NextState(context.LastChildResult ?? Result.Failure);
+    return base.OnExit(context);
+  }
+}
+
+/// <summary>Never decides; left by <see cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/> or cancellation.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+public class HungState<TStateId> : StateBase<HungState<TStateId>, TStateId>
+  where TStateId : struct, Enum
+{
+  public override Task OnEnter(Context<TStateId> context) => Task.CompletedTask;
+}
+
+#pragma warning restore SA1649 // File name should match first type name
+#pragma warning restore SA1402 // File may only contain a single type
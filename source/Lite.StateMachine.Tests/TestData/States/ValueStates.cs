@@ -0,0 +1,70 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading.Tasks;
+using Lite.StateMachine.Tests.TestData.Models;
+
+namespace Lite.StateMachine.Tests.TestData.States;
+
+#pragma warning disable SA1649 // File name should match first type name
+#pragma warning disable SA1402 // File may only contain a single type
+
+/// <summary>Counts each <see cref="ValueTask"/> hook, similar to <see cref="BasicState1"/>.</summary>
+public class ValueState : IValueState<BasicStateId>
+{
+  public ValueTask OnEnter(Context<BasicStateId> context)
+  {
+    context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+    context.NextState(Result.Success);
+    return ValueTask.CompletedTask;
+  }
+
+  public ValueTask OnEntering(Context<BasicStateId> context)
+  {
+    context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+    return ValueTask.CompletedTask;
+  }
+
+  public ValueTask OnExit(Context<BasicStateId> context)
+  {
+    context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+    return ValueTask.CompletedTask;
+  }
+}
+
+/// <summary>Waits on an <see cref="UnlockResponse"/> before succeeding; times out to Error.</summary>
+public class ValueCommandState : IValueCommandState<BasicStateId>
+{
+  public int? TimeoutMs => 2000;
+
+  public ValueTask OnEnter(Context<BasicStateId> context)
+  {
+    context.EventAggregator?.Publish(new UnlockCommand { Counter = 1 });
+    return ValueTask.CompletedTask;
+  }
+
+  public ValueTask OnEntering(Context<BasicStateId> context) => ValueTask.CompletedTask;
+
+  public ValueTask OnExit(Context<BasicStateId> context) => ValueTask.CompletedTask;
+
+  public async ValueTask OnMessage(Context<BasicStateId> context, object message)
+  {
+    if (message is not UnlockResponse)
+      return;
+
+    // Some async work here...
+    await Task.Yield();
+
+    context.Parameters[ParameterType.Counter] = context.ParameterAsInt(ParameterType.Counter) + 1;
+    context.NextState(Result.Success);
+  }
+
+  public ValueTask OnTimeout(Context<BasicStateId> context)
+  {
+    context.NextState(Result.Error);
+    return ValueTask.CompletedTask;
+  }
+}
+
+#pragma warning restore SA1402 // File may only contain a single type
+#pragma warning restore SA1649 // File name should match first type name
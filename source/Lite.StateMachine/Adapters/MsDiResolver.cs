@@ -1,25 +1,40 @@
 // Copyright Xeno Innovations, Inc. 2025
 // See the LICENSE file in the project root for more information.
 
-/*
 using System;
+using System.Diagnostics.CodeAnalysis;
 using Microsoft.Extensions.DependencyInjection;
 
 namespace Lite.StateMachine.Adapters;
 
+/// <summary>Microsoft.Extensions.DependencyInjection adapter.</summary>
 public sealed class MsDiResolver : IServiceResolver
 {
   private readonly IServiceProvider _provider;
 
+  /// <summary>Initializes a new instance of the <see cref="MsDiResolver"/> class.</summary>
+  /// <param name="provider">Service provider.</param>
   public MsDiResolver(IServiceProvider provider) =>
     _provider = provider;
 
+  /// <inheritdoc/>
   public object? InnerContainer => _provider;
 
-  public T CreateInstance<T>()
+  /// <inheritdoc/>
+  public Func<T> CreateFactory<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T>()
+    where T : class
+  {
+    // Constructor and parameter resolution are bound once; each call only resolves the arguments
+    var factory = ActivatorUtilities.CreateFactory<T>(Type.EmptyTypes);
+    var provider = _provider;
+    return () => factory(provider, null);
+  }
+
+  /// <inheritdoc/>
+  public T CreateInstance<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T>()
     where T : class =>
     ActivatorUtilities.CreateInstance<T>(_provider);
 
+  /// <inheritdoc/>
   public object? GetService(Type serviceType) => _provider.GetService(serviceType);
 }
-*/
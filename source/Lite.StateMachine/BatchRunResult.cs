@@ -0,0 +1,38 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+
+namespace Lite.StateMachine;
+
+/// <summary>Outcome of one input of <see cref="StateMachineRuntime{TStateId}.RunManyAsync"/>.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>The <see cref="Context"/> is pooled; it's only valid until the next result is requested.</remarks>
+public readonly struct BatchRunResult<TStateId>
+  where TStateId : struct, Enum
+{
+  internal BatchRunResult(int index, StateMachineRun<TStateId> run, Exception? exception)
+  {
+    Index = index;
+    Run = run;
+    Exception = exception;
+  }
+
+  /// <summary>Gets the item's context, as the run left it.</summary>
+  public Context<TStateId> Context => Run.Context;
+
+  /// <summary>Gets the exception a state threw, ending the item's run; otherwise NULL.</summary>
+  public Exception? Exception { get; }
+
+  /// <summary>Gets the last state entered.</summary>
+  public TStateId FinalStateId => Run.Context.CurrentStateId;
+
+  /// <summary>Gets the input's position in the batch; results stream in completion order.</summary>
+  public int Index { get; }
+
+  /// <summary>Gets a value indicating whether the item ran without throwing.</summary>
+  public bool IsSuccess => Exception is null;
+
+  /// <summary>Gets the pooled run.</summary>
+  internal StateMachineRun<TStateId> Run { get; }
+}
@@ -0,0 +1,55 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Message subscription, message pump and timeout of a single command state entry.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+internal struct CommandStateScope<TStateId>
+  where TStateId : struct, Enum
+{
+#pragma warning disable SA1401 // Fields should be private
+
+  /// <summary>OnMessage calls in flight on publisher threads, when subscribed without a pump or route.</summary>
+  public InFlightMessages? Handlers;
+
+  /// <summary>Optional message pump (<see cref="IStateMachine{TStateId}.MessageQueueCapacity"/> &gt; 0).</summary>
+  public MessagePump? Pump;
+
+  /// <summary>Active message route (<see cref="IStateMachine{TStateId}.IsMessageRoutingEnabled"/>), instead of a subscription.</summary>
+  public MessageRouter<TStateId>.Route? Route;
+
+  /// <summary>Event aggregator subscription.</summary>
+  public IDisposable? Subscription;
+
+  /// <summary>Optional command timeout.</summary>
+  public CommandTimeout<TStateId>? Timeout;
+
+#pragma warning restore SA1401 // Fields should be private
+
+  /// <summary>
+  ///   Stop the timeout, unsubscribe, and let an in-flight OnTimeout/OnMessage finish,
+  ///   so it can't publish into the next state or run on a released instance.
+  /// </summary>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  /// <remarks>Idempotent; called before the transition and again when the entry ends, including by an exception.</remarks>
+  public readonly async ValueTask StopAsync()
+  {
+    if (Timeout is not null)
+      await Timeout.StopAsync().ConfigureAwait(false);
+
+    Subscription?.Dispose();
+
+    if (Route is not null)
+      await Route.StopAsync().ConfigureAwait(false);
+
+    if (Handlers is not null)
+      await Handlers.CloseAsync().ConfigureAwait(false);
+
+    if (Pump is not null)
+      await Pump.CompleteAsync().ConfigureAwait(ConfigureAwaitOptions.SuppressThrowing);
+  }
+}
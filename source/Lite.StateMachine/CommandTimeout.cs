@@ -0,0 +1,105 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine;
+
+/// <summary>Reusable <see cref="ICommandState{TStateId}.OnTimeout"/> trigger armed on the run's <see cref="TimerWheel"/>.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>Replaces a linked <see cref="CancellationTokenSource"/>, <see cref="Task.Run(Func{Task})"/> and <see cref="Task.Delay(int)"/> per command state entry.</remarks>
+internal sealed class CommandTimeout<TStateId> : TimerWheel.Entry
+  where TStateId : struct, Enum
+{
+  private readonly Func<Task> _runTimeout;
+
+  private CancellationToken _cancellationToken;
+  private ICommandState<TStateId>? _cmd;
+  private Context<TStateId>? _context;
+  private short _entryVersion;
+
+  /// <summary>OnTimeout in flight, if the entry fired.</summary>
+  private Task? _inFlight;
+
+  private ILogger? _logger;
+  private string _stateName = string.Empty;
+
+  /// <summary>Initializes a new instance of the <see cref="CommandTimeout{TStateId}"/> class.</summary>
+  public CommandTimeout() => _runTimeout = RunTimeoutAsync;
+
+  /// <summary>Gets a value indicating whether it can be re-armed; not armed and no OnTimeout still running.</summary>
+  public bool IsIdle => !IsArmed && (_inFlight is null || _inFlight.IsCompleted);
+
+  /// <summary>Arm the timeout for a command state entry.</summary>
+  /// <param name="cmd">Command state.</param>
+  /// <param name="context">State context.</param>
+  /// <param name="entryVersion">Signal version captured at state entry.</param>
+  /// <param name="timeoutMs">Timeout in milliseconds.</param>
+  /// <param name="wheel">Wheel timing the timeout.</param>
+  /// <param name="stateName">Cached state name.</param>
+  /// <param name="logger">Run's logger, or NULL.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  public void Start(
+    ICommandState<TStateId> cmd,
+    Context<TStateId> context,
+    short entryVersion,
+    int timeoutMs,
+    TimerWheel wheel,
+    string stateName,
+    ILogger? logger,
+    CancellationToken cancellationToken)
+  {
+    _cmd = cmd;
+    _context = context;
+    _stateName = stateName;
+    _logger = logger;
+    _entryVersion = entryVersion;
+    _cancellationToken = cancellationToken;
+    _inFlight = null;
+
+    wheel.Arm(this, timeoutMs);
+  }
+
+  /// <summary>Disarm the timeout without waiting.</summary>
+  public void Disarm() => TryDisarm();
+
+  /// <summary>Disarm the timeout and let an in-flight OnTimeout finish.</summary>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  public async ValueTask StopAsync()
+  {
+    // NOTE: The wheel sets _inFlight under its lock, so once Disarm fails it's visible here.
+    if (TryDisarm() || _inFlight is not { } inFlight)
+      return;
+
+    await inFlight.ConfigureAwait(ConfigureAwaitOptions.SuppressThrowing);
+  }
+
+  /// <inheritdoc/>
+  protected internal override void OnExpired()
+  {
+    if (_cancellationToken.IsCancellationRequested || !_context!.Signal.IsPending(_entryVersion))
+      return;
+
+    // Off the wheel's thread
+    _inFlight = Task.Run(_runTimeout, CancellationToken.None);
+  }
+
+  private async Task RunTimeoutAsync()
+  {
+    if (_cancellationToken.IsCancellationRequested || !_context!.Signal.IsPending(_entryVersion))
+      return;
+
+    // Nothing awaits this to rethrow; the state still exits by its own decision or timeout
+    try
+    {
+      await StateMachineRun<TStateId>.OnTimeoutAsync(_cmd!, _context, _stateName, _logger).ConfigureAwait(false);
+    }
+    catch (Exception ex)
+    {
+      StateMachineLog.OnTimeoutFaulted(_logger, ex, _stateName);
+    }
+  }
+}
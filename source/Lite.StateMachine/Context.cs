@@ -4,7 +4,6 @@
 namespace Lite.StateMachine;
 
 using System;
-using System.Threading.Tasks;
 
 /// <summary>Context passed to every state. Provides a "Parameter" and a NextState(Result) trigger.</summary>
 /// <typeparam name="TStateId">Type of state enum.</typeparam>
@@ -19,19 +18,14 @@ public sealed class Context<TStateId>
 
 #pragma warning restore SA1401 // Fields should be private
 
-  ////private readonly TaskCompletionSource<Result> _tcs;
-  private TaskCompletionSource<Result> _tcs;
-
   internal Context(
     TStateId currentStateId,
     StateMap<TStateId> nextStates,
-    TaskCompletionSource<Result> tcs,
     IEventAggregator? eventAggregator = null,
     Result? lastChildResult = null)
   {
     CurrentStateId = currentStateId;
     NextStates = nextStates;
-    _tcs = tcs;
     EventAggregator = eventAggregator;
     LastChildResult = lastChildResult;
   }
@@ -57,54 +51,90 @@ public sealed class Context<TStateId>
   /// <summary>Gets the previous state's enum value.</summary>
   public TStateId? PreviousStateId { get; internal set; }
 
-  /// <summary>Not for user consumption. Configures Context for state transitions.</summary>
-  /// <param name="tcs">Task Completion Source.</param>
+  /// <summary>Gets each region's outcome, in region order (for parallel composite parents only).</summary>
+  public System.Collections.Generic.IReadOnlyList<RegionResult<TStateId>> RegionResults { get; private set; } = [];
+
+  /// <summary>Gets the reusable result signal for the current state entry.</summary>
+  internal StateSignal Signal { get; } = new();
+
+  /// <summary>Signal the machine to move forward (only once per state entry).</summary>
+  /// <param name="result">Result to pass to the next state.</param>
+  /// <remarks>Consider renaming to `StateResult` or `Result` for clarity.</remarks>
+  public void NextState(Result result) => Signal.TrySetResult(result);
+
+  /// <summary>Get parameter value as <see cref="bool"/> or default.</summary>
+  /// <param name="key">Parameter Key.</param>
+  /// <param name="defaultBool">Default bool (default=false).</param>
+  /// <returns>Boolean or default.</returns>
+  /// <remarks>Kept for binary compatibility; typed keys bind to <see cref="ParameterAsBool{TKey}(TKey, bool)"/>, which doesn't box.</remarks>
+  public bool ParameterAsBool(object key, bool defaultBool = false) => Parameters.Get(key, defaultBool);
+
+  /// <summary>Get parameter value as <see cref="bool"/> or default, without boxing enum keys.</summary>
+  /// <typeparam name="TKey">Parameter key type.</typeparam>
+  /// <param name="key">Parameter Key.</param>
+  /// <param name="defaultBool">Default bool (default=false).</param>
+  /// <returns>Boolean or default.</returns>
+  public bool ParameterAsBool<TKey>(TKey key, bool defaultBool = false)
+    where TKey : notnull => Parameters.Get(key, defaultBool);
+
+  /// <summary>Get parameter value as <see cref="int"/> or default.</summary>
+  /// <param name="key">Parameter Key.</param>
+  /// <param name="defaultInt">Default int (default=0).</param>
+  /// <returns>Integer or default.</returns>
+  /// <remarks>Kept for binary compatibility; typed keys bind to <see cref="ParameterAsInt{TKey}(TKey, int)"/>, which doesn't box.</remarks>
+  public int ParameterAsInt(object key, int defaultInt = 0) => Parameters.Get(key, defaultInt);
+
+  /// <summary>Get parameter value as <see cref="int"/> or default, without boxing enum keys.</summary>
+  /// <typeparam name="TKey">Parameter key type.</typeparam>
+  /// <param name="key">Parameter Key.</param>
+  /// <param name="defaultInt">Default int (default=0).</param>
+  /// <returns>Integer or default.</returns>
+  public int ParameterAsInt<TKey>(TKey key, int defaultInt = 0)
+    where TKey : notnull => Parameters.Get(key, defaultInt);
+
+  /// <summary>Configures Context for a new state entry and re-arms its result signal.</summary>
   /// <param name="currentStateId">Current state that we're in.</param>
   /// <param name="previousStateId">State which sent us here.</param>
-  public void Configure(TaskCompletionSource<Result> tcs, TStateId currentStateId, TStateId? previousStateId)
+  internal void Configure(TStateId currentStateId, TStateId? previousStateId)
   {
-    _tcs = tcs;
+    Signal.Reset();
     CurrentStateId = currentStateId;
     PreviousStateId = previousStateId;
   }
 
-  /// <summary>Not for user consumption. Configures Composite Context state transitions.</summary>
-  /// <param name="tcs">Task Completion Source.</param>
+  /// <summary>Configures Composite Context for its exit and re-arms its result signal.</summary>
   /// <param name="currentStateId">Current state that we're in.</param>
   /// <param name="previousStateId">State which sent us here.</param>
   /// <param name="lastChildStateId">Last child state's <see cref="TStateId?"/>.</param>
   /// <param name="lastChildResult">Last child state's <see cref="Result?"/> which sent us here.</param>
-  public void Configure(TaskCompletionSource<Result> tcs, TStateId currentStateId, TStateId? previousStateId, TStateId? lastChildStateId, Result? lastChildResult)
+  internal void Configure(TStateId currentStateId, TStateId? previousStateId, TStateId? lastChildStateId, Result? lastChildResult)
   {
-    _tcs = tcs;
-    CurrentStateId = currentStateId;
-    PreviousStateId = previousStateId;
-    LastChildStateId = lastChildStateId;
-    LastChildResult = lastChildResult;
+    Configure(currentStateId, previousStateId);
+    SetLastChild(lastChildStateId, lastChildResult);
   }
 
-  /// <summary>Signal the machine to move forward (only once per state entry).</summary>
-  /// <param name="result">Result to pass to the next state.</param>
-  /// <remarks>Consider renaming to `StateResult` or `Result` for clarity.</remarks>
-  public void NextState(Result result) => _tcs.TrySetResult(result);
-
-  public bool ParameterAsBool(object key, bool defaultBool = false)
+  /// <summary>Clears what the last run left behind, for a pooled run's next input.</summary>
+  /// <param name="parameters">Next input's parameters, used as-is.</param>
+  internal void Reset(PropertyBag parameters)
   {
-    if (Parameters.TryGetValue(key, out var value) && value is bool boolValue)
-      return boolValue;
-    else
-      return defaultBool;
+    Configure(default, null, null, null);
+    RegionResults = [];
+    Parameters = parameters;
+    Errors ??= [];
+    Errors.Clear();
   }
 
-  /// <summary>Get default parameter value as <see cref="int"/> or default.</summary>
-  /// <param name="key">Parameter Key.</param>
-  /// <param name="defaultInt">Default int (default=0).</param>
-  /// <returns>Integer or default.</returns>
-  public int ParameterAsInt(object key, int defaultInt = 0)
+  /// <summary>Sets (or clears) the composite's last child details without re-arming the result signal.</summary>
+  /// <param name="lastChildStateId">Last child state's <see cref="TStateId?"/>.</param>
+  /// <param name="lastChildResult">Last child state's <see cref="Result?"/>.</param>
+  internal void SetLastChild(TStateId? lastChildStateId, Result? lastChildResult)
   {
-    if (Parameters.TryGetValue(key, out var value) && value is int intValue)
-      return intValue;
-    else
-      return defaultInt;
+    LastChildStateId = lastChildStateId;
+    LastChildResult = lastChildResult;
   }
+
+  /// <summary>Sets (or clears, with an empty list) the parallel composite's region outcomes.</summary>
+  /// <param name="regionResults">Region outcomes, in region order.</param>
+  internal void SetRegionResults(System.Collections.Generic.IReadOnlyList<RegionResult<TStateId>> regionResults) =>
+    RegionResults = regionResults;
 }
@@ -2,68 +2,104 @@
 // See the LICENSE file in the project root for more information.
 
 using System;
-using System.Collections.Generic;
+using System.Collections.Concurrent;
+using System.Threading;
+using Microsoft.Extensions.Logging;
 
 namespace Lite.StateMachine;
 
+/// <summary>Lock-free event aggregator.</summary>
+/// <remarks>
+///   Subscriber lists are immutable arrays swapped atomically on subscribe/unsubscribe (copy-on-write),
+///   so publishing takes no lock and allocates nothing. Use <see cref="Subscribe{T}(Action{T})"/> and
+///   <see cref="Publish{T}(in T)"/> to deliver value-type messages without boxing.
+/// </remarks>
 public sealed class EventAggregator : IEventAggregator
 {
-  //// Pre .NET 9: private readonly object _lockGate = new();
-  private readonly System.Threading.Lock _lockGate = new();
+  // Generic (Action<T>) subscribers keyed by exact message Type
+  private readonly ConcurrentDictionary<Type, GenericHandlers> _genericSubscribers = new();
 
   // Typed subscribers keyed by exact runtime Type
-  private readonly Dictionary<Type, List<Action<object>>> _typedSubscribers = [];
+  private readonly ConcurrentDictionary<Type, Handlers<Action<object>>> _typedSubscribers = new();
+
+  // Optional logger of subscriber exceptions
+  private readonly ILogger? _logger;
 
   // Wildcard subscribers (receive all messages)
-  private readonly List<Action<object>> _wildcardSubscribers = [];
+  private readonly Handlers<Action<object>> _wildcardSubscribers = new();
+
+  /// <summary>Initializes a new instance of the <see cref="EventAggregator"/> class.</summary>
+  public EventAggregator()
+  {
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="EventAggregator"/> class with a logger.</summary>
+  /// <param name="logger">Logger of exceptions thrown by subscribers, which are otherwise swallowed; NULL for none.</param>
+  public EventAggregator(ILogger<EventAggregator>? logger) => _logger = logger;
 
   public void Publish(object message)
   {
     if (message is null)
       return;
 
-    Action<object>[] wildcardSnapshot;
-    Action<object>[] typedSnapshot;
-
     var msgType = message.GetType();
 
-    lock (_lockGate)
-    {
-      wildcardSnapshot = _wildcardSubscribers.ToArray();
-      if (_typedSubscribers.TryGetValue(msgType, out var list))
-        typedSnapshot = list.ToArray();
-      else
-        typedSnapshot = [];
-    }
-
     // Deliver to typed subscribers first (exact matches), then wildcard
     // Handlers decide whether to consume or ignore; exceptions are swallowed.
-#pragma warning disable SA1501 // Statement should not be on a single line
-    foreach (var sub in typedSnapshot)
-    {
-      try { sub(message); }
-      catch { /* Swallow to avoid breaking publication loop. */ }
-    }
+    if (_genericSubscribers.TryGetValue(msgType, out var generic))
+      generic.Invoke(message, _logger);
+
+    if (_typedSubscribers.TryGetValue(msgType, out var typed))
+      Deliver(typed.Items, message);
+
+    Deliver(_wildcardSubscribers.Items, message);
+  }
 
-    foreach (var sub in wildcardSnapshot)
+  /// <summary>Publish a message without boxing value types.</summary>
+  /// <param name="message">Message to publish (not null).</param>
+  /// <typeparam name="T">Type to publish.</typeparam>
+  public void Publish<T>(T message) => Publish(in message);
+
+  /// <summary>Publish a message without boxing or copying value types.</summary>
+  /// <param name="message">Message to publish (not null).</param>
+  /// <typeparam name="T">Type to publish.</typeparam>
+  /// <remarks>Subscribers by <see cref="Type"/> and wildcard subscribers still receive it, boxed once, only if there are any.</remarks>
+  public void Publish<T>(in T message)
+  {
+    // Subscriptions are keyed by runtime type; derived messages take the object path.
+    // NOTE: Guarded by IsValueType so the null check never boxes, even in Debug builds.
+    if (!typeof(T).IsValueType)
     {
-      try { sub(message); }
-      catch { /* Swallow to avoid breaking publication loop. */ }
+      if (message is null)
+        return;
+
+      if (message.GetType() != typeof(T))
+      {
+        Publish((object)message);
+        return;
+      }
     }
-#pragma warning restore SA1501 // Statement should not be on a single line
+
+    if (_genericSubscribers.TryGetValue(typeof(T), out var generic))
+      ((GenericHandlers<T>)generic).Invoke(in message, _logger);
+
+    _typedSubscribers.TryGetValue(typeof(T), out var typed);
+    var typedHandlers = typed?.Items ?? [];
+    var wildcardHandlers = _wildcardSubscribers.Items;
+    if (typedHandlers.Length == 0 && wildcardHandlers.Length == 0)
+      return;
+
+    object boxed = message!;
+    Deliver(typedHandlers, boxed);
+    Deliver(wildcardHandlers, boxed);
   }
 
   public IDisposable Subscribe(Action<object> handler)
   {
     ArgumentNullException.ThrowIfNull(handler);
-    lock (_lockGate)
-      _wildcardSubscribers.Add(handler);
+    _wildcardSubscribers.Add(handler);
 
-    return new Subscription(() =>
-    {
-      lock (_lockGate)
-        _wildcardSubscribers.Remove(handler);
-    });
+    return new Subscription(() => _wildcardSubscribers.Remove(handler));
   }
 
   public IDisposable Subscribe(Action<object> handler, params Type[] messageTypes)
@@ -78,55 +114,146 @@ public sealed class EventAggregator : IEventAggregator
     }
 
     // Register handler under each provided type
-    lock (_lockGate)
+    foreach (var t in messageTypes)
+    {
+      if (t is null)
+        continue;
+
+      _typedSubscribers.GetOrAdd(t, static _ => new()).Add(handler);
+    }
+
+    // Composite unsubscribe removes handler from each type list.
+    // NOTE: Empty lists are kept, removing them would race a concurrent subscribe.
+    return new Subscription(() =>
     {
       foreach (var t in messageTypes)
       {
         if (t is null)
           continue;
 
-        if (!_typedSubscribers.TryGetValue(t, out var list))
-        {
-          list = [];
-          _typedSubscribers[t] = list;
-        }
+        if (_typedSubscribers.TryGetValue(t, out var list))
+          list.Remove(handler);
+      }
+    });
+  }
+
+  /// <summary>Subscribe to messages of exactly type <typeparamref name="T"/> without boxing value types.</summary>
+  /// <param name="handler">Subscription listener method.</param>
+  /// <typeparam name="T">Message type.</typeparam>
+  /// <returns>Disposable subscription.</returns>
+  public IDisposable Subscribe<T>(Action<T> handler)
+  {
+    ArgumentNullException.ThrowIfNull(handler);
+
+    var list = (GenericHandlers<T>)_genericSubscribers.GetOrAdd(typeof(T), static _ => new GenericHandlers<T>());
+    list.Add(handler);
+
+    return new Subscription(() => list.Remove(handler));
+  }
+
+#pragma warning disable SA1501 // Statement should not be on a single line
+
+  /// <summary>Log an exception swallowed from a subscriber, if errors are enabled.</summary>
+  private static void OnSubscriberFaulted(ILogger? logger, Exception exception, Type messageType)
+  {
+    if (logger is not null && logger.IsEnabled(LogLevel.Error))
+      StateMachineLog.SubscriberFaulted(logger, exception, messageType.Name);
+  }
+
+  private void Deliver(Action<object>[] handlers, object message)
+  {
+    foreach (var sub in handlers)
+    {
+      try { sub(message); }
+      catch (Exception ex) { OnSubscriberFaulted(_logger, ex, message.GetType()); /* Swallow to avoid breaking publication loop. */ }
+    }
+  }
+
+  /// <summary>Subscribers of one exact message type, for either publish path.</summary>
+  private abstract class GenericHandlers
+  {
+    public abstract void Invoke(object message, ILogger? logger);
+  }
+
+  private sealed class GenericHandlers<T> : GenericHandlers
+  {
+    private readonly Handlers<Action<T>> _handlers = new();
+
+    public void Add(Action<T> handler) => _handlers.Add(handler);
 
-        list.Add(handler);
+    public override void Invoke(object message, ILogger? logger) => Invoke((T)message, logger);
+
+    public void Invoke(in T message, ILogger? logger)
+    {
+      foreach (var sub in _handlers.Items)
+      {
+        try { sub(message); }
+        catch (Exception ex) { OnSubscriberFaulted(logger, ex, typeof(T)); /* Swallow to avoid breaking publication loop. */ }
       }
     }
 
-    // Composite unsubscribe removes handler from each type list
-    return new Subscription(() =>
+    public void Remove(Action<T> handler) => _handlers.Remove(handler);
+  }
+
+#pragma warning restore SA1501 // Statement should not be on a single line
+
+  /// <summary>Copy-on-write handler array; readers take a snapshot of <see cref="Items"/> without locking.</summary>
+  /// <typeparam name="THandler">Handler delegate type.</typeparam>
+  private sealed class Handlers<THandler>
+    where THandler : Delegate
+  {
+    private THandler[] _items = [];
+
+    public THandler[] Items => Volatile.Read(ref _items);
+
+    public void Add(THandler handler)
     {
-      lock (_lockGate)
+      THandler[] current, updated;
+      do
       {
-        foreach (var t in messageTypes)
+        current = Items;
+        updated = new THandler[current.Length + 1];
+        current.CopyTo(updated, 0);
+        updated[^1] = handler;
+      }
+      while (Interlocked.CompareExchange(ref _items, updated, current) != current);
+    }
+
+    public void Remove(THandler handler)
+    {
+      THandler[] current, updated;
+      do
+      {
+        current = Items;
+        var index = Array.IndexOf(current, handler);
+        if (index < 0)
+          return;
+
+        if (current.Length == 1)
+        {
+          updated = [];
+        }
+        else
         {
-          if (t is null)
-            continue;
-
-          if (_typedSubscribers.TryGetValue(t, out var list))
-          {
-            list.Remove(handler);
-            if (list.Count == 0)
-              _typedSubscribers.Remove(t);
-          }
+          updated = new THandler[current.Length - 1];
+          Array.Copy(current, 0, updated, 0, index);
+          Array.Copy(current, index + 1, updated, index, current.Length - index - 1);
         }
       }
-    });
+      while (Interlocked.CompareExchange(ref _items, updated, current) != current);
+    }
   }
 
   private sealed class Subscription : IDisposable
   {
     private readonly Action _unsubscribe;
-    private bool _disposed;
+    private int _disposed;
 
     public Subscription(Action unsubscribe) => _unsubscribe = unsubscribe;
 
     public void Dispose()
     {
-      if (_disposed) return;
-      _disposed = true;
+      if (Interlocked.Exchange(ref _disposed, 1) != 0) return;
       _unsubscribe();
     }
   }
@@ -15,6 +15,10 @@ public class DuplicateStateException(string message) : InvalidOperationException
 /// <remarks>Happens when a custom-override provided is not in the allowed list.</remarks>
 public class InvalidStateTransitionException(string message) : InvalidOperationException(message);
 
+/// <summary>Checkpoint is corrupt, from a newer format, or doesn't match the registered states.</summary>
+/// <param name="message">Message.</param>
+public class InvalidCheckpointException(string message) : InvalidOperationException(message);
+
 /// <summary>Top-level state is missing an initial state.</summary>
 /// <param name="message">Message.</param>
 public class MissingInitialStateException(string message) : InvalidOperationException(message);
@@ -0,0 +1,56 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+
+namespace Lite.StateMachine;
+
+/// <summary>Declares one state of a <see cref="GeneratedStateMachineAttribute"/> class.</summary>
+/// <remarks>
+///   State Id arguments are typed <see cref="object"/> since attributes can't be generic over the enum; the generator
+///   reports a compile error if they aren't the machine's State Id type.
+///   Setting <see cref="InitialSubState"/> makes it a composite, setting <see cref="Regions"/> makes it a parallel composite,
+///   and setting <see cref="Parent"/> makes it a sub-state.
+/// </remarks>
+[AttributeUsage(AttributeTargets.Class, AllowMultiple = true, Inherited = false)]
+public sealed class GeneratedStateAttribute : Attribute
+{
+  /// <summary>Initializes a new instance of the <see cref="GeneratedStateAttribute"/> class.</summary>
+  /// <param name="stateId">State Id.</param>
+  /// <param name="stateType">State class; must implement <see cref="IState{TStateId}"/> and have a public parameterless constructor.</param>
+  public GeneratedStateAttribute(object stateId, Type stateType)
+  {
+    StateId = stateId;
+    StateType = stateType;
+  }
+
+  /// <summary>Gets or sets the composite's initial sub-state.</summary>
+  public object? InitialSubState { get; set; }
+
+  /// <summary>Gets or sets how a parallel composite's <see cref="Regions"/> are joined.</summary>
+  public JoinPolicy JoinPolicy { get; set; } = JoinPolicy.All;
+
+  /// <summary>Gets or sets the state instance lifetime.</summary>
+  public StateLifetime Lifetime { get; set; } = StateLifetime.Singleton;
+
+  /// <summary>Gets or sets the State Id to transition to on <see cref="Result.Error"/>.</summary>
+  public object? OnError { get; set; }
+
+  /// <summary>Gets or sets the State Id to transition to on <see cref="Result.Failure"/>.</summary>
+  public object? OnFailure { get; set; }
+
+  /// <summary>Gets or sets the State Id to transition to on <see cref="Result.Success"/>.</summary>
+  public object? OnSuccess { get; set; }
+
+  /// <summary>Gets or sets the parent composite's State Id.</summary>
+  public object? Parent { get; set; }
+
+  /// <summary>Gets or sets the initial sub-state of each region, making it a parallel composite (instead of <see cref="InitialSubState"/>).</summary>
+  public object[]? Regions { get; set; }
+
+  /// <summary>Gets the State Id.</summary>
+  public object StateId { get; }
+
+  /// <summary>Gets the state class.</summary>
+  public Type StateType { get; }
+}
@@ -0,0 +1,32 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+
+namespace Lite.StateMachine;
+
+/// <summary>
+///   Opt-in to the Lite.StateMachine source generator for a <c>partial</c> class declaring its topology with <see cref="GeneratedStateAttribute"/>.
+///   The generator validates the topology at compile time and emits <c>CreateStateMachine(...)</c>, registering each state with a <c>new()</c> factory.
+/// </summary>
+/// <example>
+///   <code><![CDATA[
+///   [GeneratedStateMachine(typeof(StateId))]
+///   [GeneratedState(StateId.Start, typeof(StartState), OnSuccess = StateId.Done)]
+///   [GeneratedState(StateId.Done, typeof(DoneState))]
+///   public static partial class OrderFlow;
+///
+///   await OrderFlow.CreateStateMachine().RunAsync(StateId.Start);
+///   ]]></code>
+/// </example>
+[AttributeUsage(AttributeTargets.Class, AllowMultiple = false, Inherited = false)]
+public sealed class GeneratedStateMachineAttribute : Attribute
+{
+  /// <summary>Initializes a new instance of the <see cref="GeneratedStateMachineAttribute"/> class.</summary>
+  /// <param name="stateIdType">State Id enum type.</param>
+  public GeneratedStateMachineAttribute(Type stateIdType) =>
+    StateIdType = stateIdType;
+
+  /// <summary>Gets the State Id enum type.</summary>
+  public Type StateIdType { get; }
+}
@@ -0,0 +1,33 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Command-state receiving its messages in batches: everything queued since the last call, in one invocation.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Batch states always use a message queue (<see cref="IStateMachine{TStateId}.MessageQueueCapacity"/>, or unbounded when disabled).
+///   <see cref="ICommandState{TStateId}.OnMessage"/> is not called by the state machine; by default it forwards a batch of one.
+/// </remarks>
+public interface IBatchCommandState<TStateId> : ICommandState<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Gets the maximum number of messages per batch (default: 64).</summary>
+  int MaxBatchSize => 64;
+
+  /// <summary>Gets the maximum time in milliseconds to wait for a batch to fill once a message is queued (default: 0, no waiting).</summary>
+  int MaxBatchLingerMs => 0;
+
+  /// <summary>Receives the queued messages from the event aggregator, in publish order.</summary>
+  /// <param name="context">State context.</param>
+  /// <param name="messages">Message objects; only valid until the returned task completes.</param>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  Task OnMessageBatch(Context<TStateId> context, ReadOnlyMemory<object> messages);
+
+  /// <inheritdoc/>
+  Task ICommandState<TStateId>.OnMessage(Context<TStateId> context, object message) =>
+    OnMessageBatch(context, new object[] { message });
+}
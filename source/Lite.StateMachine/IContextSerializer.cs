@@ -0,0 +1,22 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Buffers;
+
+namespace Lite.StateMachine;
+
+/// <summary>Serializes <see cref="Context{TStateId}.Parameters"/> and <see cref="Context{TStateId}.Errors"/> for checkpoints.</summary>
+/// <remarks>Only the entries needed to resume have to be written; anything else (services, handles) can be re-added with <c>AddContext</c>.</remarks>
+public interface IContextSerializer
+{
+  /// <summary>Write the bag's entries.</summary>
+  /// <param name="bag">Parameters or errors.</param>
+  /// <param name="writer">Destination.</param>
+  void Serialize(PropertyBag bag, IBufferWriter<byte> writer);
+
+  /// <summary>Restore entries written by <see cref="Serialize"/>, over the bag's current entries.</summary>
+  /// <param name="data">Bytes written by <see cref="Serialize"/>.</param>
+  /// <param name="bag">Parameters or errors to restore into.</param>
+  void Deserialize(ReadOnlySpan<byte> data, PropertyBag bag);
+}
@@ -27,8 +27,14 @@ public interface IEventAggregator
   /// <returns>Disposable subscription.</returns>
   IDisposable Subscribe(Action<object> handler, params Type[] messageTypes);
 
-  /// <summary>Generic convenience overload.</summary>
+  /// <summary>Generic convenience overload; implementations may deliver it without boxing.</summary>
   /// <param name="message">Message object to publish (not null).</param>
   /// <typeparam name="T">Type to publish.</typeparam>
   void Publish<T>(T message) => Publish((object)message!);
+
+  /// <summary>Subscribe to messages of exactly type <typeparamref name="T"/>.</summary>
+  /// <param name="handler">Subscription listener method.</param>
+  /// <typeparam name="T">Message type.</typeparam>
+  /// <returns>Disposable subscription.</returns>
+  IDisposable Subscribe<T>(Action<T> handler) => Subscribe(message => handler((T)message), typeof(T));
 }
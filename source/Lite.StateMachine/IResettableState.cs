@@ -0,0 +1,13 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+namespace Lite.StateMachine;
+
+/// <summary>State that resets itself before being returned to the <see cref="StateLifetime.Pooled"/> pool.</summary>
+/// <remarks>Pooled states not implementing it are reused as-is.</remarks>
+public interface IResettableState
+{
+  /// <summary>Reset the instance for reuse.</summary>
+  /// <returns>True to return it to the pool; false to discard (and dispose) it.</returns>
+  bool TryReset();
+}
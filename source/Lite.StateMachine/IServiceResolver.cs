@@ -2,20 +2,27 @@
 // See the LICENSE file in the project root for more information.
 
 using System;
+using System.Diagnostics.CodeAnalysis;
 
 namespace Lite.StateMachine;
 
-/*
 /// <summary>Minimal adapter so the state machine can use any DI container.</summary>
 public interface IServiceResolver
 {
   /// <summary>Gets underlying container for advanced use-cases (optional).</summary>
   object? InnerContainer => null;
 
+  /// <summary>Create a reusable factory for T, resolving its constructor once up-front.</summary>
+  /// <typeparam name="T">Type to create.</typeparam>
+  /// <returns>Factory creating instances of T using the container's constructor injection.</returns>
+  /// <remarks>Called once per registration; defaults to <see cref="CreateInstance{T}"/> on every call.</remarks>
+  Func<T> CreateFactory<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T>()
+    where T : class => CreateInstance<T>;
+
   /// <summary>Create an instance of T using the container's constructor injection.</summary>
   /// <typeparam name="T">Type to create.</typeparam>
   /// <returns>Instance of T.</returns>
-  T CreateInstance<T>()
+  T CreateInstance<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] T>()
     where T : class;
 
   /// <summary>Resolve a service instance (optional; used by states via Context.Services if needed).</summary>
@@ -23,4 +30,3 @@ public interface IServiceResolver
   /// <returns>Service instance or null if not registered.</returns>
   object? GetService(Type serviceType);
 }
-*/
@@ -2,8 +2,12 @@
 // See the LICENSE file in the project root for more information.
 
 using System;
+using System.Buffers;
 using System.Collections.Generic;
+using System.Diagnostics.CodeAnalysis;
+using System.IO;
 using System.Threading;
+using System.Threading.Channels;
 using System.Threading.Tasks;
 
 namespace Lite.StateMachine;
@@ -27,6 +31,22 @@ public interface IStateMachine<TStateId>
   /// <summary>Gets or sets a value indicating whether substate-added context persists when returning to the parent (default: true).</summary>
   bool IsContextPersistent { get; set; }
 
+  /// <summary>
+  ///   Gets or sets a value indicating whether command states receive messages through one per-run route (default: false).
+  ///   Entering and leaving a command state then only flips its route, instead of subscribing and unsubscribing, and
+  ///   messages are also delivered to states subscribed to their base types or interfaces.
+  /// </summary>
+  bool IsMessageRoutingEnabled { get; set; }
+
+  /// <summary>
+  ///   Gets or sets the per-<see cref="ICommandState{TStateId}"/> message queue capacity (default: 0, disabled).
+  ///   When enabled, publishers only enqueue and <c>OnMessage</c> runs serialized on a single consumer; otherwise it runs on the publisher's thread.
+  /// </summary>
+  int MessageQueueCapacity { get; set; }
+
+  /// <summary>Gets or sets what publishing does when a command state's message queue is full (default: <see cref="BoundedChannelFullMode.Wait"/>, backpressure).</summary>
+  BoundedChannelFullMode MessageQueueFullMode { get; set; }
+
   /// <summary>Gets the collection of all registered states.</summary>
   /// <remarks>
   ///   Exposed for validations, debugging, etc.
@@ -34,12 +54,27 @@ public interface IStateMachine<TStateId>
   /// </remarks>
   List<TStateId> States { get; }
 
+  /// <summary>Gets or sets the clock timing state and command timeouts, batch lingers and trace timestamps (default: <see cref="TimeProvider.System"/>).</summary>
+  /// <remarks>Use a <see cref="VirtualTimeProvider"/> to advance time by hand in tests and simulations.</remarks>
+  TimeProvider TimeProvider { get; set; }
+
   /// <summary>Preload properties and errors to the context.</summary>
   /// <param name="parameters">Parameter properties to safely add/update.</param>
   /// <param name="errors">Error properties to safely add/update.</param>
   /// <returns>Instance of this class.</returns>
   StateMachine<TStateId> AddContext(PropertyBag? parameters = null, PropertyBag? errors = null);
 
+  /// <summary>
+  ///   Compiles the registered states into a dense, array-indexed transition table used by <see cref="RunAsync"/>.
+  ///   Called automatically on the next run when registrations have changed; call it up-front to move the one-time cost out of the first run.
+  /// </summary>
+  /// <returns>Instance of this class.</returns>
+  StateMachine<TStateId> Build();
+
+  /// <summary>Gets the immutable, compiled definition of the registered states, building it if needed.</summary>
+  /// <returns>Definition to start any number of concurrent <see cref="StateMachineRun{TStateId}"/> from.</returns>
+  StateMachineDefinition<TStateId> BuildDefinition();
+
   /// <summary>
   /// Registers a top-level composite parent state (has no parent state) and explicitly sets:
   /// - the initial child (initialChildStateId).
@@ -52,7 +87,7 @@ public interface IStateMachine<TStateId>
   /// <param name="onFailure">Optional transition to next state on failure.</param>
   /// <returns>State machine instance.</returns>
   /// <typeparam name="TCompositeParent">Composite State Class.</typeparam>
-  StateMachine<TStateId> RegisterComposite<TCompositeParent>(TStateId stateId, TStateId initialChildStateId, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null)
+  StateMachine<TStateId> RegisterComposite<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TCompositeParent>(TStateId stateId, TStateId initialChildStateId, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null)
     where TCompositeParent : class, IState<TStateId>;
 
   /// <summary>Nested composite (child composite under a parent composite).</summary>
@@ -64,7 +99,38 @@ public interface IStateMachine<TStateId>
   /// <param name="onFailure">Optional transition to next state on failure.</param>
   /// <returns>State machine instance.</returns>
   /// <typeparam name="TCompositeParent">Composite State Class.</typeparam>
-  StateMachine<TStateId> RegisterSubComposite<TCompositeParent>(TStateId stateId, TStateId parentStateId, TStateId initialChildStateId, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null)
+  StateMachine<TStateId> RegisterSubComposite<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TCompositeParent>(TStateId stateId, TStateId parentStateId, TStateId initialChildStateId, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null)
+    where TCompositeParent : class, IState<TStateId>;
+
+  /// <summary>
+  /// Registers a parallel composite whose regions, each a chain of sub-states starting at its own initial child, run concurrently.
+  /// Each region gets its own context overlay, merged back (in region order) before the parent's OnExit, which sees every region's
+  /// outcome in <see cref="Context{TStateId}.RegionResults"/>.
+  /// </summary>
+  /// <param name="stateId">State identifier.</param>
+  /// <param name="regionInitialChildStateIds">Initial child of each region; a region is the sub-states reachable from it.</param>
+  /// <param name="joinPolicy">How the regions are joined.</param>
+  /// <param name="onSuccess">Transition to next state on success, or NULL if last state to exit <see cref="StateMachine{TStateId}"/>.</param>
+  /// <param name="onError">Optional transition to next state on error.</param>
+  /// <param name="onFailure">Optional transition to next state on failure.</param>
+  /// <param name="parentStateId">Optional parent composite, when nested.</param>
+  /// <returns>State machine instance.</returns>
+  /// <typeparam name="TCompositeParent">Composite State Class.</typeparam>
+  StateMachine<TStateId> RegisterParallelComposite<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TCompositeParent>(TStateId stateId, IReadOnlyList<TStateId> regionInitialChildStateIds, JoinPolicy joinPolicy = JoinPolicy.All, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null, TStateId? parentStateId = null)
+    where TCompositeParent : class, IState<TStateId>;
+
+  /// <summary>Registers a parallel composite created by a pre-bound factory instead of the container (i.e. from the <c>[GeneratedStateMachine]</c> source generator).</summary>
+  /// <param name="factory">Composite state factory.</param>
+  /// <param name="stateId">State identifier.</param>
+  /// <param name="regionInitialChildStateIds">Initial child of each region; a region is the sub-states reachable from it.</param>
+  /// <param name="joinPolicy">How the regions are joined.</param>
+  /// <param name="onSuccess">Transition to next state on success, or NULL if last state to exit <see cref="StateMachine{TStateId}"/>.</param>
+  /// <param name="onError">Optional transition to next state on error.</param>
+  /// <param name="onFailure">Optional transition to next state on failure.</param>
+  /// <param name="parentStateId">Optional parent composite, when nested.</param>
+  /// <returns>State machine instance.</returns>
+  /// <typeparam name="TCompositeParent">Composite State Class.</typeparam>
+  StateMachine<TStateId> RegisterParallelComposite<TCompositeParent>(Func<TCompositeParent> factory, TStateId stateId, IReadOnlyList<TStateId> regionInitialChildStateIds, JoinPolicy joinPolicy = JoinPolicy.All, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null, TStateId? parentStateId = null)
     where TCompositeParent : class, IState<TStateId>;
 
   /// <summary>Registers a regular or command state (optionally with transitions).</summary>
@@ -73,10 +139,11 @@ public interface IStateMachine<TStateId>
   /// <param name="onError">State Id to transition to on error, or null to denote last state and exit <see cref="StateMachine{TStateId}"/>.</param>
   /// <param name="onFailure">State Id to transition to on failure, or null to denote last state and exit <see cref="StateMachine{TStateId}"/>.</param>
   /// <param name="commandSubscriptionTypes">Optional <see cref="ICommandState{TStateId}"/> subscription message types.</param>
+  /// <param name="lifetime">State instance lifetime (default: <see cref="StateLifetime.Singleton"/>).</param>
   /// <returns>Instance of this class.</returns>
   /// <typeparam name="TState">State class.</typeparam>
   /// <remarks>Example: <![CDATA[RegisterState<T>(StateId.State1, StateId.State2);]]>.</remarks>
-  StateMachine<TStateId> RegisterState<TState>(TStateId stateId, TStateId? onSuccess, TStateId? onError, TStateId? onFailure, IReadOnlyCollection<Type>? commandSubscriptionTypes = null)
+  StateMachine<TStateId> RegisterState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TState>(TStateId stateId, TStateId? onSuccess, TStateId? onError, TStateId? onFailure, IReadOnlyCollection<Type>? commandSubscriptionTypes = null, StateLifetime lifetime = StateLifetime.Singleton)
     where TState : class, IState<TStateId>;
 
   /// <summary>
@@ -90,6 +157,7 @@ public interface IStateMachine<TStateId>
   /// <param name="isCompositeParent">true if the registered state is a composite parent state; otherwise, false.</param>
   /// <param name="initialChildStateId">The identifier of the initial child state to activate when entering a composite parent state; otherwise, null.</param>
   /// <param name="commandSubscriptionTypes">Optional <see cref="ICommandState{TStateId}"/> subscription message types.</param>
+  /// <param name="lifetime">State instance lifetime (default: <see cref="StateLifetime.Singleton"/>).</param>
   /// <returns>The current <see cref="StateMachine{TStateId}"/> instance, enabling method chaining.</returns>
   /// <typeparam name="TState">The type of the state to register. Must implement <see cref="IState{TStateId}"/>.</typeparam>
   /// <exception cref="InvalidOperationException">Thrown if a state with the specified stateId is already registered or if the state factory returns null.</exception>
@@ -97,7 +165,24 @@ public interface IStateMachine<TStateId>
   ///   Use this method to add states and define their transitions and hierarchy before starting the
   ///   state machine. Registering duplicate state identifiers is not allowed.
   /// </remarks>
-  StateMachine<TStateId> RegisterState<TState>(TStateId stateId, TStateId? onSuccess, TStateId? onError, TStateId? onFailure, TStateId? parentStateId = null, bool isCompositeParent = false, TStateId? initialChildStateId = null, IReadOnlyCollection<Type>? commandSubscriptionTypes = null)
+  StateMachine<TStateId> RegisterState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TState>(TStateId stateId, TStateId? onSuccess, TStateId? onError, TStateId? onFailure, TStateId? parentStateId = null, bool isCompositeParent = false, TStateId? initialChildStateId = null, IReadOnlyCollection<Type>? commandSubscriptionTypes = null, StateLifetime lifetime = StateLifetime.Singleton)
+    where TState : class, IState<TStateId>;
+
+  /// <summary>Registers a state created by a pre-bound factory instead of the container (i.e. from the <c>[GeneratedStateMachine]</c> source generator).</summary>
+  /// <param name="factory">State factory, called per the <paramref name="lifetime"/>.</param>
+  /// <param name="stateId">The unique identifier for the state to register.</param>
+  /// <param name="onSuccess">The identifier of the state to transition to on success, or null if no transition is defined.</param>
+  /// <param name="onError">The identifier of the state to transition to on error, or null if no transition is defined.</param>
+  /// <param name="onFailure">The identifier of the state to transition to on failure, or null if no transition is defined.</param>
+  /// <param name="parentStateId">The identifier of the parent composite state; otherwise, null.</param>
+  /// <param name="isCompositeParent">true if the registered state is a composite parent state; otherwise, false.</param>
+  /// <param name="initialChildStateId">The identifier of the composite's initial child state; otherwise, null.</param>
+  /// <param name="commandSubscriptionTypes">Optional <see cref="ICommandState{TStateId}"/> subscription message types.</param>
+  /// <param name="lifetime">State instance lifetime (default: <see cref="StateLifetime.Singleton"/>).</param>
+  /// <returns>The current <see cref="StateMachine{TStateId}"/> instance, enabling method chaining.</returns>
+  /// <typeparam name="TState">The type of the state to register.</typeparam>
+  /// <remarks>Example: <![CDATA[RegisterState(static () => new State1(), StateId.State1, StateId.State2, null, null);]]>.</remarks>
+  StateMachine<TStateId> RegisterState<TState>(Func<TState> factory, TStateId stateId, TStateId? onSuccess, TStateId? onError, TStateId? onFailure, TStateId? parentStateId = null, bool isCompositeParent = false, TStateId? initialChildStateId = null, IReadOnlyCollection<Type>? commandSubscriptionTypes = null, StateLifetime lifetime = StateLifetime.Singleton)
     where TState : class, IState<TStateId>;
 
   /// <summary>
@@ -111,14 +196,45 @@ public interface IStateMachine<TStateId>
   /// <param name="onError">The identifier of the state to transition to when the registered state encounters an error, or null if no transition is defined.</param>
   /// <param name="onFailure">The identifier of the state to transition to when the registered state fails, or null if no transition is defined.</param>
   /// <param name="commandSubscriptionTypes">Optional <see cref="ICommandState{TStateId}"/> subscription message types.</param>
+  /// <param name="lifetime">State instance lifetime (default: <see cref="StateLifetime.Singleton"/>).</param>
   /// <returns>The current <see cref="StateMachine{TStateId}"/> instance, enabling method chaining.</returns>
-  StateMachine<TStateId> RegisterSubState<TChildClass>(TStateId stateId, TStateId parentStateId, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null, IReadOnlyCollection<Type>? commandSubscriptionTypes = null)
+  StateMachine<TStateId> RegisterSubState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TChildClass>(TStateId stateId, TStateId parentStateId, TStateId? onSuccess = null, TStateId? onError = null, TStateId? onFailure = null, IReadOnlyCollection<Type>? commandSubscriptionTypes = null, StateLifetime lifetime = StateLifetime.Singleton)
     where TChildClass : class, IState<TStateId>;
 
+  /// <summary>Resumes the machine from a checkpoint written by <see cref="WriteCheckpoint(IBufferWriter{byte}, IContextSerializer)"/>, e.g. after a process restart.</summary>
+  /// <param name="checkpoint">Checkpoint bytes.</param>
+  /// <param name="serializer">Serializer for the context, or NULL to keep the current context as-is.</param>
+  /// <param name="cancellationToken">Cancellation Token.</param>
+  /// <returns>Async task of The current <see cref="StateMachine{TStateId}"/> instance, enabling method chaining.</returns>
+  /// <remarks>The checkpointed state is entered again, with its composite parents re-entered at it instead of their initial child.</remarks>
+  /// <exception cref="InvalidCheckpointException">Thrown if the checkpoint is corrupt or doesn't match the registered states.</exception>
+  Task<StateMachine<TStateId>> ResumeAsync(ReadOnlyMemory<byte> checkpoint, IContextSerializer? serializer = null, CancellationToken cancellationToken = default);
+
+  /// <inheritdoc cref="ResumeAsync(ReadOnlyMemory{byte}, IContextSerializer, CancellationToken)"/>
+  Task<StateMachine<TStateId>> ResumeAsync(Stream checkpoint, IContextSerializer? serializer = null, CancellationToken cancellationToken = default);
+
   /// <summary>Starts the machine at the initial state.</summary>
   /// <param name="initialState">Initial startup state.</param>
   /// <param name="cancellationToken">Cancellation Token.</param>
   /// <returns>Async task of The current <see cref="StateMachine{TStateId}"/> instance, enabling method chaining.</returns>
   /// <exception cref="InvalidOperationException">Thrown if the specified state identifier has not been registered.</exception>
   Task<StateMachine<TStateId>> RunAsync(TStateId initialState, CancellationToken cancellationToken = default);
+
+  /// <summary>
+  ///   Pre-instantiate states (and their DI graphs) and run their <see cref="IWarmable.WarmUpAsync"/>,
+  ///   so the first run's transitions cost the same as steady-state ones.
+  /// </summary>
+  /// <param name="options">Warm-up options, or NULL to warm all states, sequentially.</param>
+  /// <param name="cancellationToken">Cancellation Token.</param>
+  /// <returns>Async task of The current <see cref="StateMachine{TStateId}"/> instance, enabling method chaining.</returns>
+  Task<StateMachine<TStateId>> WarmUpAsync(WarmUpOptions<TStateId>? options = null, CancellationToken cancellationToken = default);
+
+  /// <summary>Writes a compact binary checkpoint of the current position (composite stack, state, previous states), <c>NextStates</c> overrides and context.</summary>
+  /// <param name="writer">Destination.</param>
+  /// <param name="serializer">Serializer for the context's parameters and errors, or NULL to leave the context out.</param>
+  /// <remarks>Cheap enough to take on every transition, i.e. from <see cref="StateMachine{TStateId}.CheckpointHandler"/>.</remarks>
+  void WriteCheckpoint(IBufferWriter<byte> writer, IContextSerializer? serializer = null);
+
+  /// <inheritdoc cref="WriteCheckpoint(IBufferWriter{byte}, IContextSerializer)"/>
+  void WriteCheckpoint(Stream writer, IContextSerializer? serializer = null);
 }
@@ -0,0 +1,30 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary><see cref="ValueTask"/> based command-state: receives messages from subscriptions and can timeout.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+public interface IValueCommandState<TStateId> : ICommandState<TStateId>, IValueState<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Receives a message from the event aggregator.</summary>
+  /// <param name="context">State context.</param>
+  /// <param name="message">Message object.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  new ValueTask OnMessage(Context<TStateId> context, object message);
+
+  /// <summary>Fires when no messages are received within the timeout window.</summary>
+  /// <param name="context">State context.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  new ValueTask OnTimeout(Context<TStateId> context);
+
+  /// <inheritdoc/>
+  Task ICommandState<TStateId>.OnMessage(Context<TStateId> context, object message) => OnMessage(context, message).AsTask();
+
+  /// <inheritdoc/>
+  Task ICommandState<TStateId>.OnTimeout(Context<TStateId> context) => OnTimeout(context).AsTask();
+}
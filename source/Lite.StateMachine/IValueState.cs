@@ -0,0 +1,41 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary><see cref="ValueTask"/> based state for high-frequency machines; avoids a <see cref="Task"/> per transition hook.</summary>
+/// <typeparam name="TStateId">Type of state.</typeparam>
+/// <remarks>
+///   The state machine dispatches directly to the <see cref="ValueTask"/> hooks.
+///   The <see cref="IState{TStateId}"/> hooks are implemented for you and only used by callers outside of the state machine.
+/// </remarks>
+public interface IValueState<TStateId> : IState<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Transition hook state fully entered.</summary>
+  /// <param name="context"><see cref="Context{TState}"/>.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  new ValueTask OnEnter(Context<TStateId> context);
+
+  /// <summary>Transition hook before entering, initialize items needed by the state.</summary>
+  /// <param name="context"><see cref="Context{TState}"/>.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  new ValueTask OnEntering(Context<TStateId> context);
+
+  /// <summary>Transition hook leaving state.</summary>
+  /// <param name="context"><see cref="Context{TState}"/>.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  new ValueTask OnExit(Context<TStateId> context);
+
+  /// <inheritdoc/>
+  Task IState<TStateId>.OnEnter(Context<TStateId> context) => OnEnter(context).AsTask();
+
+  /// <inheritdoc/>
+  Task IState<TStateId>.OnEntering(Context<TStateId> context) => OnEntering(context).AsTask();
+
+  /// <inheritdoc/>
+  Task IState<TStateId>.OnExit(Context<TStateId> context) => OnExit(context).AsTask();
+}
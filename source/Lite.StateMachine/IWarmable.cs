@@ -0,0 +1,16 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>State with one-time preparation (pre-allocating buffers, opening connections, etc.) run by <c>WarmUpAsync</c>.</summary>
+public interface IWarmable
+{
+  /// <summary>Prepare the state before its first entry.</summary>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  Task WarmUpAsync(CancellationToken cancellationToken);
+}
@@ -0,0 +1,71 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Counts OnMessage calls running on publisher threads, so a command state isn't released while one is still in it.</summary>
+/// <remarks>
+///   Lock-free; the count and a closed flag share one field, so a handler either enters before <see cref="CloseAsync"/>
+///   (and is waited for) or is turned away. Reusable across entries with <see cref="Open"/>.
+/// </remarks>
+internal sealed class InFlightMessages
+{
+  private const int ClosedFlag = 1 << 30;
+
+  /// <summary>Completed by the last handler out after closing; only allocated if one was still running.</summary>
+  private TaskCompletionSource? _drained;
+
+  /// <summary>Handlers in flight, plus <see cref="ClosedFlag"/> once closed.</summary>
+  private int _state;
+
+  /// <summary>Stop admitting handlers and wait for those in flight.</summary>
+  /// <returns>Task completing once no handler is running.</returns>
+  public Task CloseAsync()
+  {
+    if ((Interlocked.Or(ref _state, ClosedFlag) | ClosedFlag) == ClosedFlag)
+      return Task.CompletedTask;
+
+    Interlocked.CompareExchange(ref _drained, new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously), null);
+    var drained = _drained!;
+
+    // The last handler may have left before the source was published
+    if (Volatile.Read(ref _state) == ClosedFlag)
+      drained.TrySetResult();
+
+    return drained.Task;
+  }
+
+  /// <summary>Leave after <see cref="TryEnter"/> returned true.</summary>
+  public void Exit()
+  {
+    if (Interlocked.Decrement(ref _state) == ClosedFlag)
+      Volatile.Read(ref _drained)?.TrySetResult();
+  }
+
+  /// <summary>Admit handlers again for the next entry; only after <see cref="CloseAsync"/> completed.</summary>
+  public void Open()
+  {
+    _drained = null;
+    Volatile.Write(ref _state, 0);
+  }
+
+  /// <summary>Enter a handler, unless closed.</summary>
+  /// <returns>True if admitted; call <see cref="Exit"/> when it finishes.</returns>
+  public bool TryEnter()
+  {
+    var state = Volatile.Read(ref _state);
+    while ((state & ClosedFlag) == 0)
+    {
+      var previous = Interlocked.CompareExchange(ref _state, state + 1, state);
+      if (previous == state)
+        return true;
+
+      state = previous;
+    }
+
+    return false;
+  }
+}
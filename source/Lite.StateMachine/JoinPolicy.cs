@@ -0,0 +1,17 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+namespace Lite.StateMachine;
+
+/// <summary>How a parallel composite joins its regions before its OnExit.</summary>
+public enum JoinPolicy
+{
+  /// <summary>Wait for every region; <see cref="Context{TStateId}.LastChildResult"/> is the first non-success region result (in region order), else success (default).</summary>
+  All,
+
+  /// <summary>Wait for every region, but cancel the rest as soon as one ends with error or failure; that result is reported.</summary>
+  FailFast,
+
+  /// <summary>The first region to finish wins, the rest are cancelled; its result is reported.</summary>
+  Any,
+}
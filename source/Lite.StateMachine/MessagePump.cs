@@ -0,0 +1,222 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Channels;
+using System.Threading.Tasks;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine;
+
+/// <summary>Per-state message queue with a single consumer, so publishers only enqueue.</summary>
+/// <remarks>
+///   Messages are handled one at a time, in order, off the publisher's thread.
+///   With <see cref="BoundedChannelFullMode.Wait"/> a full queue blocks the publisher (backpressure);
+///   don't publish to your own state from <c>OnMessage</c> in that mode or it can wait on itself.
+/// </remarks>
+internal sealed class MessagePump
+{
+  private readonly Channel<object> _channel;
+  private readonly Task _consumer;
+  private readonly BoundedChannelFullMode _fullMode;
+  private readonly ILogger? _logger;
+  private readonly string _stateName;
+
+  /// <summary>Initializes a new instance of the <see cref="MessagePump"/> class and starts its consumer.</summary>
+  /// <param name="capacity">Maximum queued messages.</param>
+  /// <param name="fullMode">Full queue policy.</param>
+  /// <param name="handler">Message handler (exceptions are logged and swallowed).</param>
+  /// <param name="logger">Logger of handler exceptions, or NULL.</param>
+  /// <param name="stateName">Cached state name.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  public MessagePump(
+    int capacity,
+    BoundedChannelFullMode fullMode,
+    Func<object, ValueTask> handler,
+    ILogger? logger,
+    string stateName,
+    CancellationToken cancellationToken)
+  {
+    _fullMode = fullMode;
+    _logger = logger;
+    _stateName = stateName;
+    _channel = CreateChannel(capacity, fullMode);
+    _consumer = Task.Run(() => ConsumeAsync(handler, cancellationToken), CancellationToken.None);
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="MessagePump"/> class and starts its batching consumer.</summary>
+  /// <param name="capacity">Maximum queued messages, or 0 for unbounded.</param>
+  /// <param name="fullMode">Full queue policy.</param>
+  /// <param name="maxBatchSize">Maximum messages per batch.</param>
+  /// <param name="maxLingerMs">Maximum time to wait for a batch to fill.</param>
+  /// <param name="batchHandler">Batch handler (exceptions are logged and swallowed); the batch is only valid until it completes.</param>
+  /// <param name="timeProvider">Clock timing the linger.</param>
+  /// <param name="logger">Logger of handler exceptions, or NULL.</param>
+  /// <param name="stateName">Cached state name.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  public MessagePump(
+    int capacity,
+    BoundedChannelFullMode fullMode,
+    int maxBatchSize,
+    int maxLingerMs,
+    Func<ReadOnlyMemory<object>, ValueTask> batchHandler,
+    TimeProvider timeProvider,
+    ILogger? logger,
+    string stateName,
+    CancellationToken cancellationToken)
+  {
+    _fullMode = fullMode;
+    _logger = logger;
+    _stateName = stateName;
+    _channel = CreateChannel(capacity, fullMode);
+    _consumer = Task.Run(() => ConsumeBatchAsync(Math.Max(1, maxBatchSize), maxLingerMs, batchHandler, timeProvider, cancellationToken), CancellationToken.None);
+  }
+
+  /// <summary>Stop accepting messages and wait for the consumer to finish the message in progress.</summary>
+  /// <returns>Consumer task; never faults.</returns>
+  public Task CompleteAsync()
+  {
+    _channel.Writer.TryComplete();
+    return _consumer;
+  }
+
+  /// <summary>Queue a message; applies the full-queue policy.</summary>
+  /// <param name="message">Message object.</param>
+  public void Enqueue(object message)
+  {
+    // Drop modes always accept, discarding per policy
+    if (_channel.Writer.TryWrite(message) || _fullMode != BoundedChannelFullMode.Wait)
+      return;
+
+    try
+    {
+      _channel.Writer.WriteAsync(message).AsTask().GetAwaiter().GetResult();
+    }
+    catch (ChannelClosedException)
+    {
+      // State exited while waiting; message is no longer wanted.
+    }
+  }
+
+  private static Channel<object> CreateChannel(int capacity, BoundedChannelFullMode fullMode)
+  {
+    if (capacity <= 0)
+      return Channel.CreateUnbounded<object>(new UnboundedChannelOptions { SingleReader = true, SingleWriter = false });
+
+    return Channel.CreateBounded<object>(new BoundedChannelOptions(capacity)
+    {
+      FullMode = fullMode,
+      SingleReader = true,
+      SingleWriter = false,
+    });
+  }
+
+  private async Task ConsumeAsync(Func<object, ValueTask> handler, CancellationToken cancellationToken)
+  {
+    var reader = _channel.Reader;
+
+    try
+    {
+      while (await reader.WaitToReadAsync(cancellationToken).ConfigureAwait(false))
+      {
+        if (StateMachineTelemetry.QueueDepth.Enabled && reader.CanCount)
+          StateMachineTelemetry.QueueDepth.Record(reader.Count, new KeyValuePair<string, object?>(StateMachineTelemetry.StateTag, _stateName));
+
+        while (reader.TryRead(out var message))
+        {
+#pragma warning disable SA1501 // Statement should not be on a single line
+          // Log and swallow to keep the pump alive
+          try { await handler(message).ConfigureAwait(false); }
+          catch (Exception ex) { StateMachineLog.OnMessageFaulted(_logger, ex, _stateName, message); }
+#pragma warning restore SA1501 // Statement should not be on a single line
+        }
+      }
+    }
+    catch (OperationCanceledException)
+    {
+      // Expected exception; swallow it.
+    }
+  }
+
+  private async Task ConsumeBatchAsync(
+    int maxBatchSize,
+    int maxLingerMs,
+    Func<ReadOnlyMemory<object>, ValueTask> batchHandler,
+    TimeProvider timeProvider,
+    CancellationToken cancellationToken)
+  {
+    var reader = _channel.Reader;
+    var batch = new object[maxBatchSize];
+    CancellationTokenSource? lingerCts = null;
+    CancellationTokenRegistration lingerLink = default;
+
+    try
+    {
+      while (await reader.WaitToReadAsync(cancellationToken).ConfigureAwait(false))
+      {
+        if (StateMachineTelemetry.QueueDepth.Enabled && reader.CanCount)
+          StateMachineTelemetry.QueueDepth.Record(reader.Count, new KeyValuePair<string, object?>(StateMachineTelemetry.StateTag, _stateName));
+
+        var count = 0;
+        while (count < maxBatchSize && reader.TryRead(out var message))
+          batch[count++] = message;
+
+        // Optionally give the batch a moment to fill
+        if (count < maxBatchSize && maxLingerMs > 0)
+        {
+          // NOTE: Created on the run's clock (so CancelAfter is too), then linked to the state's token by hand.
+          if (lingerCts is null)
+          {
+            lingerCts = new CancellationTokenSource(Timeout.InfiniteTimeSpan, timeProvider);
+            lingerLink = cancellationToken.UnsafeRegister(static s => ((CancellationTokenSource)s!).Cancel(), lingerCts);
+          }
+
+          lingerCts.CancelAfter(maxLingerMs);
+
+          try
+          {
+            while (count < maxBatchSize && await reader.WaitToReadAsync(lingerCts.Token).ConfigureAwait(false))
+            {
+              while (count < maxBatchSize && reader.TryRead(out var message))
+                batch[count++] = message;
+            }
+          }
+          catch (OperationCanceledException) when (!cancellationToken.IsCancellationRequested)
+          {
+            // Linger elapsed; deliver what we have.
+          }
+
+          if (!lingerCts.TryReset())
+          {
+            lingerLink.Dispose();
+            lingerCts.Dispose();
+            lingerCts = null;
+          }
+        }
+
+        if (count == 0)
+          continue;
+
+#pragma warning disable SA1501 // Statement should not be on a single line
+        // Log and swallow to keep the pump alive
+        try { await batchHandler(new ReadOnlyMemory<object>(batch, 0, count)).ConfigureAwait(false); }
+        catch (Exception ex) { StateMachineLog.OnMessageFaulted(_logger, ex, _stateName, null); }
+#pragma warning restore SA1501 // Statement should not be on a single line
+
+        // Don't root delivered messages
+        Array.Clear(batch, 0, count);
+      }
+    }
+    catch (OperationCanceledException)
+    {
+      // Expected exception; swallow it.
+    }
+    finally
+    {
+      lingerLink.Dispose();
+      lingerCts?.Dispose();
+    }
+  }
+}
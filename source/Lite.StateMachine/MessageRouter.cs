@@ -0,0 +1,282 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine;
+
+/// <summary>Routes published messages to whichever command states of a run are active (<see cref="IStateMachine{TStateId}.IsMessageRoutingEnabled"/>).</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   The run subscribes once, as a wildcard; each command state gets one reusable <see cref="Route"/> on first entry,
+///   after which entering and leaving the state only flips its active flag. A route is rebuilt if a new (transient or pooled)
+///   instance subscribes to other message types than the one it was built for.
+///   Message types resolve to the states subscribed to them, their base types or interfaces, once per type (cached).
+/// </remarks>
+internal sealed class MessageRouter<TStateId>
+  where TStateId : struct, Enum
+{
+  private readonly Lock _lockGate = new();
+
+  /// <summary>Node indices of the states accepting each message type.</summary>
+  private readonly ConcurrentDictionary<Type, int[]> _routes = new();
+
+  /// <summary>Command state route per node index, created on first entry.</summary>
+  private readonly Route?[] _slots;
+
+  /// <summary>Initializes a new instance of the <see cref="MessageRouter{TStateId}"/> class.</summary>
+  /// <param name="nodeCount">Number of nodes in the run.</param>
+  public MessageRouter(int nodeCount)
+  {
+    _slots = new Route?[nodeCount];
+    Publish = Dispatch;
+  }
+
+  /// <summary>Gets the run's one subscription handler.</summary>
+  public Action<object> Publish { get; }
+
+  /// <summary>Activate a command state's route for this entry.</summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <param name="reg">State registration.</param>
+  /// <param name="stateName">State name, for logging.</param>
+  /// <param name="cmd">Command state instance.</param>
+  /// <param name="context">State context.</param>
+  /// <param name="entryVersion"><see cref="StateSignal.Version"/> of this state entry.</param>
+  /// <param name="pump">Entry's message pump, or NULL to run OnMessage on the publisher's thread.</param>
+  /// <param name="logger">Logger of OnMessage exceptions, or NULL.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>Active route; deactivate it when leaving the state.</returns>
+  public Route Activate(
+    int index,
+    StateRegistration<TStateId> reg,
+    string stateName,
+    ICommandState<TStateId> cmd,
+    Context<TStateId> context,
+    short entryVersion,
+    MessagePump? pump,
+    ILogger? logger,
+    CancellationToken cancellationToken)
+  {
+    // NOTE: Instances may differ per entry (transient/pooled); their subscriptions can too
+    var subscribed = cmd.SubscribedMessageTypes;
+    var route = Volatile.Read(ref _slots[index]);
+    if (route is null || !route.IsSubscribedTo(reg.SubscribedMessageTypes, subscribed))
+    {
+      route = new Route(MessageTypes(reg.SubscribedMessageTypes, subscribed), subscribed, stateName);
+      lock (_lockGate)
+      {
+        Volatile.Write(ref _slots[index], route);
+
+        // A new state (or subscription) is routable; re-resolve on next publish of each type
+        _routes.Clear();
+      }
+    }
+
+    route.Activate(cmd, context, entryVersion, pump, logger, cancellationToken);
+    return route;
+  }
+
+  /// <summary>Union of registration and instance message types; empty means all messages.</summary>
+  /// <param name="registered">Registration message types.</param>
+  /// <param name="subscribed">Instance message types.</param>
+  /// <returns>Distinct message types.</returns>
+  private static Type[] MessageTypes(IReadOnlyCollection<Type>? registered, IReadOnlyCollection<Type>? subscribed)
+  {
+    var typeSet = new HashSet<Type>();
+    foreach (var type in registered ?? [])
+      typeSet.Add(type);
+
+    foreach (var type in subscribed ?? [])
+      typeSet.Add(type);
+
+    return [.. typeSet];
+  }
+
+  private void Dispatch(object message)
+  {
+    var type = message.GetType();
+    if (!_routes.TryGetValue(type, out var route))
+      route = Resolve(type);
+
+    foreach (var index in route)
+      Volatile.Read(ref _slots[index])!.Deliver(message);
+  }
+
+  private int[] Resolve(Type messageType)
+  {
+    lock (_lockGate)
+    {
+      if (_routes.TryGetValue(messageType, out var route))
+        return route;
+
+      var matches = new List<int>();
+      for (int i = 0; i < _slots.Length; i++)
+      {
+        if (_slots[i]?.Accepts(messageType) == true)
+          matches.Add(i);
+      }
+
+      route = [.. matches];
+      _routes[messageType] = route;
+      return route;
+    }
+  }
+
+  /// <summary>One command state's delivery target, reused across its entries.</summary>
+  internal sealed class Route
+  {
+    private readonly InFlightMessages _inFlight = new();
+    private readonly Type[] _messageTypes;
+    private readonly string _stateName;
+
+    /// <summary>Instance message types the route was built from.</summary>
+    private readonly IReadOnlyCollection<Type>? _subscribed;
+
+    private int _active;
+    private CancellationToken _cancellationToken;
+    private ICommandState<TStateId>? _cmd;
+    private Context<TStateId>? _context;
+    private short _entryVersion;
+    private ILogger? _logger;
+    private MessagePump? _pump;
+
+    /// <summary>Initializes a new instance of the <see cref="Route"/> class.</summary>
+    /// <param name="messageTypes">Accepted message types; empty for all.</param>
+    /// <param name="subscribed">Instance message types, included in <paramref name="messageTypes"/>.</param>
+    /// <param name="stateName">State name, for logging.</param>
+    public Route(Type[] messageTypes, IReadOnlyCollection<Type>? subscribed, string stateName)
+    {
+      _messageTypes = messageTypes;
+      _subscribed = subscribed;
+      _stateName = stateName;
+    }
+
+    /// <summary>Stop delivering to the state and let an in-flight OnMessage finish.</summary>
+    /// <returns>Task completing once no OnMessage of this entry is running.</returns>
+    public Task StopAsync()
+    {
+      Volatile.Write(ref _active, 0);
+      return _inFlight.CloseAsync();
+    }
+
+    /// <summary>Gets whether a message of this runtime type is delivered here.</summary>
+    /// <param name="messageType">Message runtime type.</param>
+    /// <returns>True if subscribed to it, a base type or interface of it, or to all messages.</returns>
+    internal bool Accepts(Type messageType)
+    {
+      if (_messageTypes.Length == 0)
+        return true;
+
+      foreach (var type in _messageTypes)
+      {
+        if (type.IsAssignableFrom(messageType))
+          return true;
+      }
+
+      return false;
+    }
+
+    /// <summary>Gets whether the route accepts exactly the union of these registration and instance message types.</summary>
+    /// <param name="registered">Registration message types.</param>
+    /// <param name="subscribed">Instance message types.</param>
+    /// <returns>True if it can be reused for the instance.</returns>
+    /// <remarks>The same collection (usually a static array, or the same instance) is reused without comparing.</remarks>
+    internal bool IsSubscribedTo(IReadOnlyCollection<Type>? registered, IReadOnlyCollection<Type>? subscribed)
+    {
+      if (ReferenceEquals(subscribed, _subscribed))
+        return true;
+
+      foreach (var type in subscribed ?? [])
+      {
+        if (Array.IndexOf(_messageTypes, type) < 0)
+          return false;
+      }
+
+      // Nothing of the previous instance's left over
+      foreach (var type in _messageTypes)
+      {
+        if (!Contains(registered, type) && !Contains(subscribed, type))
+          return false;
+      }
+
+      return true;
+    }
+
+    /// <summary>Start delivering to the state's entry.</summary>
+    /// <param name="cmd">Command state instance.</param>
+    /// <param name="context">State context.</param>
+    /// <param name="entryVersion">Signal version of this entry.</param>
+    /// <param name="pump">Entry's message pump, if queued.</param>
+    /// <param name="logger">Logger of OnMessage exceptions, or NULL.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    internal void Activate(
+      ICommandState<TStateId> cmd,
+      Context<TStateId> context,
+      short entryVersion,
+      MessagePump? pump,
+      ILogger? logger,
+      CancellationToken cancellationToken)
+    {
+      _cmd = cmd;
+      _context = context;
+      _entryVersion = entryVersion;
+      _logger = logger;
+      _pump = pump;
+      _cancellationToken = cancellationToken;
+      _inFlight.Open();
+      Volatile.Write(ref _active, 1);
+    }
+
+    /// <summary>Deliver a message, if the state is active.</summary>
+    /// <param name="message">Message.</param>
+    internal void Deliver(object message)
+    {
+      if (Volatile.Read(ref _active) == 0)
+        return;
+
+      if (_pump is { } pump)
+      {
+        pump.Enqueue(message);
+        return;
+      }
+
+      // Entered before checking the entry, so leaving the state waits for it or it sees the state is gone
+      if (!_inFlight.TryEnter())
+        return;
+
+      if (_cancellationToken.IsCancellationRequested || !_context!.Signal.IsPending(_entryVersion))
+      {
+        _inFlight.Exit();
+        return;
+      }
+
+      _ = DeliverAsync(_cmd!, _context, message, _logger);
+    }
+
+    private static bool Contains(IReadOnlyCollection<Type>? types, Type type)
+    {
+      foreach (var item in types ?? [])
+      {
+        if (item == type)
+          return true;
+      }
+
+      return false;
+    }
+
+    private async Task DeliverAsync(ICommandState<TStateId> cmd, Context<TStateId> context, object message, ILogger? logger)
+    {
+#pragma warning disable SA1501 // Statement should not be on a single line
+      // Log and swallow to avoid breaking publication loop
+      try { await StateMachineRun<TStateId>.OnMessageAsync(cmd, context, message).ConfigureAwait(false); }
+      catch (Exception ex) { StateMachineLog.OnMessageFaulted(logger, ex, _stateName, message); }
+      finally { _inFlight.Exit(); }
+#pragma warning restore SA1501 // Statement should not be on a single line
+    }
+  }
+}
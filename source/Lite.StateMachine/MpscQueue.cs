@@ -0,0 +1,76 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Threading;
+
+namespace Lite.StateMachine;
+
+/// <summary>Lock-free multi-producer, single-consumer FIFO queue.</summary>
+/// <typeparam name="T">Item type.</typeparam>
+/// <remarks>
+///   Producers push onto a linked stack with one compare-and-swap; the consumer takes the whole stack with one exchange
+///   and reverses it into FIFO order. An empty queue is a single NULL reference, so idle owners cost no memory beyond it.
+/// </remarks>
+internal sealed class MpscQueue<T>
+{
+  /// <summary>Pushed items, newest first; shared with producers.</summary>
+  private Node? _head;
+
+  /// <summary>Taken items, oldest first; consumer only.</summary>
+  private Node? _pending;
+
+  /// <summary>Gets a value indicating whether nothing is queued; exact only on the consumer.</summary>
+  public bool IsEmpty => _pending is null && Volatile.Read(ref _head) is null;
+
+  /// <summary>Queue an item; safe from any thread.</summary>
+  /// <param name="item">Item.</param>
+  public void Enqueue(T item)
+  {
+    var node = new Node(item);
+    Node? head;
+    do
+    {
+      head = Volatile.Read(ref _head);
+      node.Next = head;
+    }
+    while (Interlocked.CompareExchange(ref _head, node, head) != head);
+  }
+
+  /// <summary>Take the oldest item; consumer only.</summary>
+  /// <param name="item">Oldest item.</param>
+  /// <returns>False if empty.</returns>
+  public bool TryDequeue(out T item)
+  {
+    if (_pending is null)
+    {
+      // Reverse the taken stack into FIFO order
+      var taken = Interlocked.Exchange(ref _head, null);
+      while (taken is not null)
+      {
+        var next = taken.Next;
+        taken.Next = _pending;
+        _pending = taken;
+        taken = next;
+      }
+
+      if (_pending is null)
+      {
+        item = default!;
+        return false;
+      }
+    }
+
+    var node = _pending;
+    _pending = node.Next;
+    item = node.Item;
+    return true;
+  }
+
+  private sealed class Node(T item)
+  {
+#pragma warning disable SA1401 // Fields should be private
+    public readonly T Item = item;
+    public Node? Next;
+#pragma warning restore SA1401 // Fields should be private
+  }
+}
@@ -1,23 +1,574 @@
 // Copyright Xeno Innovations, Inc. 2025
 // See the LICENSE file in the project root for more information.
 
+using System;
+using System.Collections;
 using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 
 namespace Lite.StateMachine;
 
 /// <summary>Context parameter stack properties for passing data between states.</summary>
-/// <typeparam name="TKey">TKey is Key.</typeparam>
 /// <remarks>
-///   1) Use thread-safe ConcurrentDictionary
-///   2) In a future release, make the keys only enums for fast execution (2025-12-16 DS).
+///   Enum and primitive keys/values are stored inline (type + raw bits) so the generic members,
+///   <c>Add</c>, <c>Set</c>, <c>SafeAdd</c>, <c>Get</c> and <c>TryGetValue</c>, never box.
+///   The <see cref="IDictionary{TKey, TValue}"/> members remain for mixed/object keys and box on demand (cached per entry).
+///   NOTE: Implements <see cref="IDictionary{TKey, TValue}"/> rather than deriving from <see cref="Dictionary{TKey, TValue}"/> as it used to.
 ///   <![CDATA[
-///     public class PropertyBag<TKey, TValue> : Dictionary<TKey, TValue> where TKey : notnull
+///     context.Parameters.Set(ParameterType.Counter, 1);
+///     var counter = context.Parameters.Get(ParameterType.Counter, 0);
 ///   ]]>
+///   vNext: Use thread-safe ConcurrentDictionary.
 /// </remarks>
-public class PropertyBag : Dictionary<object, object?>
+public class PropertyBag : IDictionary<object, object?>
 {
+  private readonly Dictionary<BagKey, Entry> _entries = [];
+
+  /// <summary>Keys removed while a scope is open that belong to an outer one, with the depth they were added at (lazy-loaded).</summary>
+  /// <remarks>Re-adding one gives it back to the outer scope, so closing the inner scope doesn't remove it.</remarks>
+  private Dictionary<BagKey, int>? _removedKeys;
+
+  /// <summary>Keys added while a scope is open, oldest first (lazy-loaded).</summary>
+  private List<BagKey>? _scopeKeys;
+
+  /// <summary>Start offset into <see cref="_scopeKeys"/> for each open scope (lazy-loaded).</summary>
+  private List<int>? _scopeStarts;
+
+  /// <inheritdoc/>
+  public int Count => _entries.Count;
+
+  /// <inheritdoc/>
+  public bool IsReadOnly => false;
+
+  /// <inheritdoc/>
+  public ICollection<object> Keys
+  {
+    get
+    {
+      var keys = new List<object>(_entries.Count);
+      foreach (var pair in _entries)
+        keys.Add(pair.Value.Key ?? pair.Key.ToObject());
+
+      return keys;
+    }
+  }
+
+  /// <inheritdoc/>
+  public ICollection<object?> Values
+  {
+    get
+    {
+      var values = new List<object?>(_entries.Count);
+      foreach (var pair in _entries)
+        values.Add(pair.Value.ToObject());
+
+      return values;
+    }
+  }
+
+  /// <inheritdoc/>
+  public object? this[object key]
+  {
+    get
+    {
+      ref var entry = ref CollectionsMarshal.GetValueRefOrNullRef(_entries, BagKey.From(key));
+      if (Unsafe.IsNullRef(ref entry))
+        throw new KeyNotFoundException($"The given key '{key}' was not present in the property bag.");
+
+      return entry.GetBoxedValue();
+    }
+
+    set
+    {
+      var bagKey = BagKey.From(key);
+      ref var entry = ref CollectionsMarshal.GetValueRefOrAddDefault(_entries, bagKey, out var exists);
+      var depth = entry.Depth;
+      entry = Entry.FromObject(key, value);
+      if (exists)
+        entry.Depth = depth;
+      else
+        OnAdded(bagKey, ref entry);
+    }
+  }
+
+  /// <inheritdoc/>
+  public void Add(object key, object? value)
+  {
+    var bagKey = BagKey.From(key);
+    ref var entry = ref CollectionsMarshal.GetValueRefOrAddDefault(_entries, bagKey, out var exists);
+    if (exists)
+      throw new ArgumentException($"An item with the same key has already been added. Key: {key}", nameof(key));
+
+    entry = Entry.FromObject(key, value);
+    OnAdded(bagKey, ref entry);
+  }
+
+  /// <summary>Adds the typed key and value without boxing enum or primitive types.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <typeparam name="TValue">Value type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <param name="value">Parameter value.</param>
+  /// <exception cref="ArgumentException">Key already exists.</exception>
+  public void Add<TKey, TValue>(TKey key, TValue value)
+    where TKey : notnull
+  {
+    var bagKey = BagKey.From(key);
+    ref var entry = ref CollectionsMarshal.GetValueRefOrAddDefault(_entries, bagKey, out var exists);
+    if (exists)
+      throw new ArgumentException($"An item with the same key has already been added. Key: {key}", nameof(key));
+
+    entry = Entry.From(value);
+    OnAdded(bagKey, ref entry);
+  }
+
+  /// <inheritdoc/>
+  public void Add(KeyValuePair<object, object?> item) => Add(item.Key, item.Value);
+
+  /// <inheritdoc/>
+  /// <remarks>Open scopes stay open, with nothing left for them to remove.</remarks>
+  public void Clear()
+  {
+    if (ScopeCount > 0)
+    {
+      foreach (var pair in _entries)
+        OnRemoved(pair.Key, pair.Value.Depth);
+    }
+
+    _entries.Clear();
+    if (_scopeKeys is null)
+      return;
+
+    _scopeKeys.Clear();
+    for (int i = 0; i < _scopeStarts!.Count; i++)
+      _scopeStarts[i] = 0;
+  }
+
+  /// <inheritdoc/>
+  public bool Contains(KeyValuePair<object, object?> item) =>
+    TryGetValue(item.Key, out var value) && EqualityComparer<object?>.Default.Equals(value, item.Value);
+
+  /// <inheritdoc/>
+  public bool ContainsKey(object key) => _entries.ContainsKey(BagKey.From(key));
+
+  /// <summary>Determines whether the bag contains the typed key, without boxing.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <returns>True if found.</returns>
+  public bool ContainsKey<TKey>(TKey key)
+    where TKey : notnull => _entries.ContainsKey(BagKey.From(key));
+
+  /// <inheritdoc/>
+  public void CopyTo(KeyValuePair<object, object?>[] array, int arrayIndex)
+  {
+    foreach (var pair in this)
+      array[arrayIndex++] = pair;
+  }
+
+  /// <summary>Gets the typed value or <paramref name="defaultValue"/> when missing or of another type.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <typeparam name="TValue">Value type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <param name="defaultValue">Default value.</param>
+  /// <returns>Parameter value or default.</returns>
+  public TValue Get<TKey, TValue>(TKey key, TValue defaultValue)
+    where TKey : notnull => TryGetValue(key, out TValue value) ? value : defaultValue;
+
+  /// <inheritdoc/>
+  public IEnumerator<KeyValuePair<object, object?>> GetEnumerator()
+  {
+    foreach (var pair in _entries)
+      yield return new KeyValuePair<object, object?>(pair.Value.Key ?? pair.Key.ToObject(), pair.Value.ToObject());
+  }
+
+  /// <inheritdoc/>
+  IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+
+  /// <inheritdoc/>
+  public bool Remove(object key) => RemoveKey(BagKey.From(key));
+
+  /// <summary>Removes the typed key, without boxing.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <returns>True if removed.</returns>
+  public bool Remove<TKey>(TKey key)
+    where TKey : notnull => RemoveKey(BagKey.From(key));
+
+  /// <inheritdoc/>
+  public bool Remove(KeyValuePair<object, object?> item) => Contains(item) && Remove(item.Key);
+
+  /// <summary>Adds or overwrites the parameter.</summary>
+  /// <param name="key">Parameter key.</param>
+  /// <param name="value">Parameter value.</param>
   public void SafeAdd(object key, object? value)
   {
     this[key] = value;
   }
+
+  /// <summary>Adds or overwrites the typed parameter without boxing enum or primitive types.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <typeparam name="TValue">Value type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <param name="value">Parameter value.</param>
+  public void SafeAdd<TKey, TValue>(TKey key, TValue value)
+    where TKey : notnull => Set(key, value);
+
+  /// <summary>Adds or overwrites the typed parameter without boxing enum or primitive types.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <typeparam name="TValue">Value type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <param name="value">Parameter value.</param>
+  public void Set<TKey, TValue>(TKey key, TValue value)
+    where TKey : notnull
+  {
+    var bagKey = BagKey.From(key);
+    ref var entry = ref CollectionsMarshal.GetValueRefOrAddDefault(_entries, bagKey, out var exists);
+    entry.Set(value);
+    if (!exists)
+      OnAdded(bagKey, ref entry);
+  }
+
+  /// <inheritdoc/>
+  public bool TryGetValue(object key, out object? value)
+  {
+    ref var entry = ref CollectionsMarshal.GetValueRefOrNullRef(_entries, BagKey.From(key));
+    if (Unsafe.IsNullRef(ref entry))
+    {
+      value = null;
+      return false;
+    }
+
+    value = entry.GetBoxedValue();
+    return true;
+  }
+
+  /// <summary>Gets the typed value, without boxing enum or primitive types.</summary>
+  /// <typeparam name="TKey">Key type.</typeparam>
+  /// <typeparam name="TValue">Value type.</typeparam>
+  /// <param name="key">Parameter key.</param>
+  /// <param name="value">Parameter value or default.</param>
+  /// <returns>True if the key exists and holds a <typeparamref name="TValue"/> (or NULL, for nullable types).</returns>
+  public bool TryGetValue<TKey, TValue>(TKey key, out TValue value)
+    where TKey : notnull
+  {
+    ref var entry = ref CollectionsMarshal.GetValueRefOrNullRef(_entries, BagKey.From(key));
+    if (!Unsafe.IsNullRef(ref entry))
+    {
+      if (Inline<TValue>.IsInline && entry.ValueType == typeof(TValue))
+      {
+        value = Inline.FromBits<TValue>(entry.ValueBits);
+        return true;
+      }
+
+      var boxed = entry.GetBoxedValue();
+      if (boxed is TValue typed)
+      {
+        value = typed;
+        return true;
+      }
+
+      // NULL is a valid value for reference and nullable types
+      if (boxed is null && default(TValue) is null)
+      {
+        value = default!;
+        return true;
+      }
+    }
+
+    value = default!;
+    return false;
+  }
+
+  /// <summary>Gets the number of scopes open.</summary>
+  internal int ScopeCount => _scopeStarts?.Count ?? 0;
+
+  /// <summary>Forget every open scope, keeping all entries as if added outside of them.</summary>
+  internal void CloseScopes()
+  {
+    if (_scopeStarts is not { Count: > 0 })
+      return;
+
+    foreach (var key in _scopeKeys!)
+    {
+      ref var entry = ref CollectionsMarshal.GetValueRefOrNullRef(_entries, key);
+      if (!Unsafe.IsNullRef(ref entry))
+        entry.Depth = 0;
+    }
+
+    _scopeKeys.Clear();
+    _scopeStarts.Clear();
+    _removedKeys?.Clear();
+  }
+
+  /// <summary>Copy the entries added in one scope, or outside of every scope, into another bag.</summary>
+  /// <param name="scope">Scope token plus one; 0 for the entries added outside of every scope.</param>
+  /// <param name="destination">Bag to copy into, without scopes open.</param>
+  /// <remarks>Used to checkpoint a non-persistent context one scope at a time; one pass over the entries per scope.</remarks>
+  internal void CopyScopeTo(int scope, PropertyBag destination)
+  {
+    foreach (var pair in _entries)
+    {
+      if (pair.Value.Depth != scope)
+        continue;
+
+      var entry = pair.Value;
+      entry.Depth = 0;
+      destination._entries[pair.Key] = entry;
+    }
+  }
+
+  /// <summary>Open a child scope. Keys added from now on are removed when the scope is popped.</summary>
+  /// <returns>Scope token for <see cref="PopScope(int)"/>.</returns>
+  /// <remarks>
+  ///   Used by composites when <see cref="IStateMachine{TStateId}.IsContextPersistent"/> is false.
+  ///   Existing keys are written in place, so changes made by children to them survive the scope;
+  ///   as does one a child removes and adds back, which still belongs to the outer scope.
+  /// </remarks>
+  internal int PushScope()
+  {
+    _scopeKeys ??= [];
+    _scopeStarts ??= [];
+    _scopeStarts.Add(_scopeKeys.Count);
+    return _scopeStarts.Count - 1;
+  }
+
+  /// <summary>Close the scope (and any left open above it), removing the keys added since it was pushed.</summary>
+  /// <param name="scope">Scope token from <see cref="PushScope"/>.</param>
+  /// <remarks>Cost is the number of keys added in the scope, not the size of the bag.</remarks>
+  internal void PopScope(int scope)
+  {
+    if (_scopeStarts is null || scope >= _scopeStarts.Count)
+      return;
+
+    // A key removed and added again is listed twice, and may have been handed back to an outer scope
+    var start = _scopeStarts[scope];
+    for (int i = start; i < _scopeKeys!.Count; i++)
+    {
+      ref var entry = ref CollectionsMarshal.GetValueRefOrNullRef(_entries, _scopeKeys[i]);
+      if (!Unsafe.IsNullRef(ref entry) && entry.Depth > scope)
+        _entries.Remove(_scopeKeys[i]);
+    }
+
+    _scopeKeys.RemoveRange(start, _scopeKeys.Count - start);
+    _scopeStarts.RemoveRange(scope, _scopeStarts.Count - scope);
+
+    if (_removedKeys is { Count: > 0 })
+    {
+      // Only outer scopes still open can take their keys back
+      foreach (var pair in _removedKeys)
+      {
+        if (pair.Value >= scope)
+          _removedKeys.Remove(pair.Key);
+      }
+    }
+  }
+
+  /// <summary>Record the scope depth a new entry was added at.</summary>
+  /// <param name="key">Key added.</param>
+  /// <param name="entry">Its entry.</param>
+  private void OnAdded(BagKey key, ref Entry entry)
+  {
+    if (_scopeStarts is not { Count: > 0 } starts)
+      return;
+
+    if (_removedKeys is not null && _removedKeys.Remove(key, out var depth))
+    {
+      entry.Depth = depth;
+      return;
+    }
+
+    entry.Depth = starts.Count;
+    _scopeKeys!.Add(key);
+  }
+
+  /// <summary>Remember a removed key that belongs to an outer scope.</summary>
+  /// <param name="key">Key removed.</param>
+  /// <param name="depth">Scope depth it was added at.</param>
+  private void OnRemoved(BagKey key, int depth)
+  {
+    if (depth < ScopeCount)
+      (_removedKeys ??= [])[key] = depth;
+  }
+
+  private bool RemoveKey(BagKey key)
+  {
+    if (!_entries.Remove(key, out var entry))
+      return false;
+
+    OnRemoved(key, entry.Depth);
+    return true;
+  }
+
+  /// <summary>Type is stored inline as raw bits (enums and primitives up to 8 bytes).</summary>
+  /// <typeparam name="T">Key or value type.</typeparam>
+  private static class Inline<T>
+  {
+    public static readonly bool IsInline = Inline.IsInlineType(typeof(T));
+  }
+
+  /// <summary>Raw bit conversions for inline keys and values.</summary>
+  private static class Inline
+  {
+    public static T FromBits<T>(long bits) => Unsafe.As<long, T>(ref bits);
+
+    public static bool IsInlineType(Type type) =>
+      type.IsEnum || Type.GetTypeCode(type) is >= TypeCode.Boolean and <= TypeCode.Double;
+
+    /// <summary>Reads the boxed enum/primitive's raw bits, matching <see cref="ToBits{T}(T)"/>.</summary>
+    /// <param name="boxed">Boxed inline type.</param>
+    /// <returns>Raw bits.</returns>
+    public static long ToBits(object boxed) => Type.GetTypeCode(boxed.GetType()) switch
+    {
+      // Unboxing an enum to its underlying type is allowed by the runtime
+      TypeCode.Boolean => ToBits((bool)boxed),
+      TypeCode.Char => ToBits((char)boxed),
+      TypeCode.SByte => ToBits((sbyte)boxed),
+      TypeCode.Byte => ToBits((byte)boxed),
+      TypeCode.Int16 => ToBits((short)boxed),
+      TypeCode.UInt16 => ToBits((ushort)boxed),
+      TypeCode.Int32 => ToBits((int)boxed),
+      TypeCode.UInt32 => ToBits((uint)boxed),
+      TypeCode.Int64 => ToBits((long)boxed),
+      TypeCode.UInt64 => ToBits((ulong)boxed),
+      TypeCode.Single => ToBits((float)boxed),
+      _ => ToBits((double)boxed),
+    };
+
+    /// <summary>Zero-extended raw bits of the value.</summary>
+    /// <typeparam name="T">Inline type.</typeparam>
+    /// <param name="value">Value.</param>
+    /// <returns>Raw bits.</returns>
+    public static long ToBits<T>(T value) => Unsafe.SizeOf<T>() switch
+    {
+      1 => Unsafe.As<T, byte>(ref value),
+      2 => Unsafe.As<T, ushort>(ref value),
+      4 => Unsafe.As<T, uint>(ref value),
+      _ => Unsafe.As<T, long>(ref value),
+    };
+
+    public static object ToObject(Type type, long bits)
+    {
+      if (type.IsEnum)
+        return Enum.ToObject(type, bits);
+
+      return Type.GetTypeCode(type) switch
+      {
+        TypeCode.Boolean => bits != 0,
+        TypeCode.Char => (char)bits,
+        TypeCode.SByte => (sbyte)bits,
+        TypeCode.Byte => (byte)bits,
+        TypeCode.Int16 => (short)bits,
+        TypeCode.UInt16 => (ushort)bits,
+        TypeCode.Int32 => (int)bits,
+        TypeCode.UInt32 => (uint)bits,
+        TypeCode.Int64 => bits,
+        TypeCode.UInt64 => (ulong)bits,
+        TypeCode.Single => BitConverter.Int32BitsToSingle((int)bits),
+        _ => BitConverter.Int64BitsToDouble(bits),
+      };
+    }
+  }
+
+  /// <summary>Inline (type + bits) or object key.</summary>
+  private readonly struct BagKey(Type? type, long bits, object? key) : IEquatable<BagKey>
+  {
+    private readonly long _bits = bits;
+    private readonly object? _key = key;
+    private readonly Type? _type = type;
+
+    public static BagKey From<TKey>(TKey key)
+      where TKey : notnull
+    {
+      if (Inline<TKey>.IsInline)
+        return new BagKey(typeof(TKey), Inline.ToBits(key), null);
+
+      return From((object)key);
+    }
+
+    public static BagKey From(object key)
+    {
+      ArgumentNullException.ThrowIfNull(key);
+
+      var type = key.GetType();
+      return Inline.IsInlineType(type)
+        ? new BagKey(type, Inline.ToBits(key), null)
+        : new BagKey(null, 0, key);
+    }
+
+    public bool Equals(BagKey other) =>
+      _type == other._type && _bits == other._bits && (_type is not null || _key!.Equals(other._key));
+
+    public override bool Equals(object? obj) => obj is BagKey other && Equals(other);
+
+    public override int GetHashCode() => _type is null ? _key!.GetHashCode() : HashCode.Combine(_type, _bits);
+
+    public object ToObject() => _key ?? Inline.ToObject(_type!, _bits);
+  }
+
+  /// <summary>Stored value; inline (type + bits) or object, with the original/boxed key and value cached for the object API.</summary>
+  private struct Entry
+  {
+#pragma warning disable SA1401 // Fields should be private
+
+    /// <summary>Number of scopes open when the key was added; 0 outside of every scope.</summary>
+    public int Depth;
+
+    /// <summary>Original key object, when added through the object API.</summary>
+    public object? Key;
+
+    /// <summary>Object value, or the cached box of an inline value.</summary>
+    public object? Value;
+
+    /// <summary>Raw bits of an inline value.</summary>
+    public long ValueBits;
+
+    /// <summary>Type of an inline value; NULL when <see cref="Value"/> is an object value.</summary>
+    public Type? ValueType;
+
+#pragma warning restore SA1401 // Fields should be private
+
+    public static Entry From<TValue>(TValue value)
+    {
+      var entry = default(Entry);
+      entry.Set(value);
+      return entry;
+    }
+
+    public static Entry FromObject(object key, object? value) => new() { Key = key, Value = value };
+
+    /// <summary>Gets the value as an object, caching the box of an inline value.</summary>
+    /// <returns>Value.</returns>
+    public object? GetBoxedValue()
+    {
+      if (ValueType is not null)
+        Value ??= Inline.ToObject(ValueType, ValueBits);
+
+      return Value;
+    }
+
+    public void Set<TValue>(TValue value)
+    {
+      if (Inline<TValue>.IsInline)
+      {
+        var bits = Inline.ToBits(value);
+
+        // Keep the cached box when nothing changed
+        if (ValueType != typeof(TValue) || ValueBits != bits)
+          Value = null;
+
+        ValueType = typeof(TValue);
+        ValueBits = bits;
+      }
+      else
+      {
+        ValueType = null;
+        ValueBits = 0;
+        Value = value;
+      }
+    }
+
+    /// <summary>Gets the value as an object, without caching (safe on a copy).</summary>
+    /// <returns>Value.</returns>
+    public readonly object? ToObject() => ValueType is null ? Value : Value ?? Inline.ToObject(ValueType, ValueBits);
+  }
 }
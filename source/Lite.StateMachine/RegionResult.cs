@@ -0,0 +1,14 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+
+namespace Lite.StateMachine;
+
+/// <summary>Outcome of one region of a parallel composite, passed to the parent's OnExit via <see cref="Context{TStateId}.RegionResults"/>.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <param name="RegionStateId">Region's initial sub-state, identifying the region.</param>
+/// <param name="LastChildStateId">Region's last sub-state entered.</param>
+/// <param name="LastChildResult">Region's last result; NULL if it was cancelled by the <see cref="JoinPolicy"/>.</param>
+public readonly record struct RegionResult<TStateId>(TStateId RegionStateId, TStateId? LastChildStateId, Result? LastChildResult)
+  where TStateId : struct, Enum;
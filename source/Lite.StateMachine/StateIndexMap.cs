@@ -0,0 +1,92 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+namespace Lite.StateMachine;
+
+/// <summary>Maps a <typeparamref name="TStateId"/> to its dense index in the compiled node table.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+/// <remarks>
+///   Contiguous enums (the common case) are resolved with a single array offset using the enum's ordinal value.
+///   Sparse enums (i.e. flags or hand-numbered values) fall back to a dictionary.
+/// </remarks>
+internal sealed class StateIndexMap<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Largest span of enum values we're willing to back with a dense lookup array.</summary>
+  private const int MaxDenseSpan = 4096;
+
+  private readonly int[]? _dense;
+  private readonly long _minValue;
+  private readonly Dictionary<TStateId, int>? _sparse;
+
+  public StateIndexMap(IReadOnlyList<TStateId> stateIds)
+  {
+    if (stateIds.Count == 0)
+    {
+      _dense = [];
+      return;
+    }
+
+    long min = long.MaxValue;
+    long max = long.MinValue;
+    foreach (var id in stateIds)
+    {
+      var value = ToInt64(id);
+      min = Math.Min(min, value);
+      max = Math.Max(max, value);
+    }
+
+    // Unsigned difference, so a span as wide as the whole long range can't overflow
+    var span = unchecked((ulong)max - (ulong)min);
+    if (span < MaxDenseSpan)
+    {
+      _minValue = min;
+      _dense = new int[span + 1];
+      Array.Fill(_dense, StateNode<TStateId>.Unregistered);
+
+      for (int i = 0; i < stateIds.Count; i++)
+        _dense[ToInt64(stateIds[i]) - min] = i;
+    }
+    else
+    {
+      _sparse = new Dictionary<TStateId, int>(stateIds.Count);
+      for (int i = 0; i < stateIds.Count; i++)
+        _sparse[stateIds[i]] = i;
+    }
+  }
+
+  /// <summary>Gets the node index of the state.</summary>
+  /// <param name="stateId">State Id.</param>
+  /// <returns>Node index or <see cref="StateNode{TStateId}.Unregistered"/>.</returns>
+  public int IndexOf(TStateId stateId)
+  {
+    if (_dense is not null)
+    {
+      var offset = (ulong)(ToInt64(stateId) - _minValue);
+      return offset < (ulong)_dense.Length ? _dense[offset] : StateNode<TStateId>.Unregistered;
+    }
+
+    return _sparse!.TryGetValue(stateId, out var index) ? index : StateNode<TStateId>.Unregistered;
+  }
+
+  /// <summary>Gets the node index of an optional state.</summary>
+  /// <param name="stateId">State Id or NULL.</param>
+  /// <returns>Node index, <see cref="StateNode{TStateId}.None"/>, or <see cref="StateNode{TStateId}.Unregistered"/>.</returns>
+  public int IndexOf(TStateId? stateId) =>
+    stateId.HasValue ? IndexOf(stateId.GetValueOrDefault()) : StateNode<TStateId>.None;
+
+  /// <summary>Reads the enum's underlying value without boxing.</summary>
+  /// <param name="stateId">State Id.</param>
+  /// <returns>Underlying enum value.</returns>
+  private static long ToInt64(TStateId stateId) => Unsafe.SizeOf<TStateId>() switch
+  {
+    1 => Unsafe.As<TStateId, sbyte>(ref stateId),
+    2 => Unsafe.As<TStateId, short>(ref stateId),
+    4 => Unsafe.As<TStateId, int>(ref stateId),
+    _ => Unsafe.As<TStateId, long>(ref stateId),
+  };
+}
@@ -0,0 +1,17 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+namespace Lite.StateMachine;
+
+/// <summary>How long a registered state's instance lives.</summary>
+public enum StateLifetime
+{
+  /// <summary>Created on first entry and kept for the life of the run (default).</summary>
+  Singleton,
+
+  /// <summary>Created on every entry and disposed (<see cref="System.IAsyncDisposable"/> or <see cref="System.IDisposable"/>) when the state is left.</summary>
+  Transient,
+
+  /// <summary>Rented on entry and returned when the state is left, shared by all runs of the registration. See <see cref="IResettableState"/>.</summary>
+  Pooled,
+}
@@ -2,8 +2,9 @@
 // See the LICENSE file in the project root for more information.
 
 using System;
+using System.Buffers;
 using System.Collections.Generic;
-using System.Linq;
+using System.IO;
 using System.Text;
 
 namespace Lite.StateMachine;
@@ -15,6 +16,7 @@ namespace Lite.StateMachine;
 ///   * Command state - Rounded Box.
 /// </summary>
 /// <remarks>
+///   Exports are cached until the registrations or export options change, so repeated exports of the same topology only copy text.
 ///   vNext: Custom filled background for state types.
 ///     - Standard: Transparent
 ///     - Command: Yellow.
@@ -48,6 +50,22 @@ public sealed partial class StateMachine<TStateId>
   /// <param name="showParentInitialEdge">Whether to also draw the parent → initial-child edge (green, labeled "initial") for composite parents. Default true.</param>
   /// <returns>DOT text suitable for Graphviz.</returns>
   public string ExportUml(
+    IEnumerable<TStateId>? initialStateIds = null,
+    bool includeLegend = true,
+    IDictionary<Result, string>? transitionColors = null,
+    string parentToChildColor = "Green",
+    string graphName = "StateMachine",
+    bool rankLeftToRight = true,
+    Func<TStateId, string>? nodeLabelSelector = null,
+    string? legendText = null,
+    bool showParentInitialEdge = true) =>
+    GetDotExport(initialStateIds, includeLegend, transitionColors, parentToChildColor, graphName, rankLeftToRight, nodeLabelSelector, legendText, showParentInitialEdge).Text;
+
+  /// <summary>Write the state machine's topology as DOT (Graphviz).</summary>
+  /// <param name="writer">Destination.</param>
+  /// <inheritdoc cref="ExportUml(IEnumerable{TStateId}, bool, IDictionary{Result, string}, string, string, bool, Func{TStateId, string}, string, bool)"/>
+  public void ExportUml(
+    TextWriter writer,
     IEnumerable<TStateId>? initialStateIds = null,
     bool includeLegend = true,
     IDictionary<Result, string>? transitionColors = null,
@@ -58,123 +76,158 @@ public sealed partial class StateMachine<TStateId>
     string? legendText = null,
     bool showParentInitialEdge = true)
   {
-    // Defaults for Result edge colors
-    var colors = new Dictionary<Result, string>
-    {
-      [Result.Success] = "Blue",
-      [Result.Error] = "Yellow",
-      [Result.Failure] = "Red",
-    };
+    ArgumentNullException.ThrowIfNull(writer);
+    writer.Write(GetDotExport(initialStateIds, includeLegend, transitionColors, parentToChildColor, graphName, rankLeftToRight, nodeLabelSelector, legendText, showParentInitialEdge).Text);
+  }
 
-    if (transitionColors != null)
-    {
-      foreach (var kvp in transitionColors)
-        colors[kvp.Key] = kvp.Value ?? colors[kvp.Key];
-    }
+  /// <summary>Write the state machine's topology as UTF-8 DOT (Graphviz).</summary>
+  /// <param name="writer">Destination.</param>
+  /// <inheritdoc cref="ExportUml(IEnumerable{TStateId}, bool, IDictionary{Result, string}, string, string, bool, Func{TStateId, string}, string, bool)"/>
+  public void ExportUml(
+    IBufferWriter<byte> writer,
+    IEnumerable<TStateId>? initialStateIds = null,
+    bool includeLegend = true,
+    IDictionary<Result, string>? transitionColors = null,
+    string parentToChildColor = "Green",
+    string graphName = "StateMachine",
+    bool rankLeftToRight = true,
+    Func<TStateId, string>? nodeLabelSelector = null,
+    string? legendText = null,
+    bool showParentInitialEdge = true)
+  {
+    ArgumentNullException.ThrowIfNull(writer);
+    writer.Write(GetDotExport(initialStateIds, includeLegend, transitionColors, parentToChildColor, graphName, rankLeftToRight, nodeLabelSelector, legendText, showParentInitialEdge).Utf8);
+  }
+
+  /// <summary>Export the state machine's topology as a Mermaid state diagram (<c>stateDiagram-v2</c>).</summary>
+  /// <param name="initialStateIds">Optional entry-point initial state(s) at the top-level.</param>
+  /// <param name="rankLeftToRight">If true, left-to-right layout, else top-to-bottom.</param>
+  /// <param name="nodeLabelSelector">Optional label selector for nodes. Defaults to <c>stateId.ToString()</c>.</param>
+  /// <returns>Mermaid text.</returns>
+  public string ExportMermaid(
+    IEnumerable<TStateId>? initialStateIds = null,
+    bool rankLeftToRight = true,
+    Func<TStateId, string>? nodeLabelSelector = null) =>
+    GetMermaidExport(initialStateIds, rankLeftToRight, nodeLabelSelector).Text;
+
+  /// <summary>Write the state machine's topology as a Mermaid state diagram (<c>stateDiagram-v2</c>).</summary>
+  /// <param name="writer">Destination.</param>
+  /// <inheritdoc cref="ExportMermaid(IEnumerable{TStateId}, bool, Func{TStateId, string})"/>
+  public void ExportMermaid(
+    TextWriter writer,
+    IEnumerable<TStateId>? initialStateIds = null,
+    bool rankLeftToRight = true,
+    Func<TStateId, string>? nodeLabelSelector = null)
+  {
+    ArgumentNullException.ThrowIfNull(writer);
+    writer.Write(GetMermaidExport(initialStateIds, rankLeftToRight, nodeLabelSelector).Text);
+  }
+
+  private static bool IsTerminal(StateRegistration<TStateId> reg) =>
+    reg.OnSuccess is null && reg.OnError is null && reg.OnFailure is null;
 
-    nodeLabelSelector ??= id => id.ToString();
+  private static TStateId[] ToArray(IEnumerable<TStateId>? stateIds) =>
+    stateIds is null ? [] : [.. stateIds];
 
-    var sb = new StringBuilder();
-    sb.AppendLine($"digraph \"{Escape(graphName)}\" {{");
+  private static void WriteDot(TextWriter w, UmlGraph graph, TStateId[] initialRoots, in UmlOptions options)
+  {
+    w.Write("digraph \"");
+    WriteEscaped(w, options.GraphName);
+    w.WriteLine("\" {");
 
     // allow edges into subgraphs
-    sb.AppendLine("  compound=true;");
+    w.WriteLine("  compound=true;");
 
-    if (rankLeftToRight)
-      sb.AppendLine("  rankdir=LR;");
+    if (options.RankLeftToRight)
+      w.WriteLine("  rankdir=LR;");
 
-    sb.AppendLine("  fontsize=12;");
+    w.WriteLine("  fontsize=12;");
 
     // First, define all nodes and cluster composite parents with their children.
-    // Group registrations by ParentId (null = root-level nodes).
-    var regs = _states.Values.ToList();
-
-    // Composite parents + their children
-    foreach (var parent in regs.Where(r => r.IsCompositeParent))
+    var regs = graph.Registrations;
+    for (int i = 0; i < regs.Length; i++)
     {
-      var parentId = parent.StateId;
-      var clusterName = $"cluster_{Escape(parentId.ToString())}";
-      sb.AppendLine($"  subgraph {clusterName} {{");
-      sb.AppendLine($"    label=\"{Escape(nodeLabelSelector(parentId))}\";");
-      sb.AppendLine($"    style=rounded;");
-      sb.AppendLine($"    color=\"#888888\";");
-
-      // Parent node inside the cluster (rounded rectangle)
-      sb.AppendLine($"    \"{Escape(parentId.ToString())}\" [shape=box, style=rounded, label=\"{Escape(nodeLabelSelector(parentId))}\"];");
-
-      // Child nodes under this parent (rounded rectangles)
-      var children = regs.Where(r => Equals(r.ParentId, parentId)).ToList();
-      foreach (var child in children)
+      var parent = regs[i];
+      if (!parent.IsCompositeParent)
+        continue;
+
+      var parentName = graph.Names[i];
+      w.Write("  subgraph cluster_");
+      WriteEscaped(w, parentName);
+      w.WriteLine(" {");
+      w.Write("    label=\"");
+      WriteEscaped(w, graph.Labels[i]);
+      w.WriteLine("\";");
+      w.WriteLine("    style=rounded;");
+      w.WriteLine("    color=\"#888888\";");
+
+      // Parent and child nodes inside the cluster (rounded rectangles)
+      WriteDotNode(w, "    ", parentName, graph.Labels[i]);
+      foreach (var child in graph.ChildrenOf(i))
+        WriteDotNode(w, "    ", graph.Names[child], graph.Labels[child]);
+
+      // Internal START marker (filled black circle) per region, or for the InitialChildId
+      if (parent.RegionInitialChildIds is { } regionIds)
       {
-        var childId = child.StateId;
-        sb.AppendLine($"    \"{Escape(childId.ToString())}\" [shape=box, style=rounded, label=\"{Escape(nodeLabelSelector(childId))}\"];");
+        for (int r = 0; r < regionIds.Length; r++)
+        {
+          var suffix = "_" + r;
+          WriteDotMarker(w, "    ", "start_", parentName, suffix, isFinal: false);
+          WriteDotEdge(w, "    ", "start_", parentName, suffix, null, regionIds[r].ToString(), "black", "region " + (r + 1));
+        }
       }
-
-      // Internal START marker (filled black circle) if InitialChildId present
-      if (parent.InitialChildId is not null)
+      else if (parent.InitialChildId is not null)
       {
-        var startClusterId = $"start_{Escape(parentId.ToString())}";
-        sb.AppendLine($"    \"{startClusterId}\" [shape=circle, style=filled, fillcolor=\"black\", color=\"black\", label=\"\", width=0.25, height=0.25, fixedsize=true];");
-        sb.AppendLine($"    \"{startClusterId}\" -> \"{Escape(parent.InitialChildId.Value.ToString())}\" [color=\"black\", label=\"start\"];");
+        WriteDotMarker(w, "    ", "start_", parentName, null, isFinal: false);
+        WriteDotEdge(w, "    ", "start_", parentName, null, null, parent.InitialChildId.Value.ToString(), "black", "start");
       }
 
       // Internal final node for the composite cluster (double circle, inner filled black)
-      var finalClusterId = $"final_{Escape(parentId.ToString())}";
-      sb.AppendLine($"    \"{finalClusterId}\" [shape=doublecircle, style=filled, fillcolor=\"black\", color=\"black\", label=\"\", width=0.35, height=0.35, fixedsize=true];");
-
-      sb.AppendLine("  }");
+      WriteDotMarker(w, "    ", "final_", parentName, null, isFinal: true);
+      w.WriteLine("  }");
     }
 
     // NON-COMPOSITE root-level nodes (rounded rectangles)
-    foreach (var reg in regs.Where(r => !r.IsCompositeParent && r.ParentId is null))
+    for (int i = 0; i < regs.Length; i++)
     {
-      var id = reg.StateId;
-      sb.AppendLine($"  \"{Escape(id.ToString())}\" [shape=box, style=rounded, label=\"{Escape(nodeLabelSelector(id))}\"];");
+      if (!regs[i].IsCompositeParent && regs[i].ParentId is null)
+        WriteDotNode(w, "  ", graph.Names[i], graph.Labels[i]);
     }
 
     // Parent → initial child (green edge), optional
-    if (showParentInitialEdge)
+    if (options.ShowParentInitialEdge)
     {
-      foreach (var parent in regs.Where(r => r.IsCompositeParent && r.InitialChildId is not null))
+      for (int i = 0; i < regs.Length; i++)
       {
-        var parentId = parent.StateId;
-        var childId = parent.InitialChildId!.Value;
-        sb.AppendLine($"  \"{Escape(parentId.ToString())}\" -> \"{Escape(childId.ToString())}\" [color=\"{Escape(parentToChildColor)}\", label=\"initial\"];");
+        if (regs[i].IsCompositeParent && regs[i].InitialChildId is { } childId)
+          WriteDotEdge(w, "  ", null, graph.Names[i], null, null, childId.ToString(), options.ParentToChildColor, "initial");
       }
     }
 
     // Result-based transitions (Success, Error, Failure) with labels and color overrides
-    foreach (var reg in regs)
+    for (int i = 0; i < regs.Length; i++)
     {
-      var fromId = reg.StateId;
+      var reg = regs[i];
+      if (reg.OnSuccess is { } onSuccess)
+        WriteDotEdge(w, "  ", null, graph.Names[i], null, null, onSuccess.ToString(), options.SuccessColor, nameof(Result.Success));
 
-      void Emit(Result res, TStateId? toId)
-      {
-        if (toId is null)
-          return;
-
-        var color = colors.TryGetValue(res, out var c) ? c : "Black";
-        var label = res.ToString();
-        sb.AppendLine($"  \"{Escape(fromId.ToString())}\" -> \"{Escape(toId.Value.ToString())}\" [color=\"{Escape(color)}\", label=\"{Escape(label)}\"];");
-      }
+      if (reg.OnError is { } onError)
+        WriteDotEdge(w, "  ", null, graph.Names[i], null, null, onError.ToString(), options.ErrorColor, nameof(Result.Error));
 
-      Emit(Result.Success, reg.OnSuccess);
-      Emit(Result.Error, reg.OnError);
-      Emit(Result.Failure, reg.OnFailure);
+      if (reg.OnFailure is { } onFailure)
+        WriteDotEdge(w, "  ", null, graph.Names[i], null, null, onFailure.ToString(), options.FailureColor, nameof(Result.Failure));
     }
 
-    // LAST SUBSTATES: point to cluster's internal final node
-    foreach (var parent in regs.Where(r => r.IsCompositeParent))
+    // LAST SUBSTATES ("last" child = no outgoing transitions): point to cluster's internal final node
+    for (int i = 0; i < regs.Length; i++)
     {
-      var parentId = parent.StateId;
-      var finalClusterId = $"final_{Escape(parentId.ToString())}";
+      if (!regs[i].IsCompositeParent)
+        continue;
 
-      var children = regs.Where(r => Equals(r.ParentId, parentId)).ToList();
-      foreach (var child in children)
+      foreach (var child in graph.ChildrenOf(i))
       {
-        // "last" child = no outgoing transitions
-        if (IsTerminal(child))
-          sb.AppendLine($"  \"{Escape(child.StateId.ToString())}\" -> \"{finalClusterId}\" [color=\"black\", label=\"final\"];");
+        if (IsTerminal(regs[child]))
+          WriteDotEdge(w, "  ", null, graph.Names[child], null, "final_", graph.Names[i], "black", "final");
       }
     }
 
@@ -185,73 +238,319 @@ public sealed partial class StateMachine<TStateId>
     //  else if (appLicense == License.Demo)  await machine.RunAsync(StateId.EntryDemoState);
     //
     // GLOBAL START marker (filled black circle) → initial top-level states
-    var initialRoots = initialStateIds?.ToList() ?? new List<TStateId>();
-    if (initialRoots.Count > 0)
+    if (initialRoots.Length > 0)
     {
-      var globalStartId = "start_global";
-      sb.AppendLine($"  \"{globalStartId}\" [shape=circle, style=filled, fillcolor=\"black\", color=\"black\", label=\"\", width=0.25, height=0.25, fixedsize=true];");
+      WriteDotMarker(w, "  ", null, "start_global", null, isFinal: false);
       foreach (var init in initialRoots)
-        sb.AppendLine($"  \"{globalStartId}\" -> \"{Escape(init.ToString())}\" [color=\"black\", label=\"start\"];");
+        WriteDotEdge(w, "  ", null, "start_global", null, null, init.ToString(), "black", "start");
     }
 
     // --- LAST TOP-LEVEL STATES: GLOBAL FINAL marker (double circle, inner filled black)
-    var globalFinalId = "final_global";
-    sb.AppendLine($"  \"{globalFinalId}\" [shape=doublecircle, style=filled, fillcolor=\"black\", color=\"black\", label=\"\", width=0.35, height=0.35, fixedsize=true];");
-
-    foreach (var reg in regs.Where(r => r.ParentId is null))
+    WriteDotMarker(w, "  ", null, "final_global", null, isFinal: true);
+    for (int i = 0; i < regs.Length; i++)
     {
-      if (IsTerminal(reg))
-        sb.AppendLine($"  \"{Escape(reg.StateId.ToString())}\" -> \"{globalFinalId}\" [color=\"black\", label=\"final\"];");
+      if (regs[i].ParentId is null && IsTerminal(regs[i]))
+        WriteDotEdge(w, "  ", null, graph.Names[i], null, null, "final_global", "black", "final");
     }
 
     // Optional legend
-    if (includeLegend)
+    if (options.IncludeLegend)
+      WriteDotLegend(w, options);
+
+    w.WriteLine("}");
+  }
+
+  private static void WriteDotEdge(TextWriter w, string indent, string? fromPrefix, string from, string? fromSuffix, string? toPrefix, string to, string color, string label)
+  {
+    w.Write(indent);
+    w.Write('"');
+    w.Write(fromPrefix);
+    WriteEscaped(w, from);
+    w.Write(fromSuffix);
+    w.Write("\" -> \"");
+    w.Write(toPrefix);
+    WriteEscaped(w, to);
+    w.Write("\" [color=\"");
+    WriteEscaped(w, color);
+    w.Write("\", label=\"");
+    WriteEscaped(w, label);
+    w.WriteLine("\"];");
+  }
+
+  private static void WriteDotLegend(TextWriter w, in UmlOptions options)
+  {
+    w.WriteLine("  subgraph cluster_legend {");
+    w.WriteLine("    label=\"Legend\";");
+    w.WriteLine("    style=dashed;");
+    w.WriteLine("    color=\"#BBBBBB\";");
+
+    w.WriteLine("    legend_state [shape=box, style=rounded, label=\"State (rounded rectangle)\"];");
+    w.WriteLine("    legend_start [shape=circle, style=filled, fillcolor=\"black\", label=\"\"];");
+    w.WriteLine("    legend_final [shape=doublecircle, style=filled, fillcolor=\"black\", label=\"\"];");
+
+    w.WriteLine("    legend_start -> legend_state [color=\"black\", label=\"start\"];");
+    WriteLegendEdge(w, "    legend_state -> legend_state_ok   [color=\"", options.SuccessColor, "\",   label=\"Success\"];");
+    WriteLegendEdge(w, "    legend_state -> legend_state_err  [color=\"", options.ErrorColor, "\", label=\"Error\"];");
+    WriteLegendEdge(w, "    legend_state -> legend_state_fail [color=\"", options.FailureColor, "\", label=\"Failure\"];");
+    WriteLegendEdge(w, "    legend_state -> legend_state_init [color=\"", options.ParentToChildColor, "\", label=\"parent → initial child\"];");
+
+    w.WriteLine("    legend_state_ok   [shape=point, label=\"\"];");
+    w.WriteLine("    legend_state_err  [shape=point, label=\"\"];");
+    w.WriteLine("    legend_state_fail [shape=point, label=\"\"];");
+    w.WriteLine("    legend_state_init [shape=point, label=\"\"];");
+
+    var legendBody = options.LegendText ??
+      $"Shapes:\n  • rounded rectangle = State\n  • filled circle = Start\n  • double circle (filled) = Final\n\n" +
+      $"Edge colors:\n  • Success = {options.SuccessColor}\n  • Error = {options.ErrorColor}\n  • Failure = {options.FailureColor}\n  • Parent→Child = {options.ParentToChildColor}\n  • Start/Final edges = black";
+
+    w.Write("    legend_note [shape=note, label=\"");
+    WriteEscaped(w, legendBody);
+    w.WriteLine("\"];");
+    w.WriteLine("  }");
+
+    static void WriteLegendEdge(TextWriter w, string head, string color, string tail)
+    {
+      w.Write(head);
+      WriteEscaped(w, color);
+      w.WriteLine(tail);
+    }
+  }
+
+  private static void WriteDotMarker(TextWriter w, string indent, string? prefix, string id, string? suffix, bool isFinal)
+  {
+    w.Write(indent);
+    w.Write('"');
+    w.Write(prefix);
+    WriteEscaped(w, id);
+    w.Write(suffix);
+    w.WriteLine(isFinal
+      ? "\" [shape=doublecircle, style=filled, fillcolor=\"black\", color=\"black\", label=\"\", width=0.35, height=0.35, fixedsize=true];"
+      : "\" [shape=circle, style=filled, fillcolor=\"black\", color=\"black\", label=\"\", width=0.25, height=0.25, fixedsize=true];");
+  }
+
+  private static void WriteDotNode(TextWriter w, string indent, string id, string label)
+  {
+    w.Write(indent);
+    w.Write('"');
+    WriteEscaped(w, id);
+    w.Write("\" [shape=box, style=rounded, label=\"");
+    WriteEscaped(w, label);
+    w.WriteLine("\"];");
+  }
+
+  /// <summary>Write DOT-escaped text (backslash, quote, newline) without allocating.</summary>
+  private static void WriteEscaped(TextWriter w, ReadOnlySpan<char> text)
+  {
+    while (!text.IsEmpty)
     {
-      sb.AppendLine("  subgraph cluster_legend {");
-      sb.AppendLine("    label=\"Legend\";");
-      sb.AppendLine("    style=dashed;");
-      sb.AppendLine("    color=\"#BBBBBB\";");
-
-      sb.AppendLine("    legend_state [shape=box, style=rounded, label=\"State (rounded rectangle)\"];");
-      sb.AppendLine("    legend_start [shape=circle, style=filled, fillcolor=\"black\", label=\"\"];");
-      sb.AppendLine("    legend_final [shape=doublecircle, style=filled, fillcolor=\"black\", label=\"\"];");
-
-      var legendSuccessColor = Escape(colors[Result.Success]);
-      var legendErrColor = Escape(colors[Result.Error]);
-      var legendFailColor = Escape(colors[Result.Failure]);
-      var legendParentColor = Escape(parentToChildColor);
-
-      sb.AppendLine("    legend_start -> legend_state [color=\"black\", label=\"start\"];");
-      sb.AppendLine($"    legend_state -> legend_state_ok   [color=\"{legendSuccessColor}\",   label=\"Success\"];");
-      sb.AppendLine($"    legend_state -> legend_state_err  [color=\"{legendErrColor}\", label=\"Error\"];");
-      sb.AppendLine($"    legend_state -> legend_state_fail [color=\"{legendFailColor}\", label=\"Failure\"];");
-      sb.AppendLine($"    legend_state -> legend_state_init [color=\"{legendParentColor}\", label=\"parent → initial child\"];");
-
-      sb.AppendLine("    legend_state_ok   [shape=point, label=\"\"];");
-      sb.AppendLine("    legend_state_err  [shape=point, label=\"\"];");
-      sb.AppendLine("    legend_state_fail [shape=point, label=\"\"];");
-      sb.AppendLine("    legend_state_init [shape=point, label=\"\"];");
-
-      var legendBody = legendText ??
-        $"Shapes:\n  • rounded rectangle = State\n  • filled circle = Start\n  • double circle (filled) = Final\n\n" +
-        $"Edge colors:\n  • Success = {colors[Result.Success]}\n  • Error = {colors[Result.Error]}\n  • Failure = {colors[Result.Failure]}\n  • Parent→Child = {parentToChildColor}\n  • Start/Final edges = black";
-
-      sb.AppendLine($"    legend_note [shape=note, label=\"{Escape(legendBody)}\"];");
-      sb.AppendLine("  }");
+      var i = text.IndexOfAny('\\', '"', '\n');
+      if (i < 0)
+      {
+        w.Write(text);
+        return;
+      }
+
+      w.Write(text[..i]);
+      w.Write(text[i] switch
+      {
+        '\\' => "\\\\",
+        '"' => "\\\"",
+        _ => "\\n",
+      });
+
+      text = text[(i + 1)..];
     }
+  }
 
-    sb.AppendLine("}");
-    return sb.ToString();
+  private static void WriteMermaid(TextWriter w, UmlGraph graph, TStateId[] initialRoots, in UmlOptions options)
+  {
+    w.WriteLine("stateDiagram-v2");
+    w.WriteLine(options.RankLeftToRight ? "  direction LR" : "  direction TB");
+    WriteMermaidScope(w, graph, UmlGraph.Root, initialRoots, "  ");
   }
 
-  private static string Escape(string s)
+  /// <summary>Write the states of one scope (root or composite), nesting composites, then its start, transitions and final.</summary>
+  private static void WriteMermaidScope(TextWriter w, UmlGraph graph, int parent, TStateId[] initialRoots, string indent)
   {
-    if (s is null)
-      return string.Empty;
+    var regs = graph.Registrations;
+    var scope = graph.ChildrenOf(parent);
+    foreach (var i in scope)
+    {
+      if (graph.Labels[i] != graph.Names[i])
+        w.WriteLine($"{indent}state \"{graph.Labels[i].Replace("\"", "#quot;")}\" as {graph.Names[i]}");
 
-    return s.Replace("\\", "\\\\").Replace("\"", "\\\"").Replace("\n", "\\n");
+      if (regs[i].IsCompositeParent)
+      {
+        w.WriteLine($"{indent}state {graph.Names[i]} {{");
+        WriteMermaidScope(w, graph, i, [], indent + "  ");
+        w.WriteLine($"{indent}}}");
+      }
+    }
+
+    if (parent == UmlGraph.Root)
+    {
+      foreach (var init in initialRoots)
+        w.WriteLine($"{indent}[*] --> {init}");
+    }
+    else if (regs[parent].RegionInitialChildIds is { } regionIds)
+    {
+      foreach (var regionId in regionIds)
+        w.WriteLine($"{indent}[*] --> {regionId}");
+    }
+    else if (regs[parent].InitialChildId is { } initialChildId)
+    {
+      w.WriteLine($"{indent}[*] --> {initialChildId}");
+    }
+
+    foreach (var i in scope)
+    {
+      var reg = regs[i];
+      if (reg.OnSuccess is { } onSuccess)
+        w.WriteLine($"{indent}{graph.Names[i]} --> {onSuccess} : {nameof(Result.Success)}");
+
+      if (reg.OnError is { } onError)
+        w.WriteLine($"{indent}{graph.Names[i]} --> {onError} : {nameof(Result.Error)}");
+
+      if (reg.OnFailure is { } onFailure)
+        w.WriteLine($"{indent}{graph.Names[i]} --> {onFailure} : {nameof(Result.Failure)}");
+
+      if (IsTerminal(reg))
+        w.WriteLine($"{indent}{graph.Names[i]} --> [*]");
+    }
   }
 
-  private static bool IsTerminal(StateRegistration<TStateId> reg) =>
-    reg.OnSuccess is null && reg.OnError is null && reg.OnFailure is null;
+  private UmlExport GetDotExport(
+    IEnumerable<TStateId>? initialStateIds,
+    bool includeLegend,
+    IDictionary<Result, string>? transitionColors,
+    string parentToChildColor,
+    string graphName,
+    bool rankLeftToRight,
+    Func<TStateId, string>? nodeLabelSelector,
+    string? legendText,
+    bool showParentInitialEdge)
+  {
+    // Defaults for Result edge colors
+    string? success = null, error = null, failure = null;
+    transitionColors?.TryGetValue(Result.Success, out success);
+    transitionColors?.TryGetValue(Result.Error, out error);
+    transitionColors?.TryGetValue(Result.Failure, out failure);
+
+    var options = new UmlOptions(
+      includeLegend,
+      success ?? "Blue",
+      error ?? "Yellow",
+      failure ?? "Red",
+      parentToChildColor,
+      graphName,
+      rankLeftToRight,
+      nodeLabelSelector,
+      legendText,
+      showParentInitialEdge);
+
+    var roots = ToArray(initialStateIds);
+    if (_dotExport is { } cached && cached.Matches(roots, options))
+      return cached;
+
+    var writer = new StringWriter();
+    WriteDot(writer, new UmlGraph(_states.Values, nodeLabelSelector), roots, options);
+    return _dotExport = new UmlExport(roots, options, writer.ToString());
+  }
+
+  private UmlExport GetMermaidExport(IEnumerable<TStateId>? initialStateIds, bool rankLeftToRight, Func<TStateId, string>? nodeLabelSelector)
+  {
+    var options = new UmlOptions(false, string.Empty, string.Empty, string.Empty, string.Empty, string.Empty, rankLeftToRight, nodeLabelSelector, null, false);
+
+    var roots = ToArray(initialStateIds);
+    if (_mermaidExport is { } cached && cached.Matches(roots, options))
+      return cached;
+
+    var writer = new StringWriter();
+    WriteMermaid(writer, new UmlGraph(_states.Values, nodeLabelSelector), roots, options);
+    return _mermaidExport = new UmlExport(roots, options, writer.ToString());
+  }
+
+  /// <summary>Export settings; compared by value (selector by reference) to reuse a cached export.</summary>
+  private readonly record struct UmlOptions(
+    bool IncludeLegend,
+    string SuccessColor,
+    string ErrorColor,
+    string FailureColor,
+    string ParentToChildColor,
+    string GraphName,
+    bool RankLeftToRight,
+    Func<TStateId, string>? NodeLabelSelector,
+    string? LegendText,
+    bool ShowParentInitialEdge);
+
+  /// <summary>Registrations indexed once per export: names, labels and each parent's children, so emitters never search.</summary>
+  private sealed class UmlGraph
+  {
+    /// <summary>Scope of the top-level states.</summary>
+    public const int Root = -1;
+
+    private readonly Dictionary<TStateId, List<int>> _children = [];
+    private readonly List<int> _roots = [];
+
+    public UmlGraph(ICollection<StateRegistration<TStateId>> registrations, Func<TStateId, string>? nodeLabelSelector)
+    {
+      Registrations = new StateRegistration<TStateId>[registrations.Count];
+      registrations.CopyTo(Registrations, 0);
+      Names = new string[Registrations.Length];
+      Labels = new string[Registrations.Length];
+
+      for (int i = 0; i < Registrations.Length; i++)
+      {
+        var reg = Registrations[i];
+        Names[i] = reg.StateId.ToString();
+        Labels[i] = nodeLabelSelector?.Invoke(reg.StateId) ?? Names[i];
+
+        if (reg.ParentId is not { } parentId)
+        {
+          _roots.Add(i);
+        }
+        else
+        {
+          if (!_children.TryGetValue(parentId, out var children))
+            _children[parentId] = children = [];
+
+          children.Add(i);
+        }
+      }
+    }
+
+    public string[] Labels { get; }
+
+    public string[] Names { get; }
+
+    public StateRegistration<TStateId>[] Registrations { get; }
+
+    /// <summary>Indices of a parent's children in registration order, or the top-level states for <see cref="Root"/>.</summary>
+    public List<int> ChildrenOf(int parent) =>
+      parent == Root ? _roots : _children.TryGetValue(Registrations[parent].StateId, out var children) ? children : [];
+  }
+
+  /// <summary>Cached export text (and its UTF-8 bytes, lazily) for one set of options.</summary>
+  private sealed class UmlExport(TStateId[] initialStateIds, UmlOptions options, string text)
+  {
+    private byte[]? _utf8;
+
+    public string Text { get; } = text;
+
+    public byte[] Utf8 => _utf8 ??= Encoding.UTF8.GetBytes(Text);
+
+    public bool Matches(TStateId[] roots, in UmlOptions other)
+    {
+      if (other != options || roots.Length != initialStateIds.Length)
+        return false;
+
+      for (int i = 0; i < roots.Length; i++)
+      {
+        if (!EqualityComparer<TStateId>.Default.Equals(roots[i], initialStateIds[i]))
+          return false;
+      }
+
+      return true;
+    }
+  }
 }
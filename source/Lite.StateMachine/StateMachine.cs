@@ -4,36 +4,58 @@
 namespace Lite.StateMachine;
 
 using System;
+using System.Buffers;
 using System.Collections.Generic;
+using System.Diagnostics.CodeAnalysis;
+using System.IO;
+using System.Reflection;
 using System.Threading;
+using System.Threading.Channels;
 using System.Threading.Tasks;
+using Microsoft.Extensions.Logging;
 
 /// <inheritdoc/>
 public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
   where TStateId : struct, Enum
 {
-  /////// <summary>Adapter so the state machine can use any DI container</summary>
-  /////// <remarks>OLD-4d3: private readonly IServiceResolver? _services;.</remarks>
-
   /// <summary>Optional dependency injection container factory.</summary>
-  private readonly Func<Type, object?> _containerFactory;
+  private readonly Func<Type, object?>? _containerFactory;
 
   /// <summary>Optional local event aggregator.</summary>
   private readonly IEventAggregator? _eventAggregator;
 
-  ////private readonly ILogger<StateMachine<TStateId>>? _logger;
+  /// <summary>Entries added with <see cref="AddContext"/>, re-applied when a checkpoint replaces the context (lazy-loaded).</summary>
+  private PropertyBag? _addedContext;
+
+  /// <summary>Optional logger of transitions, timeouts and swallowed exceptions.</summary>
+  private readonly ILogger<StateMachine<TStateId>>? _logger;
 
-  /// <summary>Active states.</summary>
-  private readonly Dictionary<TStateId, IState<TStateId>> _instances = [];
+  /// <summary>Optional adapter so the state machine can use any DI container, with pre-bound factories.</summary>
+  private readonly IServiceResolver? _services;
 
   /// <summary>States registered with system.</summary>
   private readonly Dictionary<TStateId, StateRegistration<TStateId>> _states = [];
 
+  /// <summary>Compiled definition, NULL until <see cref="Build"/> (or re-registration).</summary>
+  private StateMachineDefinition<TStateId>? _definition;
+
+  /// <summary>Last DOT export, reused until registrations or export options change.</summary>
+  private UmlExport? _dotExport;
+
+  /// <summary>Last Mermaid export, reused until registrations or export options change.</summary>
+  private UmlExport? _mermaidExport;
+
+  /// <summary>Run backing <see cref="RunAsync"/>; keeps state instances and overrides between runs.</summary>
+  private StateMachineRun<TStateId>? _run;
+
+  private TimeProvider _timeProvider = TimeProvider.System;
+
   /// <summary>
   ///   Initializes a new instance of the <see cref="StateMachine{TStateId}"/> class.
   ///   Dependency Injection is optional:
-  ///   - If containerFactory is omitted, states are created with Activator.CreateInstance.
+  ///   - If containerFactory is omitted, states are created through their (cached) parameterless constructor.
   ///   - If provided, it's used to construct state instances via your container.
+  ///   For trimming/Native AOT, prefer the <see cref="IServiceResolver"/> constructor; a Type-based factory can't be analyzed.
   /// </summary>
   /// <param name="containerFactory">Optional DI container factory (remember to register states as Transient).</param>
   /// <param name="eventAggregator">Optional event aggregator for command states.</param>
@@ -42,35 +64,79 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
     Func<Type, object?>? containerFactory = null,
     IEventAggregator? eventAggregator = null,
     bool isContextPersistent = true)
+    : this(logger: null, containerFactory, eventAggregator, isContextPersistent)
+  {
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachine{TStateId}"/> class with a logger.</summary>
+  /// <param name="logger">Logger of transitions (Debug), timeouts and swallowed <c>OnMessage</c> / <c>OnTimeout</c> exceptions; NULL for none.</param>
+  /// <param name="containerFactory">Optional DI container factory (remember to register states as Transient).</param>
+  /// <param name="eventAggregator">Optional event aggregator for command states.</param>
+  /// <param name="isContextPersistent">Is substate-added context persists when returning to the parent.</param>
+  public StateMachine(
+    ILogger<StateMachine<TStateId>>? logger,
+    Func<Type, object?>? containerFactory = null,
+    IEventAggregator? eventAggregator = null,
+    bool isContextPersistent = true)
   {
     // TODO (2025-12-31 DS): Throw "Missing DI Container" exception because there are parameters in a state class's constructor.
     //// Current Exception:
     ////  System.MissingMethodException: 'Cannot dynamically create an instance of type 'Lite.StateMachine.Tests.TestData.CompositeL3DiStates.State1'. Reason: No parameterless constructor defined.'
-    _containerFactory = containerFactory ?? (t => Activator.CreateInstance(t));
+    _containerFactory = containerFactory;
     _eventAggregator = eventAggregator;
+    _logger = logger;
     IsContextPersistent = isContextPersistent;
 
     Context = new Context<TStateId>(
       currentStateId: default,
       nextStates: new StateMap<TStateId> { OnSuccess = null, OnError = null, OnFailure = null },
-      tcs: default!,
       eventAggregator: _eventAggregator);
 
-    // NOTE-1 (2025-12-25):
-    //  * Create Precheck Sanitization:
-    //    * Verify initial states are set for core and all sub-states.
-    //    * Verify any transition exceptions (i.e. DisjointedNextSubStateException)
+    // NOTE-1 (2025-12-25): Precheck sanitization of the topology is done once by StateMachineDefinition.
     //
     //// OLD-4d3, 4bx 'IServiceResolver' container helper:
     ////  public StateMachine(IServiceResolver? services = null, IEventAggregator? eventAggregator = null, ILogger<StateMachine<TStateId>>? logs = null)
     ////  _services = services;
-    ////  _logger = logs;
+  }
+
+  /// <summary>
+  ///   Initializes a new instance of the <see cref="StateMachine{TStateId}"/> class using a DI container adapter.
+  ///   Each registration binds its constructor once through <see cref="IServiceResolver.CreateFactory{T}"/>.
+  /// </summary>
+  /// <param name="services">DI container adapter (i.e. <see cref="Adapters.MsDiResolver"/>).</param>
+  /// <param name="eventAggregator">Optional event aggregator for command states.</param>
+  /// <param name="isContextPersistent">Is substate-added context persists when returning to the parent.</param>
+  public StateMachine(
+    IServiceResolver services,
+    IEventAggregator? eventAggregator = null,
+    bool isContextPersistent = true)
+    : this(services, logger: null, eventAggregator, isContextPersistent)
+  {
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachine{TStateId}"/> class using a DI container adapter and a logger.</summary>
+  /// <param name="services">DI container adapter (i.e. <see cref="Adapters.MsDiResolver"/>).</param>
+  /// <param name="logger">Logger of transitions (Debug), timeouts and swallowed <c>OnMessage</c> / <c>OnTimeout</c> exceptions; NULL for none.</param>
+  /// <param name="eventAggregator">Optional event aggregator for command states.</param>
+  /// <param name="isContextPersistent">Is substate-added context persists when returning to the parent.</param>
+  public StateMachine(
+    IServiceResolver services,
+    ILogger<StateMachine<TStateId>>? logger,
+    IEventAggregator? eventAggregator = null,
+    bool isContextPersistent = true)
+    : this(logger, containerFactory: null, eventAggregator, isContextPersistent)
+  {
+    ArgumentNullException.ThrowIfNull(services);
+    _services = services;
   }
 
   /// <inheritdoc/>
   ////public Context<TStateId> Context { get; private set; } = new Context<TStateId>(default, default, default!, null);
   public Context<TStateId> Context { get; private set; } = default!;
 
+  /// <inheritdoc cref="StateMachineRun{TStateId}.CheckpointHandler"/>
+  public Action<StateMachineRun<TStateId>>? CheckpointHandler { get; set; }
+
   /// <inheritdoc/>
   public int DefaultCommandTimeoutMs { get; set; } = 3000;
 
@@ -80,29 +146,72 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
   /// <inheritdoc/>
   public bool IsContextPersistent { get; set; } = true;
 
+  /// <inheritdoc/>
+  public bool IsMessageRoutingEnabled { get; set; }
+
+  /// <inheritdoc/>
+  public int MessageQueueCapacity { get; set; } = 0;
+
+  /// <inheritdoc/>
+  public BoundedChannelFullMode MessageQueueFullMode { get; set; } = BoundedChannelFullMode.Wait;
+
   /// <inheritdoc/>
   public List<TStateId> States => [.. _states.Keys];
 
+  /// <inheritdoc/>
+  public TimeProvider TimeProvider
+  {
+    get => _timeProvider;
+    set => _timeProvider = value ?? throw new ArgumentNullException(nameof(value));
+  }
+
+  /// <summary>Gets or sets the optional ring buffer recording each completed state; NULL (default) to disable.</summary>
+  public TransitionTrace<TStateId>? Trace { get; set; }
+
   /// <inheritdoc/>
   public StateMachine<TStateId> AddContext(PropertyBag? parameters = null, PropertyBag? errors = null)
   {
     if (parameters is not null)
     {
       foreach (var item in parameters)
+      {
         Context.Parameters.SafeAdd(item.Key, item.Value);
+        (_addedContext ??= []).SafeAdd(item.Key, item.Value);
+      }
     }
 
     if (errors is not null)
     {
       foreach (var item in errors)
+      {
         Context.Parameters.SafeAdd(item.Key, item.Value);
+        (_addedContext ??= []).SafeAdd(item.Key, item.Value);
+      }
     }
 
     return this;
   }
 
   /// <inheritdoc/>
-  public StateMachine<TStateId> RegisterComposite<TCompositeParent>(
+  public StateMachine<TStateId> Build()
+  {
+    _definition = new StateMachineDefinition<TStateId>(_states.Values, _eventAggregator, this, _logger);
+    _run = new StateMachineRun<TStateId>(_definition, Context, _eventAggregator, previous: _run);
+
+    return this;
+  }
+
+  /// <inheritdoc/>
+  public StateMachineDefinition<TStateId> BuildDefinition()
+  {
+    if (_definition is null)
+      Build();
+
+    return _definition!;
+  }
+
+  /// <inheritdoc/>
+  public StateMachine<TStateId> RegisterComposite<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TCompositeParent>(
     TStateId stateId,
     TStateId initialChildStateId,
     TStateId? onSuccess = null,
@@ -125,19 +234,89 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
   }
 
   /// <inheritdoc/>
-  public StateMachine<TStateId> RegisterState<TStateClass>(
+  public StateMachine<TStateId> RegisterParallelComposite<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TCompositeParent>(
     TStateId stateId,
+    IReadOnlyList<TStateId> regionInitialChildStateIds,
+    JoinPolicy joinPolicy = JoinPolicy.All,
     TStateId? onSuccess = null,
     TStateId? onError = null,
     TStateId? onFailure = null,
-    IReadOnlyCollection<Type>? subscriptionTypes = null)
+    TStateId? parentStateId = null)
+    where TCompositeParent : class, IState<TStateId>
+  {
+    ArgumentNullException.ThrowIfNull(regionInitialChildStateIds);
+    if (regionInitialChildStateIds.Count == 0)
+      throw new MissingInitialSubStateException($"Parallel composite '{stateId}' must have at least one region.");
+
+    if (parentStateId is not null && (!_states.TryGetValue(parentStateId.Value, out var pr) || !pr.IsCompositeParent))
+      throw new ParentStateMustBeCompositeException($"Parent state '{parentStateId}' must be registered as a composite state.");
+
+    if (_states.ContainsKey(stateId))
+      throw new DuplicateStateException($"Composite parent '{stateId}' already registered.");
+
+    return AddRegistration(
+      stateId,
+      CreateFactory<TCompositeParent>(),
+      onSuccess,
+      onError,
+      onFailure,
+      parentStateId,
+      isCompositeParent: true,
+      initialChildStateId: regionInitialChildStateIds[0],
+      subscriptionTypes: null,
+      lifetime: StateLifetime.Singleton,
+      regionInitialChildStateIds: [.. regionInitialChildStateIds],
+      joinPolicy: joinPolicy);
+  }
+
+  /// <inheritdoc/>
+  /// <remarks>Only the regions are checked here; <c>[GeneratedStateMachine]</c> validated the rest of the topology at compile time.</remarks>
+  public StateMachine<TStateId> RegisterParallelComposite<TCompositeParent>(
+    Func<TCompositeParent> factory,
+    TStateId stateId,
+    IReadOnlyList<TStateId> regionInitialChildStateIds,
+    JoinPolicy joinPolicy = JoinPolicy.All,
+    TStateId? onSuccess = null,
+    TStateId? onError = null,
+    TStateId? onFailure = null,
+    TStateId? parentStateId = null)
+    where TCompositeParent : class, IState<TStateId>
+  {
+    ArgumentNullException.ThrowIfNull(factory);
+    ArgumentNullException.ThrowIfNull(regionInitialChildStateIds);
+    if (regionInitialChildStateIds.Count == 0)
+      throw new MissingInitialSubStateException($"Parallel composite '{stateId}' must have at least one region.");
+
+    return AddRegistration(
+      stateId,
+      factory,
+      onSuccess,
+      onError,
+      onFailure,
+      parentStateId,
+      isCompositeParent: true,
+      initialChildStateId: regionInitialChildStateIds[0],
+      subscriptionTypes: null,
+      lifetime: StateLifetime.Singleton,
+      regionInitialChildStateIds: [.. regionInitialChildStateIds],
+      joinPolicy: joinPolicy);
+  }
+
+  /// <inheritdoc/>
+  public StateMachine<TStateId> RegisterState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TStateClass>(
+    TStateId stateId,
+    TStateId? onSuccess = null,
+    TStateId? onError = null,
+    TStateId? onFailure = null,
+    IReadOnlyCollection<Type>? subscriptionTypes = null,
+    StateLifetime lifetime = StateLifetime.Singleton)
     where TStateClass : class, IState<TStateId>
   {
-    return RegisterState<TStateClass>(stateId, onSuccess, onError: null, onFailure: null, parentStateId: null, isCompositeParent: false, initialChildStateId: null, subscriptionTypes: subscriptionTypes);
+    return RegisterState<TStateClass>(stateId, onSuccess, onError, onFailure, parentStateId: null, isCompositeParent: false, initialChildStateId: null, subscriptionTypes: subscriptionTypes, lifetime: lifetime);
   }
 
   /// <inheritdoc/>
-  public StateMachine<TStateId> RegisterState<TStateClass>(
+  public StateMachine<TStateId> RegisterState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TStateClass>(
     TStateId stateId,
     TStateId? onSuccess,
     TStateId? onError,
@@ -145,34 +324,33 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
     TStateId? parentStateId = null,
     bool isCompositeParent = false,
     TStateId? initialChildStateId = null,
-    IReadOnlyCollection<Type>? subscriptionTypes = null)
+    IReadOnlyCollection<Type>? subscriptionTypes = null,
+    StateLifetime lifetime = StateLifetime.Singleton)
     where TStateClass : class, IState<TStateId>
   {
-    if (_states.ContainsKey(stateId))
-      throw new DuplicateStateException($"State '{stateId}' already registered.");
-
-    // TODO (2025-12-28 DS): Shouldn't happen. Use custom exception, StateClassNotRegisteredInContainerException
-    var reg = new StateRegistration<TStateId>
-    {
-      StateId = stateId,
-      Factory = () => (IState<TStateId>)(_containerFactory(typeof(TStateClass))
-        ?? throw new InvalidOperationException($"Factory returned null for {typeof(TStateClass).Name}")),
-      ParentId = parentStateId,
-      IsCompositeParent = isCompositeParent,
-      InitialChildId = initialChildStateId,
-      OnSuccess = onSuccess,
-      OnError = onError,
-      OnFailure = onFailure,
-      SubscribedMessageTypes = subscriptionTypes ?? [],
-    };
-
-    _states[stateId] = reg;
+    return AddRegistration(stateId, CreateFactory<TStateClass>(), onSuccess, onError, onFailure, parentStateId, isCompositeParent, initialChildStateId, subscriptionTypes, lifetime);
+  }
 
-    return this;
+  /// <inheritdoc/>
+  public StateMachine<TStateId> RegisterState<TStateClass>(
+    Func<TStateClass> factory,
+    TStateId stateId,
+    TStateId? onSuccess,
+    TStateId? onError,
+    TStateId? onFailure,
+    TStateId? parentStateId = null,
+    bool isCompositeParent = false,
+    TStateId? initialChildStateId = null,
+    IReadOnlyCollection<Type>? subscriptionTypes = null,
+    StateLifetime lifetime = StateLifetime.Singleton)
+    where TStateClass : class, IState<TStateId>
+  {
+    ArgumentNullException.ThrowIfNull(factory);
+    return AddRegistration(stateId, factory, onSuccess, onError, onFailure, parentStateId, isCompositeParent, initialChildStateId, subscriptionTypes, lifetime);
   }
 
   /// <inheritdoc/>
-  public StateMachine<TStateId> RegisterSubComposite<TCompositeParent>(
+  public StateMachine<TStateId> RegisterSubComposite<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TCompositeParent>(
     TStateId stateId,
     TStateId parentStateId,
     TStateId initialChildStateId,
@@ -199,13 +377,14 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
   }
 
   /// <inheritdoc/>
-  public StateMachine<TStateId> RegisterSubState<TChildClass>(
+  public StateMachine<TStateId> RegisterSubState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TChildClass>(
     TStateId stateId,
     TStateId parentStateId,
     TStateId? onSuccess = null,
     TStateId? onError = null,
     TStateId? onFailure = null,
-    IReadOnlyCollection<Type>? subscriptionTypes = null)
+    IReadOnlyCollection<Type>? subscriptionTypes = null,
+    StateLifetime lifetime = StateLifetime.Singleton)
     where TChildClass : class, IState<TStateId>
   {
     if (!_states.TryGetValue(parentStateId, out var pr) || !pr.IsCompositeParent)
@@ -223,7 +402,8 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
       parentStateId,
       isCompositeParent: false,
       initialChildStateId: null,
-      subscriptionTypes: subscriptionTypes);
+      subscriptionTypes: subscriptionTypes,
+      lifetime: lifetime);
   }
 
   /// <inheritdoc/>
@@ -234,308 +414,160 @@ public sealed partial class StateMachine<TStateId> : IStateMachine<TStateId>
     if (!_states.ContainsKey(initialStateId))
       throw new MissingInitialStateException($"Initial state '{initialStateId}' was not registered.");
 
-    TStateId? prevStateId = null;
-    var currentStateId = initialStateId;
-
-    // Make sure we're always initialized
-    Context ??= new Context<TStateId>(
-      currentStateId: default,
-      nextStates: new StateMap<TStateId> { OnSuccess = null, OnError = null, OnFailure = null },
-      tcs: default!,
-      eventAggregator: _eventAggregator);
-
-    while (!cancellationToken.IsCancellationRequested)
-    {
-      var reg = GetRegistration(currentStateId);
-      reg.PreviousStateId = prevStateId;
-
-      // Ensure we're always initialized
-      Context.Parameters = Context.Parameters ?? [];
-      Context.Errors = Context.Errors ?? [];
-
-      // Run any state (composite or leaf) recursively.
-      var result = await RunAnyStateRecursiveAsync(reg, cancellationToken).ConfigureAwait(false);
-      if (result is null)
-        break;
-
-      var nextId = StateMachine<TStateId>.ResolveNext(reg, result.Value);
-      if (nextId is null)
-        break;
-
-      prevStateId = currentStateId;
-      currentStateId = nextId.Value;
-    }
-
+    await PrepareRun().RunAsync(initialStateId, cancellationToken).ConfigureAwait(false);
     return this;
   }
 
-  /// <summary>Get next state transition based on state's result.</summary>
-  /// <param name="reg">State registration.</param>
-  /// <param name="result">State's returned result.</param>
-  /// <returns><see cref="TStateId"/> to go to next or NULL to bubble-up or end state machine process.</returns>
-  private static TStateId? ResolveNext(StateRegistration<TStateId> reg, Result result) => result switch
+  /// <inheritdoc/>
+  public async Task<StateMachine<TStateId>> ResumeAsync(
+    ReadOnlyMemory<byte> checkpoint,
+    IContextSerializer? serializer = null,
+    CancellationToken cancellationToken = default)
   {
-    Result.Success => reg.OnSuccess,
-    Result.Error => reg.OnError,
-    Result.Failure => reg.OnFailure,
-    _ => null,
-  };
+    await PrepareRun().ResumeAsync(checkpoint, serializer, cancellationToken).ConfigureAwait(false);
+    return this;
+  }
 
-  /// <summary>
-  ///   Retrieves an existing state instance associated with the specified registration,
-  ///   or creates and stores a new instance if none exists.
-  /// </summary>
-  /// <param name="reg">
-  ///   The state registration containing the state identifier and factory method used to
-  ///   create the instance if it does not already exist.</param>
-  /// <returns>The state instance corresponding to the specified registration.</returns>
-  private IState<TStateId> GetOrCreateInstance(StateRegistration<TStateId> reg)
+  /// <inheritdoc/>
+  public async Task<StateMachine<TStateId>> ResumeAsync(
+    Stream checkpoint,
+    IContextSerializer? serializer = null,
+    CancellationToken cancellationToken = default)
   {
-    // NOTE (2025-12-28): In the future, should optionally destroy states after `OnExit` via config param
-    if (_instances.TryGetValue(reg.StateId, out var instance))
-      return instance;
-
-    var stateInstance = reg.Factory();
-    _instances[reg.StateId] = stateInstance;
-    return stateInstance;
+    await PrepareRun().ResumeAsync(checkpoint, serializer, cancellationToken).ConfigureAwait(false);
+    return this;
   }
 
-  /// <summary>Retrieves the registration information for the specified state identifier.</summary>
-  /// <param name="stateId">The identifier of the state whose registration information is to be retrieved.</param>
-  /// <returns>The registration associated with the specified state identifier.</returns>
-  /// <exception cref="UnregisteredStateTransitionException">Thrown if the specified state identifier has not been registered.</exception>
-  private StateRegistration<TStateId> GetRegistration(TStateId stateId)
+  /// <summary>Start the machine passively at the initial state; transitions then only happen as input is posted to the returned run.</summary>
+  /// <param name="initialState">Initial startup state.</param>
+  /// <returns>Run to <see cref="StateMachineRun{TStateId}.Post(Result)"/> triggers and messages to, sharing this machine's <see cref="Context"/>.</returns>
+  /// <remarks>See <see cref="StateMachineRun{TStateId}.Start(TStateId)"/>; a machine can be started passively once.</remarks>
+  /// <exception cref="MissingInitialStateException">Thrown if the initial state was not registered.</exception>
+  public StateMachineRun<TStateId> Start(TStateId initialState)
   {
-    // In the future, states can override/customize the "NextState" on the fly, we need a unique exception.
-    if (!_states.TryGetValue(stateId, out var reg))
-      throw new UnregisteredStateTransitionException($"Next State Id '{stateId}' was not registered.");
-
-    return reg;
+    var run = PrepareRun();
+    run.Start(initialState);
+    return run;
   }
 
-  private async Task<Result?> RunAnyStateRecursiveAsync(
-    StateRegistration<TStateId> reg,
-    CancellationToken ct)
+  /// <inheritdoc/>
+  public async Task<StateMachine<TStateId>> WarmUpAsync(WarmUpOptions<TStateId>? options = null, CancellationToken cancellationToken = default)
   {
-    // Run Normal or Command State
-    if (!reg.IsCompositeParent)
-      return await RunLeafAsync(reg, ct).ConfigureAwait(false);
-
-    // Composite States
-    var instance = GetOrCreateInstance(reg);
-
-    Context.Configure(
-      new TaskCompletionSource<Result>(TaskCreationOptions.RunContinuationsAsynchronously),
-      reg.StateId,
-      reg.PreviousStateId);
-    Context.NextStates.OnSuccess = reg.OnSuccess;
-    Context.NextStates.OnError = reg.OnError;
-    Context.NextStates.OnFailure = reg.OnFailure;
-
-    await instance.OnEntering(Context).ConfigureAwait(false);
-
-    // [IsContextPersistent]
-    //  Take snapshot of original Context keys AFTER OnEntering so we can give the state a chance
-    //  to purposely add new keys to and carry forward for subsequent top-level states.
-    //
-    //  Any new Context keys added via OnEnter are considered "for children consumption only".
-    //  After our OnExit, they'll be (optionally) removed.
-    var originalParamKeys = new HashSet<object>(Context.Parameters.Keys);
-    var originalErrorKeys = new HashSet<object>(Context.Errors.Keys);
-
-    await instance.OnEnter(Context).ConfigureAwait(false);
-
-    // TODO (2025-12-28 DS): Consider StateMachine config param to just move along or throw exception
-    if (reg.InitialChildId is null)
-      throw new MissingInitialSubStateException($"Composite '{reg.StateId}' must have an initial child (InitialChildId).");
-
-    var childId = reg.InitialChildId.Value;
-    Result? lastChildResult = null;
+    if (_definition is null)
+      Build();
 
-    // Set the initial substate's PreviousStateId to NULL, as we already know the parent.
-    TStateId? childPrevStateId = null;
-    TStateId? lastChildStateId = null;
+    await _run!.WarmUpAsync(options, cancellationToken).ConfigureAwait(false);
+    return this;
+  }
 
-    // Composite Loop
-    while (!ct.IsCancellationRequested)
-    {
-      var childReg = GetRegistration(childId);
-      childReg.PreviousStateId = childPrevStateId;
-
-      // The child state was not registered the specified composite parent state
-      if (!Equals(childReg.ParentId, reg.StateId))
-        throw new OrphanSubStateException($"Child state '{childId}' must belong to composite '{reg.StateId}'.");
-
-      Result? childResult;
-      if (childReg.IsCompositeParent)
-        childResult = await RunAnyStateRecursiveAsync(childReg, ct).ConfigureAwait(false);
-      else
-        childResult = await RunLeafAsync(childReg, ct).ConfigureAwait(false);
-
-      // Cancelled or timed out inside child state
-      if (childResult is null)
-        return null;
-
-      lastChildResult = childResult;
-      var nextChildId = StateMachine<TStateId>.ResolveNext(childReg, childResult.Value);
-
-      // NULL mapping => last child => bubble-up to parent and exit
-      if (nextChildId is null)
-        break;
-
-      // Ensure next state is a sibling under the same composite parent (i.e. unlinked sub-states)
-      var mappedReg = GetRegistration(nextChildId.Value);
-      if (!Equals(mappedReg.ParentId, reg.StateId))
-        throw new DisjointedNextSubStateException($"Child '{childId}' maps to '{nextChildId}', which is not a sibling under '{reg.StateId}'.");
-
-      // Proceed to the next substate
-      childPrevStateId = childId;
-      childId = nextChildId.Value;
-      lastChildStateId = nextChildId.Value;
-    }
+  /// <inheritdoc/>
+  public void WriteCheckpoint(IBufferWriter<byte> writer, IContextSerializer? serializer = null)
+  {
+    if (_definition is null)
+      Build();
 
-    // Parent's OnExit decides Ok/Error/Failure; Inform parent of last child's result via Context
-    // TODO (2025-12-28 DS): Pass one Context object. Just clear "lastChildResult" after the OnExit.
-    var parentExitTcs = new TaskCompletionSource<Result>(TaskCreationOptions.RunContinuationsAsynchronously);
-    Context.Configure(parentExitTcs, reg.StateId, reg.PreviousStateId, lastChildStateId, lastChildResult);
+    _run!.WriteCheckpoint(writer, serializer);
+  }
 
-    // vNext (2025-12-28 DS): Use `OnState` handler to handle children completion instead of OnExit
-    ////await instance.OnState(Context).ConfigureAwait(false);
-    ////var parentDecision = await WaitForNextOrCancelAsync(parentExitTcs.Task, ct).ConfigureAwait(false);
+  /// <inheritdoc/>
+  public void WriteCheckpoint(Stream writer, IContextSerializer? serializer = null)
+  {
+    if (_definition is null)
+      Build();
 
-    await instance.OnExit(Context).ConfigureAwait(false);
-    var parentDecision = await WaitForNextOrCancelAsync(parentExitTcs.Task, ct).ConfigureAwait(false);
+    _run!.WriteCheckpoint(writer, serializer);
+  }
 
-    // Clear out the garbage pail kids
-    Context.Configure(parentExitTcs, reg.StateId, reg.PreviousStateId, lastChildStateId: null, lastChildResult: null);
+  /// <summary>Adds the registration; every RegisterXxx method ends up here.</summary>
+  /// <returns>Instance of this class.</returns>
+  private StateMachine<TStateId> AddRegistration(
+    TStateId stateId,
+    Func<IState<TStateId>> factory,
+    TStateId? onSuccess,
+    TStateId? onError,
+    TStateId? onFailure,
+    TStateId? parentStateId,
+    bool isCompositeParent,
+    TStateId? initialChildStateId,
+    IReadOnlyCollection<Type>? subscriptionTypes,
+    StateLifetime lifetime,
+    TStateId[]? regionInitialChildStateIds = null,
+    JoinPolicy joinPolicy = JoinPolicy.All)
+  {
+    if (_states.ContainsKey(stateId))
+      throw new DuplicateStateException($"State '{stateId}' already registered.");
 
-    // Optionally cleanup context added by the children; giving the parent a peek at their mess.
-    if (!IsContextPersistent)
+    var reg = new StateRegistration<TStateId>
     {
-      if (Context.Parameters is not null)
-      {
-        foreach (var k in Context.Parameters.Keys)
-          if (!originalParamKeys.Contains(k)) Context.Parameters.Remove(k);
-      }
+      StateId = stateId,
+      Factory = factory,
+      ParentId = parentStateId,
+      IsCompositeParent = isCompositeParent,
+      InitialChildId = initialChildStateId,
+      RegionInitialChildIds = regionInitialChildStateIds,
+      JoinPolicy = joinPolicy,
+      OnSuccess = onSuccess,
+      OnError = onError,
+      OnFailure = onFailure,
+      SubscribedMessageTypes = subscriptionTypes ?? [],
+      Lifetime = lifetime,
+      Pool = lifetime == StateLifetime.Pooled ? new StatePool<TStateId>(Environment.ProcessorCount * 2) : null,
+    };
 
-      if (Context.Errors is not null)
-      {
-        foreach (var k in Context.Errors.Keys)
-          if (!originalErrorKeys.Contains(k)) Context.Errors.Remove(k);
-      }
-    }
+    _states[stateId] = reg;
 
-    // vNext:
-    ////if (parentDecision is null)
-    ////  // Log null decision, possible DefaultStateTimeoutMs encountered.
+    // Topology changed, re-compile on next run and re-export
+    _definition = null;
+    _dotExport = null;
+    _mermaidExport = null;
 
-    return parentDecision;
+    return this;
   }
 
-  // Rename (2015-12-28 DS): RunSingleStateAsync(...)
-  private async Task<Result?> RunLeafAsync(
-    StateRegistration<TStateId> reg,
-    CancellationToken cancellationToken)
+  /// <summary>Bind the state's constructor once, so <c>Factory()</c> is a direct call with no per-entry constructor lookup.</summary>
+  /// <typeparam name="TStateClass">State class.</typeparam>
+  /// <returns>State factory.</returns>
+  /// <remarks>A Type-based container factory is still called with the state's type on every entry; it's the caller's to bind.</remarks>
+  private Func<IState<TStateId>> CreateFactory<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors)] TStateClass>()
+    where TStateClass : class, IState<TStateId>
   {
-    IState<TStateId> instance = GetOrCreateInstance(reg);
-
-    var tcs = new TaskCompletionSource<Result>(TaskCreationOptions.RunContinuationsAsynchronously);
-    Context.Configure(tcs, reg.StateId, reg.PreviousStateId);
-    Context.NextStates.OnSuccess = reg.OnSuccess;
-    Context.NextStates.OnError = reg.OnError;
-    Context.NextStates.OnFailure = reg.OnFailure;
-
-    IDisposable? subscription = null;
-    CancellationTokenSource? timeoutCts = null;
-
-    if (instance is ICommandState<TStateId> cmd)
-    {
-      if (_eventAggregator is not null)
-      {
-        // Apply the Highlander rule!
-        var typeSet = new HashSet<Type>();
-        foreach (var preReg in reg.SubscribedMessageTypes ?? [])
-          typeSet.Add(preReg);
-
-        foreach (var preReg in cmd.SubscribedMessageTypes ?? [])
-          typeSet.Add(preReg);
-
-        IReadOnlyCollection<Type> types = [.. typeSet];
-
-        // The following runs risk of duplicates
-        ////IReadOnlyCollection<Type> types = [.. cmd.SubscribedMessageTypes ?? [], .. reg.SubscribedMessageTypes ?? []];
-
-        subscription = _eventAggregator.Subscribe(async (msgObj) =>
-        {
-          if (cancellationToken.IsCancellationRequested || tcs.Task.IsCompleted)
-            return;
-
-#pragma warning disable SA1501 // Statement should not be on a single line
-          // Swallow to avoid breaking publication loop
-          try { await cmd.OnMessage(Context, msgObj).ConfigureAwait(false); } catch { }
-#pragma warning restore SA1501 // Statement should not be on a single line
-        },
-        [.. types]);   //// [.. types] == types.ToArray()
-
-        var timeoutMs = cmd.TimeoutMs ?? DefaultCommandTimeoutMs;
-        if (timeoutMs > 0)
-        {
-          timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
-          _ = Task.Run(async () =>
-          {
-            try
-            {
-              await Task.Delay(timeoutMs, timeoutCts.Token).ConfigureAwait(false);
-              if (!tcs.Task.IsCompleted && !timeoutCts.IsCancellationRequested)
-                await cmd.OnTimeout(Context).ConfigureAwait(false);
-            }
-            catch (TaskCanceledException)
-            {
-              // Expected exception; swallow it.
-            }
-          },
-          timeoutCts.Token);
-        }
-      }
-    }
+    if (_services is not null)
+      return _services.CreateFactory<TStateClass>();
 
-    try
+    if (_containerFactory is null)
     {
-      await instance.OnEntering(Context).ConfigureAwait(false);
-      await instance.OnEnter(Context).ConfigureAwait(false);
-
-      var result = await WaitForNextOrCancelAsync(tcs.Task, cancellationToken).ConfigureAwait(false);
-
-      // TODO (2025-12-28 DS): Potential DefaultStateTimeoutMs. Even leaving OnEnter without NextState(Result.OK), should consider calling `OnExit` to allow states to cleanup.
-      if (result is null)
-        return null;
-
-      await instance.OnExit(Context).ConfigureAwait(false);
-
-      reg.OnSuccess = Context.NextStates.OnSuccess;
-      reg.OnError = Context.NextStates.OnError;
-      reg.OnFailure = Context.NextStates.OnFailure;
+      // Without a parameterless constructor, throw the usual MissingMethodException when the state is entered
+      if (typeof(TStateClass).GetConstructor(Type.EmptyTypes) is not { } ctor)
+        return static () => Activator.CreateInstance<TStateClass>();
 
-      return result.Value;
-    }
-    finally
-    {
-      timeoutCts?.Cancel();
-      timeoutCts?.Dispose();
-      subscription?.Dispose();
+      var invoker = ConstructorInvoker.Create(ctor);
+      return () => (IState<TStateId>)invoker.Invoke();
     }
+
+    // TODO (2025-12-28 DS): Shouldn't happen. Use custom exception, StateClassNotRegisteredInContainerException
+    var containerFactory = _containerFactory;
+    return () => (IState<TStateId>)(containerFactory(typeof(TStateClass))
+      ?? throw new InvalidOperationException($"Factory returned null for {typeof(TStateClass).Name}"));
   }
 
-  private async Task<Result?> WaitForNextOrCancelAsync(Task<Result> t, CancellationToken ct)
+  /// <summary>Build if needed and apply the current settings to the run, as they may change between runs.</summary>
+  /// <returns>Run backing this machine.</returns>
+  private StateMachineRun<TStateId> PrepareRun()
   {
-    var cts = CancellationTokenSource.CreateLinkedTokenSource(ct);
-    var cancelTask = Task.Delay(DefaultStateTimeoutMs, cts.Token);
-    var completed = await Task.WhenAny(t, cancelTask).ConfigureAwait(false);
-    cts.Cancel();
-
-    if (completed == t)
-      return t.Result;
-
-    return null;
+    if (_definition is null)
+      Build();
+
+    var run = _run!;
+    run.AddedContext = _addedContext;
+    run.CheckpointHandler = CheckpointHandler;
+    run.DefaultCommandTimeoutMs = DefaultCommandTimeoutMs;
+    run.DefaultStateTimeoutMs = DefaultStateTimeoutMs;
+    run.IsContextPersistent = IsContextPersistent;
+    run.IsMessageRoutingEnabled = IsMessageRoutingEnabled;
+    run.MessageQueueCapacity = MessageQueueCapacity;
+    run.MessageQueueFullMode = MessageQueueFullMode;
+    run.TimeProvider = TimeProvider;
+    run.Trace = Trace;
+    return run;
   }
 }
@@ -0,0 +1,238 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Threading.Channels;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine;
+
+/// <summary>Immutable, compiled state machine: registrations, transition table and default settings.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Built once by <see cref="StateMachine{TStateId}.BuildDefinition"/> and shared by any number of concurrent
+///   <see cref="StateMachineRun{TStateId}"/>; later registrations on the machine don't affect it.
+/// </remarks>
+public sealed class StateMachineDefinition<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Initializes a new instance of the <see cref="StateMachineDefinition{TStateId}"/> class.</summary>
+  /// <param name="registrations">State registrations.</param>
+  /// <param name="eventAggregator">Default event aggregator for runs.</param>
+  /// <param name="settings">Default settings for runs.</param>
+  /// <param name="logger">Default logger for runs.</param>
+  /// <exception cref="MissingInitialSubStateException">Thrown if a composite has no initial child.</exception>
+  /// <exception cref="OrphanSubStateException">Thrown if a composite's initial child isn't registered under it.</exception>
+  /// <exception cref="DisjointedNextSubStateException">Thrown if a sub-state transitions outside its composite, or into another region.</exception>
+  internal StateMachineDefinition(
+    IReadOnlyCollection<StateRegistration<TStateId>> registrations,
+    IEventAggregator? eventAggregator,
+    IStateMachine<TStateId> settings,
+    ILogger? logger)
+  {
+    var regs = new StateRegistration<TStateId>[registrations.Count];
+    var ids = new TStateId[regs.Length];
+
+    var n = 0;
+    foreach (var reg in registrations)
+    {
+      regs[n] = reg;
+      ids[n++] = reg.StateId;
+    }
+
+    var index = new StateIndexMap<TStateId>(ids);
+    var nodes = new StateNode<TStateId>[regs.Length];
+
+    for (int i = 0; i < regs.Length; i++)
+    {
+      var reg = regs[i];
+      nodes[i] = new StateNode<TStateId>
+      {
+        StateId = reg.StateId,
+        Registration = reg,
+        IsCompositeParent = reg.IsCompositeParent,
+        Name = reg.StateId.ToString(),
+        ParentIndex = index.IndexOf(reg.ParentId),
+        InitialChildIndex = index.IndexOf(reg.InitialChildId),
+        RegionChildIndices = IndexOfAll(index, reg.RegionInitialChildIds),
+        RegionIndex = StateNode<TStateId>.None,
+        JoinPolicy = reg.JoinPolicy,
+        OnSuccess = reg.OnSuccess,
+        OnError = reg.OnError,
+        OnFailure = reg.OnFailure,
+        OnSuccessIndex = index.IndexOf(reg.OnSuccess),
+        OnErrorIndex = index.IndexOf(reg.OnError),
+        OnFailureIndex = index.IndexOf(reg.OnFailure),
+      };
+    }
+
+    // Validate the whole graph once, so the transition loops don't re-check it on every hop.
+    // NOTE: Unregistered targets stay legal until taken; a machine may be built before all its states are registered.
+    Validate(nodes);
+    AssignRegions(nodes);
+
+    Index = index;
+    Nodes = nodes;
+    States = ids;
+    EventAggregator = eventAggregator;
+
+    DefaultCommandTimeoutMs = settings.DefaultCommandTimeoutMs;
+    DefaultStateTimeoutMs = settings.DefaultStateTimeoutMs;
+    IsContextPersistent = settings.IsContextPersistent;
+    IsMessageRoutingEnabled = settings.IsMessageRoutingEnabled;
+    MessageQueueCapacity = settings.MessageQueueCapacity;
+    MessageQueueFullMode = settings.MessageQueueFullMode;
+    TimeProvider = settings.TimeProvider;
+    Logger = logger;
+  }
+
+  /// <summary>Gets the default <see cref="ICommandState{TStateId}"/> timeout for runs.</summary>
+  public int DefaultCommandTimeoutMs { get; }
+
+  /// <summary>Gets the default <see cref="IState{TStateId}"/> timeout for runs.</summary>
+  public int DefaultStateTimeoutMs { get; }
+
+  /// <summary>Gets the default event aggregator for runs.</summary>
+  public IEventAggregator? EventAggregator { get; }
+
+  /// <summary>Gets a value indicating whether substate-added context persists when returning to the parent, for runs.</summary>
+  public bool IsContextPersistent { get; }
+
+  /// <summary>Gets a value indicating whether runs route command state messages, by default.</summary>
+  public bool IsMessageRoutingEnabled { get; }
+
+  /// <summary>Gets the default logger for runs, or NULL.</summary>
+  public ILogger? Logger { get; }
+
+  /// <summary>Gets the default command state message queue capacity for runs.</summary>
+  public int MessageQueueCapacity { get; }
+
+  /// <summary>Gets the default full message queue policy for runs.</summary>
+  public BoundedChannelFullMode MessageQueueFullMode { get; }
+
+  /// <summary>Gets the registered states, in registration order.</summary>
+  public IReadOnlyList<TStateId> States { get; }
+
+  /// <summary>Gets the default clock for runs.</summary>
+  public TimeProvider TimeProvider { get; }
+
+  /// <summary>Gets the lookup of <typeparamref name="TStateId"/> to <see cref="Nodes"/> index.</summary>
+  internal StateIndexMap<TStateId> Index { get; }
+
+  /// <summary>Gets the compiled transition table, as registered; runs copy it.</summary>
+  internal StateNode<TStateId>[] Nodes { get; }
+
+  /// <summary>Create a new, independent run.</summary>
+  /// <param name="eventAggregator">Run's event aggregator, or NULL for <see cref="EventAggregator"/>.</param>
+  /// <param name="parameters">Optional initial context parameters.</param>
+  /// <returns>New run with its own context and state instances.</returns>
+  public StateMachineRun<TStateId> CreateRun(IEventAggregator? eventAggregator = null, PropertyBag? parameters = null)
+  {
+    var run = new StateMachineRun<TStateId>(this, context: null, eventAggregator ?? EventAggregator);
+    if (parameters is not null)
+    {
+      foreach (var item in parameters)
+        run.Context.Parameters.SafeAdd(item.Key, item.Value);
+    }
+
+    return run;
+  }
+
+  /// <summary>Mark each sub-state of a parallel composite with the region whose initial child reaches it.</summary>
+  /// <param name="nodes">Validated node table.</param>
+  /// <remarks>Regions run concurrently on the same node table, so a sub-state reachable from two regions is rejected.</remarks>
+  private static void AssignRegions(StateNode<TStateId>[] nodes)
+  {
+    Stack<int>? pending = null;
+    for (int i = 0; i < nodes.Length; i++)
+    {
+      if (nodes[i].RegionChildIndices is not { } regions)
+        continue;
+
+      pending ??= new Stack<int>();
+      for (int region = 0; region < regions.Length; region++)
+      {
+        if (regions[region] >= 0)
+          pending.Push(regions[region]);
+
+        while (pending.Count > 0)
+        {
+          ref var node = ref nodes[pending.Pop()];
+          if (node.RegionIndex == region)
+            continue;
+
+          if (node.RegionIndex != StateNode<TStateId>.None)
+            throw new DisjointedNextSubStateException($"Child '{node.StateId}' is reachable from more than one region of parallel composite '{nodes[i].StateId}'.");
+
+          node.RegionIndex = region;
+
+          // NOTE: Sibling-only transitions were validated, so this never leaves the composite
+          if (node.OnSuccessIndex >= 0)
+            pending.Push(node.OnSuccessIndex);
+
+          if (node.OnErrorIndex >= 0)
+            pending.Push(node.OnErrorIndex);
+
+          if (node.OnFailureIndex >= 0)
+            pending.Push(node.OnFailureIndex);
+        }
+      }
+    }
+  }
+
+  private static int[]? IndexOfAll(StateIndexMap<TStateId> index, TStateId[]? stateIds)
+  {
+    if (stateIds is null)
+      return null;
+
+    var indices = new int[stateIds.Length];
+    for (int i = 0; i < stateIds.Length; i++)
+      indices[i] = index.IndexOf(stateIds[i]);
+
+    return indices;
+  }
+
+  private static void Validate(StateNode<TStateId>[] nodes)
+  {
+    for (int i = 0; i < nodes.Length; i++)
+    {
+      ref var node = ref nodes[i];
+      var reg = node.Registration;
+
+      if (node.IsCompositeParent)
+      {
+        // TODO (2025-12-28 DS): Consider StateMachine config param to just move along or throw exception
+        if (node.InitialChildIndex == StateNode<TStateId>.None)
+          throw new MissingInitialSubStateException($"Composite '{reg.StateId}' must have an initial child (InitialChildId).");
+
+        // The child state was not registered the specified composite parent state
+        if (node.InitialChildIndex >= 0 && nodes[node.InitialChildIndex].ParentIndex != i)
+          throw new OrphanSubStateException($"Child state '{reg.InitialChildId}' must belong to composite '{reg.StateId}'.");
+
+        // Every region of a parallel composite starts under it
+        for (int r = 0; r < (node.RegionChildIndices?.Length ?? 0); r++)
+        {
+          var childIndex = node.RegionChildIndices![r];
+          if (childIndex >= 0 && nodes[childIndex].ParentIndex != i)
+            throw new OrphanSubStateException($"Region child state '{reg.RegionInitialChildIds![r]}' must belong to composite '{reg.StateId}'.");
+        }
+      }
+
+      // Ensure a sub-state's next states are siblings under the same composite parent (i.e. unlinked sub-states)
+      if (node.ParentIndex >= 0 && nodes[node.ParentIndex].IsCompositeParent)
+      {
+        CheckSibling(nodes, i, node.OnSuccessIndex);
+        CheckSibling(nodes, i, node.OnErrorIndex);
+        CheckSibling(nodes, i, node.OnFailureIndex);
+      }
+    }
+
+    static void CheckSibling(StateNode<TStateId>[] nodes, int index, int nextIndex)
+    {
+      var parentIndex = nodes[index].ParentIndex;
+      if (nextIndex >= 0 && nodes[nextIndex].ParentIndex != parentIndex)
+        throw new DisjointedNextSubStateException($"Child '{nodes[index].StateId}' maps to '{nodes[nextIndex].StateId}', which is not a sibling under '{nodes[parentIndex].StateId}'.");
+    }
+  }
+}
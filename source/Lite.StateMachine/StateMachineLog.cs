@@ -0,0 +1,61 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine;
+
+/// <summary>Source-generated log messages of the state machine.</summary>
+/// <remarks>
+///   State names are the cached <see cref="StateNode{TStateId}.Name"/>, so <c>TStateId</c> is never boxed or formatted.
+///   Callers on the transition path check <see cref="ILogger.IsEnabled"/> first, so a level filtering them out costs
+///   only that check; the generated methods check it again before formatting.
+/// </remarks>
+internal static partial class StateMachineLog
+{
+  /// <summary>Next state name used when the run ends.</summary>
+  public const string EndOfRun = "(end)";
+
+  [LoggerMessage(EventId = 1, EventName = "Transition", Level = LogLevel.Debug, Message = "State '{StateName}' completed with {Result}; next '{NextStateName}'")]
+  public static partial void Transition(ILogger logger, string stateName, Result result, string nextStateName);
+
+  [LoggerMessage(EventId = 2, EventName = "CommandTimeout", Level = LogLevel.Information, Message = "Command state '{StateName}' timed out")]
+  public static partial void CommandTimeout(ILogger logger, string stateName);
+
+  [LoggerMessage(EventId = 3, EventName = "StateTimeout", Level = LogLevel.Warning, Message = "State '{StateName}' made no decision within {TimeoutMs} ms; ending the run")]
+  public static partial void StateTimeout(ILogger logger, string stateName, int timeoutMs);
+
+  [LoggerMessage(EventId = 4, EventName = "StateCancelled", Level = LogLevel.Information, Message = "State '{StateName}' was cancelled")]
+  public static partial void StateCancelled(ILogger logger, string stateName);
+
+  [LoggerMessage(EventId = 5, EventName = "MessageHandlerFaulted", Level = LogLevel.Error, Message = "Command state '{StateName}' threw handling {MessageType}; the message was dropped")]
+  public static partial void MessageHandlerFaulted(ILogger logger, Exception exception, string stateName, string messageType);
+
+  [LoggerMessage(EventId = 6, EventName = "SubscriberFaulted", Level = LogLevel.Error, Message = "Subscriber threw handling {MessageType}; publishing continues")]
+  public static partial void SubscriberFaulted(ILogger logger, Exception exception, string messageType);
+
+  [LoggerMessage(EventId = 7, EventName = "TimeoutHandlerFaulted", Level = LogLevel.Error, Message = "Command state '{StateName}' threw from OnTimeout; the state keeps waiting for a decision")]
+  public static partial void TimeoutHandlerFaulted(ILogger logger, Exception exception, string stateName);
+
+  /// <summary>Log an exception swallowed from <see cref="ICommandState{TStateId}.OnMessage"/>, if errors are enabled.</summary>
+  /// <param name="logger">Logger, or NULL.</param>
+  /// <param name="exception">Exception thrown.</param>
+  /// <param name="stateName">State name.</param>
+  /// <param name="message">Message being handled, or NULL for a batch.</param>
+  public static void OnMessageFaulted(ILogger? logger, Exception exception, string stateName, object? message)
+  {
+    if (logger is not null && logger.IsEnabled(LogLevel.Error))
+      MessageHandlerFaulted(logger, exception, stateName, message?.GetType().Name ?? "a batch");
+  }
+
+  /// <summary>Log an exception swallowed from a timer-fired <see cref="ICommandState{TStateId}.OnTimeout"/>, if errors are enabled.</summary>
+  /// <param name="logger">Logger, or NULL.</param>
+  /// <param name="exception">Exception thrown.</param>
+  /// <param name="stateName">State name.</param>
+  public static void OnTimeoutFaulted(ILogger? logger, Exception exception, string stateName)
+  {
+    if (logger is not null && logger.IsEnabled(LogLevel.Error))
+      TimeoutHandlerFaulted(logger, exception, stateName);
+  }
+}
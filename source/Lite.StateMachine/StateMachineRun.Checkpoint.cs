@@ -0,0 +1,469 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Checkpoint and resume partial class.</summary>
+/// <remarks>
+///   Checkpoint layout (little-endian):
+///   <code>
+///     Header:    uint Magic, ushort FormatVersion, ushort Depth
+///     Level[]:   long StateId, byte HasPrevious, long PreviousStateId    (outermost composite first, current state last)
+///     Overrides: int Count, then { long StateId, 3 x (byte HasValue, long StateId) } for OnSuccess, OnError, OnFailure
+///     Bags:      ushort Scopes (0 when not serialized), then per scope { int Length, bytes }; once for Parameters, then Errors
+///   </code>
+///   State ids are stored as their enum's raw bits, zero-extended to 8 bytes. A non-persistent context is written one scope at a
+///   time, the keys outside of every scope first, then those of each composite on the stack, so they're dropped again as it exits.
+/// </remarks>
+public sealed partial class StateMachineRun<TStateId>
+{
+  /// <summary>File magic, "LSCK".</summary>
+  private const uint CheckpointMagic = 0x4B43534C;
+
+  private const ushort CheckpointFormatVersion = 2;
+
+  private const int CheckpointHeaderSize = 8;
+
+  private const int LevelSize = 8 + OptionalIdSize;
+
+  private const int OptionalIdSize = 1 + 8;
+
+  private const int OverrideSize = 8 + (3 * OptionalIdSize);
+
+  /// <summary>Serialized bag, reused across checkpoints (lazy-loaded).</summary>
+  private ArrayBufferWriter<byte>? _bagBuffer;
+
+  /// <summary>One scope of a non-persistent context being serialized, reused across checkpoints (lazy-loaded).</summary>
+  private PropertyBag? _scopeBag;
+
+  /// <summary>Whole checkpoint, reused by <see cref="WriteCheckpoint(Stream, IContextSerializer?)"/> (lazy-loaded).</summary>
+  private ArrayBufferWriter<byte>? _checkpointBuffer;
+
+  /// <summary>Node index of the state being run, or <see cref="StateNode{TStateId}.None"/> before the first and after the last state.</summary>
+  private int _position = StateNode<TStateId>.None;
+
+  /// <summary>Checkpointed composite path still to re-enter while resuming, otherwise NULL.</summary>
+  private int[]? _resumePath;
+
+  /// <summary>Next level of <see cref="_resumePath"/> to enter.</summary>
+  private int _resumeLevel;
+
+  /// <summary>Previous State Id of each <see cref="_resumePath"/> level.</summary>
+  private TStateId?[]? _resumePreviousIds;
+
+  /// <summary>Context scopes restored for the checkpointed composites, until they're re-entered.</summary>
+  private ResumeScope[]? _resumeScopes;
+
+  /// <summary>Next level of <see cref="_resumeScopes"/> to take.</summary>
+  private int _resumeScopeLevel;
+
+  /// <summary>
+  ///   Gets or sets an optional callback invoked as each state is entered (after its context is configured, before <c>OnEntering</c>),
+  ///   so <see cref="WriteCheckpoint(IBufferWriter{byte}, IContextSerializer?)"/> can be taken on every transition; NULL (default) to disable.
+  /// </summary>
+  /// <remarks>Not invoked for the sub-states of parallel regions; the checkpoint position stays on their parallel composite.</remarks>
+  public Action<StateMachineRun<TStateId>>? CheckpointHandler { get; set; }
+
+  /// <summary>Gets or sets the parameters the machine was given with <c>AddContext</c>, kept when a checkpoint replaces the context.</summary>
+  internal PropertyBag? AddedContext { get; set; }
+
+  /// <summary>Resume a run from a checkpoint written by <see cref="WriteCheckpoint(IBufferWriter{byte}, IContextSerializer?)"/>.</summary>
+  /// <param name="checkpoint">Checkpoint bytes.</param>
+  /// <param name="serializer">Serializer for the context, or NULL to keep the current context as-is.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>This run.</returns>
+  /// <remarks>
+  ///   The checkpointed state is entered again from <c>OnEntering</c>, and its composite parents are re-entered (so they can
+  ///   re-acquire whatever their <c>OnEnter</c> sets up) with their sub-states starting at the checkpointed one instead of the initial child.
+  ///   A checkpoint of a completed run restores the context and returns without entering any state.
+  ///   With a serializer, the context is replaced; only the checkpoint's entries and those given to <c>AddContext</c> are kept.
+  /// </remarks>
+  /// <exception cref="InvalidCheckpointException">Thrown if the checkpoint is corrupt or doesn't match the registered states.</exception>
+  public async Task<StateMachineRun<TStateId>> ResumeAsync(
+    ReadOnlyMemory<byte> checkpoint,
+    IContextSerializer? serializer = null,
+    CancellationToken cancellationToken = default)
+  {
+    var path = RestoreCheckpoint(checkpoint.Span, serializer, out var previousIds);
+    if (path.Length == 0)
+      return this;
+
+    if (path.Length > 1)
+    {
+      _resumePath = path;
+      _resumePreviousIds = previousIds;
+      _resumeLevel = 1;
+    }
+
+    return await RunFromAsync(path[0], previousIds[0], cancellationToken).ConfigureAwait(false);
+  }
+
+  /// <inheritdoc cref="ResumeAsync(ReadOnlyMemory{byte}, IContextSerializer, CancellationToken)"/>
+  public async Task<StateMachineRun<TStateId>> ResumeAsync(
+    Stream checkpoint,
+    IContextSerializer? serializer = null,
+    CancellationToken cancellationToken = default)
+  {
+    ArgumentNullException.ThrowIfNull(checkpoint);
+
+    var buffer = new MemoryStream();
+    await checkpoint.CopyToAsync(buffer, cancellationToken).ConfigureAwait(false);
+    return await ResumeAsync(buffer.GetBuffer().AsMemory(0, (int)buffer.Length), serializer, cancellationToken).ConfigureAwait(false);
+  }
+
+  /// <summary>Write a checkpoint of the current position (composite stack, state and previous states), <c>NextStates</c> overrides and context.</summary>
+  /// <param name="writer">Destination.</param>
+  /// <param name="serializer">Serializer for <see cref="Context{TStateId}.Parameters"/> and <see cref="Context{TStateId}.Errors"/>, or NULL to leave the context out.</param>
+  /// <remarks>
+  ///   Call from the run's own flow, i.e. <see cref="CheckpointHandler"/> or a state's handler.
+  ///   Cost is a walk up the composite stack and the node table with no allocation, plus whatever the serializer writes.
+  /// </remarks>
+  public void WriteCheckpoint(IBufferWriter<byte> writer, IContextSerializer? serializer = null)
+  {
+    ArgumentNullException.ThrowIfNull(writer);
+
+    var depth = 0;
+    for (var i = _position; i >= 0; i = _nodes[i].ParentIndex)
+      depth++;
+
+    var overrides = 0;
+    for (int i = 0; i < _nodes.Length; i++)
+    {
+      if (HasOverride(in _nodes[i]))
+        overrides++;
+    }
+
+    var levelsSize = depth * LevelSize;
+    var size = CheckpointHeaderSize + levelsSize + sizeof(int) + (overrides * OverrideSize);
+    var span = writer.GetSpan(size)[..size];
+
+    BinaryPrimitives.WriteUInt32LittleEndian(span, CheckpointMagic);
+    BinaryPrimitives.WriteUInt16LittleEndian(span[4..], CheckpointFormatVersion);
+    BinaryPrimitives.WriteUInt16LittleEndian(span[6..], (ushort)depth);
+
+    // Walk up from the current state, filling the levels from the end so the outermost comes first
+    var offset = CheckpointHeaderSize + levelsSize;
+    for (var i = _position; i >= 0; i = _nodes[i].ParentIndex)
+    {
+      offset -= LevelSize;
+      BinaryPrimitives.WriteInt64LittleEndian(span[offset..], ToBits(_nodes[i].StateId));
+      WriteOptionalId(span[(offset + 8)..], _nodes[i].PreviousStateId);
+    }
+
+    offset = CheckpointHeaderSize + levelsSize;
+    BinaryPrimitives.WriteInt32LittleEndian(span[offset..], overrides);
+    offset += sizeof(int);
+
+    for (int i = 0; i < _nodes.Length && overrides > 0; i++)
+    {
+      ref var node = ref _nodes[i];
+      if (!HasOverride(in node))
+        continue;
+
+      BinaryPrimitives.WriteInt64LittleEndian(span[offset..], ToBits(node.StateId));
+      WriteOptionalId(span[(offset + 8)..], node.OnSuccess);
+      WriteOptionalId(span[(offset + 8 + OptionalIdSize)..], node.OnError);
+      WriteOptionalId(span[(offset + 8 + (2 * OptionalIdSize))..], node.OnFailure);
+      offset += OverrideSize;
+      overrides--;
+    }
+
+    writer.Advance(size);
+
+    WriteBag(writer, Context.Parameters, serializer);
+    WriteBag(writer, Context.Errors, serializer);
+  }
+
+  /// <inheritdoc cref="WriteCheckpoint(IBufferWriter{byte}, IContextSerializer)"/>
+  public void WriteCheckpoint(Stream writer, IContextSerializer? serializer = null)
+  {
+    ArgumentNullException.ThrowIfNull(writer);
+
+    var buffer = _checkpointBuffer ??= new ArrayBufferWriter<byte>();
+    buffer.ResetWrittenCount();
+    WriteCheckpoint(buffer, serializer);
+    writer.Write(buffer.WrittenSpan);
+  }
+
+  /// <summary>Zero-extended raw bits of the State Id.</summary>
+  private static long ToBits(TStateId stateId) => Unsafe.SizeOf<TStateId>() switch
+  {
+    1 => Unsafe.As<TStateId, byte>(ref stateId),
+    2 => Unsafe.As<TStateId, ushort>(ref stateId),
+    4 => Unsafe.As<TStateId, uint>(ref stateId),
+    _ => Unsafe.As<TStateId, long>(ref stateId),
+  };
+
+  /// <summary>Read a State Id written by <see cref="ToBits"/>, from the low bytes of its little-endian slot.</summary>
+  /// <remarks>Narrowed to the enum's own size, so it doesn't depend on the machine's byte order.</remarks>
+  private static TStateId ReadStateId(ReadOnlySpan<byte> span)
+  {
+    switch (Unsafe.SizeOf<TStateId>())
+    {
+      case 1:
+        var b = span[0];
+        return Unsafe.As<byte, TStateId>(ref b);
+
+      case 2:
+        var s = BinaryPrimitives.ReadUInt16LittleEndian(span);
+        return Unsafe.As<ushort, TStateId>(ref s);
+
+      case 4:
+        var i = BinaryPrimitives.ReadUInt32LittleEndian(span);
+        return Unsafe.As<uint, TStateId>(ref i);
+
+      default:
+        var l = BinaryPrimitives.ReadInt64LittleEndian(span);
+        return Unsafe.As<long, TStateId>(ref l);
+    }
+  }
+
+  private static TStateId? ReadOptionalId(ReadOnlySpan<byte> span) =>
+    span[0] == 0 ? null : ReadStateId(span[1..]);
+
+  private static void WriteOptionalId(Span<byte> span, TStateId? stateId)
+  {
+    span[0] = stateId.HasValue ? (byte)1 : (byte)0;
+    BinaryPrimitives.WriteInt64LittleEndian(span[1..], stateId.HasValue ? ToBits(stateId.GetValueOrDefault()) : 0);
+  }
+
+  /// <summary>Gets whether a <c>NextStates</c> override changed any of the node's registered transitions.</summary>
+  private static bool HasOverride(in StateNode<TStateId> node)
+  {
+    var reg = node.Registration;
+    return !SameState(node.OnSuccess, reg.OnSuccess) || !SameState(node.OnError, reg.OnError) || !SameState(node.OnFailure, reg.OnFailure);
+  }
+
+  /// <summary>Read one bag section, restoring it when a serializer is given.</summary>
+  /// <param name="data">Checkpoint, at the section.</param>
+  /// <param name="bag">Bag to restore into.</param>
+  /// <param name="serializer">Context serializer.</param>
+  /// <param name="depth">Checkpointed levels.</param>
+  /// <param name="scopes">Scope token opened for each composite level's keys; empty for persistent contexts.</param>
+  /// <returns>Remaining checkpoint.</returns>
+  private ReadOnlySpan<byte> ReadBag(ReadOnlySpan<byte> data, PropertyBag bag, IContextSerializer? serializer, int depth, out int[] scopes)
+  {
+    if (data.Length < sizeof(ushort))
+      throw new InvalidCheckpointException("Checkpoint is truncated.");
+
+    var count = BinaryPrimitives.ReadUInt16LittleEndian(data);
+    data = data[sizeof(ushort)..];
+    if (count > depth + 1)
+      throw new InvalidCheckpointException("Checkpoint context has more scopes than composites to re-enter.");
+
+    var isScoped = serializer is not null && !IsContextPersistent && count > 1;
+    scopes = isScoped ? new int[count - 1] : [];
+    for (int scope = 0; scope < count; scope++)
+    {
+      if (data.Length < sizeof(int))
+        throw new InvalidCheckpointException("Checkpoint is truncated.");
+
+      var length = BinaryPrimitives.ReadInt32LittleEndian(data);
+      data = data[sizeof(int)..];
+      if (length < 0 || length > data.Length)
+        throw new InvalidCheckpointException("Checkpoint is truncated.");
+
+      if (isScoped && scope > 0)
+        scopes[scope - 1] = bag.PushScope();
+
+      serializer?.Deserialize(data[..length], bag);
+      data = data[length..];
+    }
+
+    return data;
+  }
+
+  /// <summary>Restore overrides and context, returning the position to resume at.</summary>
+  /// <param name="data">Checkpoint.</param>
+  /// <param name="serializer">Context serializer.</param>
+  /// <param name="previousIds">Previous State Id of each level.</param>
+  /// <returns>Node index of each level, outermost first; empty if the run had completed.</returns>
+  private int[] RestoreCheckpoint(ReadOnlySpan<byte> data, IContextSerializer? serializer, out TStateId?[] previousIds)
+  {
+    if (data.Length < CheckpointHeaderSize || BinaryPrimitives.ReadUInt32LittleEndian(data) != CheckpointMagic)
+      throw new InvalidCheckpointException("Not a state machine checkpoint.");
+
+    var version = BinaryPrimitives.ReadUInt16LittleEndian(data[4..]);
+    if (version != CheckpointFormatVersion)
+      throw new InvalidCheckpointException($"Unsupported checkpoint format version '{version}'.");
+
+    var depth = BinaryPrimitives.ReadUInt16LittleEndian(data[6..]);
+    data = data[CheckpointHeaderSize..];
+    if (data.Length < (depth * LevelSize) + sizeof(int))
+      throw new InvalidCheckpointException("Checkpoint is truncated.");
+
+    // Validate the whole position before touching the run
+    var path = new int[depth];
+    previousIds = new TStateId?[depth];
+    for (int level = 0; level < depth; level++)
+    {
+      var stateId = ReadStateId(data);
+      var index = _nodeIndex.IndexOf(stateId);
+      if (index < 0)
+        throw new InvalidCheckpointException($"Checkpoint state '{stateId}' is not registered.");
+
+      var parentIndex = _nodes[index].ParentIndex;
+      if (parentIndex != (level == 0 ? StateNode<TStateId>.None : path[level - 1]))
+        throw new InvalidCheckpointException($"Checkpoint state '{stateId}' is not a sub-state of the state before it.");
+
+      if (parentIndex >= 0 && _nodes[parentIndex].RegionChildIndices is not null)
+        throw new InvalidCheckpointException($"Checkpoint state '{stateId}' is inside a parallel region; resume at its parallel composite.");
+
+      path[level] = index;
+      previousIds[level] = ReadOptionalId(data[8..]);
+      data = data[LevelSize..];
+    }
+
+    var overrides = BinaryPrimitives.ReadInt32LittleEndian(data);
+    data = data[sizeof(int)..];
+    if (overrides < 0 || data.Length < (long)overrides * OverrideSize)
+      throw new InvalidCheckpointException("Checkpoint is truncated.");
+
+    var overrideData = data;
+    for (int i = 0; i < overrides; i++)
+    {
+      var stateId = ReadStateId(data[(i * OverrideSize)..]);
+      if (_nodeIndex.IndexOf(stateId) < 0)
+        throw new InvalidCheckpointException($"Checkpoint state '{stateId}' is not registered.");
+    }
+
+    // The checkpoint's overrides replace this run's, rather than adding to whatever it changed since
+    var registered = Definition.Nodes;
+    for (int i = 0; i < _nodes.Length; i++)
+    {
+      ref var node = ref _nodes[i];
+      node.OnSuccess = registered[i].OnSuccess;
+      node.OnError = registered[i].OnError;
+      node.OnFailure = registered[i].OnFailure;
+      node.OnSuccessIndex = registered[i].OnSuccessIndex;
+      node.OnErrorIndex = registered[i].OnErrorIndex;
+      node.OnFailureIndex = registered[i].OnFailureIndex;
+    }
+
+    for (int i = 0; i < overrides; i++)
+    {
+      var index = _nodeIndex.IndexOf(ReadStateId(overrideData));
+      ref var node = ref _nodes[index];
+      node.OnSuccess = ReadOptionalId(overrideData[8..]);
+      node.OnError = ReadOptionalId(overrideData[(8 + OptionalIdSize)..]);
+      node.OnFailure = ReadOptionalId(overrideData[(8 + (2 * OptionalIdSize))..]);
+      node.OnSuccessIndex = ResolveOverride(index, node.OnSuccess);
+      node.OnErrorIndex = ResolveOverride(index, node.OnError);
+      node.OnFailureIndex = ResolveOverride(index, node.OnFailure);
+      overrideData = overrideData[OverrideSize..];
+    }
+
+    data = data[(overrides * OverrideSize)..];
+
+    Context.Parameters ??= [];
+    Context.Errors ??= [];
+    _resumeScopes = null;
+
+    // Scopes left open by an interrupted run belong to no composite now
+    Context.Parameters.CloseScopes();
+    Context.Errors.CloseScopes();
+    if (serializer is not null)
+    {
+      // Nothing stale from this run's earlier states survives the checkpoint's context
+      Context.Parameters.Clear();
+      Context.Errors.Clear();
+      if (AddedContext is { } added)
+      {
+        foreach (var item in added)
+          Context.Parameters.SafeAdd(item.Key, item.Value);
+      }
+    }
+
+    // Each composite scope's keys are restored into a scope of their own, adopted by the composite when it's re-entered
+    data = ReadBag(data, Context.Parameters, serializer, depth, out var parameterScopes);
+    ReadBag(data, Context.Errors, serializer, depth, out var errorScopes);
+    if (parameterScopes.Length != errorScopes.Length)
+      throw new InvalidCheckpointException("Checkpoint context scopes don't match.");
+
+    if (parameterScopes.Length > 0)
+    {
+      _resumeScopes = new ResumeScope[parameterScopes.Length];
+      for (int level = 0; level < parameterScopes.Length; level++)
+        _resumeScopes[level] = new ResumeScope(path[level], parameterScopes[level], errorScopes[level]);
+
+      _resumeScopeLevel = 0;
+    }
+
+    return path;
+  }
+
+  /// <summary>Take the scopes <see cref="RestoreCheckpoint"/> opened for a composite being re-entered.</summary>
+  /// <param name="index">Node index of the composite.</param>
+  /// <param name="paramScope">Parameters scope token.</param>
+  /// <param name="errorScope">Errors scope token.</param>
+  /// <returns>False if it isn't the next checkpointed composite; push its scopes as usual.</returns>
+  private bool TryTakeResumeScope(int index, out int paramScope, out int errorScope)
+  {
+    if (_resumeScopes is { } scopes && scopes[_resumeScopeLevel].Index == index)
+    {
+      paramScope = scopes[_resumeScopeLevel].ParameterScope;
+      errorScope = scopes[_resumeScopeLevel].ErrorScope;
+      if (++_resumeScopeLevel == scopes.Length)
+        _resumeScopes = null;
+
+      return true;
+    }
+
+    paramScope = -1;
+    errorScope = -1;
+    return false;
+  }
+
+  /// <summary>Write one bag section; the entries outside of every scope, then those of each open scope.</summary>
+  private void WriteBag(IBufferWriter<byte> writer, PropertyBag? bag, IContextSerializer? serializer)
+  {
+    var scopes = serializer is null || bag is null ? 0 : bag.ScopeCount + 1;
+    BinaryPrimitives.WriteUInt16LittleEndian(writer.GetSpan(sizeof(ushort)), (ushort)scopes);
+    writer.Advance(sizeof(ushort));
+    if (scopes == 0)
+      return;
+
+    if (scopes == 1)
+    {
+      WriteBagScope(writer, bag!, serializer!);
+      return;
+    }
+
+    var scopeBag = _scopeBag ??= [];
+    for (int scope = 0; scope < scopes; scope++)
+    {
+      scopeBag.Clear();
+      bag!.CopyScopeTo(scope, scopeBag);
+      WriteBagScope(writer, scopeBag, serializer!);
+    }
+
+    scopeBag.Clear();
+  }
+
+  /// <summary>Write one length-prefixed bag scope.</summary>
+  private void WriteBagScope(IBufferWriter<byte> writer, PropertyBag bag, IContextSerializer serializer)
+  {
+    // Serialize aside first; the length prefix can't be patched once advanced
+    var buffer = _bagBuffer ??= new ArrayBufferWriter<byte>();
+    buffer.ResetWrittenCount();
+    serializer.Serialize(bag, buffer);
+
+    BinaryPrimitives.WriteInt32LittleEndian(writer.GetSpan(sizeof(int)), buffer.WrittenCount);
+    writer.Advance(sizeof(int));
+    writer.Write(buffer.WrittenSpan);
+  }
+
+  /// <summary>Context scopes opened for a checkpointed composite.</summary>
+  /// <param name="Index">Node index of the composite.</param>
+  /// <param name="ParameterScope">Parameters scope token.</param>
+  /// <param name="ErrorScope">Errors scope token.</param>
+  private readonly record struct ResumeScope(int Index, int ParameterScope, int ErrorScope);
+}
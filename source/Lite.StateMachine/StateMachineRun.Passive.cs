@@ -0,0 +1,479 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Passive (event-driven) execution partial class.</summary>
+/// <remarks>
+///   Instead of an async loop awaiting each state, a passive run keeps its position as data (the node index and, per
+///   composite level, its instance and context scopes) and only runs when input arrives through <see cref="Post(Result)"/>
+///   or <see cref="Post(object)"/>. Inputs go onto a lock-free MPSC queue drained by one thread pool work item at a time,
+///   so an idle run holds no pending task, continuation or timer; only its memory.
+/// </remarks>
+public sealed partial class StateMachineRun<TStateId>
+{
+  private const int PassiveCompleted = 2;
+
+  private const int PassiveNotStarted = 0;
+
+  private const int PassiveRunning = 1;
+
+  /// <summary>Between <see cref="Start"/> claiming the run and publishing its inbox.</summary>
+  private const int PassiveStarting = 3;
+
+  /// <summary>Lazily requested <see cref="Completion"/>.</summary>
+  private TaskCompletionSource<StateMachineRun<TStateId>>? _completion;
+
+  /// <summary>1 while a drain is queued or running.</summary>
+  private int _drainScheduled;
+
+  /// <summary>Reusable thread pool work item draining <see cref="_inbox"/>.</summary>
+  private PassiveDrain? _drainItem;
+
+  /// <summary>Exception that ended the passive run.</summary>
+  private Exception? _fault;
+
+  /// <summary>Inputs waiting to be processed (passive runs only).</summary>
+  private MpscQueue<PassiveInput>? _inbox;
+
+  /// <summary>Current position is a composite whose <c>OnExit</c> ran and is waiting on its decision.</summary>
+  private bool _isExiting;
+
+  /// <summary>Per node, what an entered state holds until it's left (passive runs only).</summary>
+  private PassiveLevel[]? _levels;
+
+  private int _passiveStatus;
+
+  /// <summary>Command state timeout that posts to the inbox instead of running on the wheel (lazy-loaded).</summary>
+  private PassiveTimeout? _passiveTimeout;
+
+  private enum PassiveInputKind : byte
+  {
+    Start,
+    Trigger,
+    Message,
+    Timeout,
+  }
+
+  /// <summary>Gets a task completing when the passive run has no transition left, or faulting with the exception a state threw.</summary>
+  /// <remarks>Created on first access, so runs nobody waits on don't hold one.</remarks>
+  public Task<StateMachineRun<TStateId>> Completion
+  {
+    get
+    {
+      var completion = Volatile.Read(ref _completion);
+      if (completion is null)
+      {
+        var created = new TaskCompletionSource<StateMachineRun<TStateId>>(TaskCreationOptions.RunContinuationsAsynchronously);
+        completion = Interlocked.CompareExchange(ref _completion, created, null) ?? created;
+      }
+
+      // NOTE: Checked after publishing, so a run completing concurrently either sees it or is seen here.
+      if (Volatile.Read(ref _passiveStatus) == PassiveCompleted)
+        SetCompletion(completion);
+
+      return completion.Task;
+    }
+  }
+
+  /// <summary>Gets or sets who runs <see cref="DrainAsync"/> when input arrives; NULL (default) for the thread pool.</summary>
+  /// <remarks>Set before <see cref="Start"/>; <see cref="StateMachineSimulation{TStateId}"/> drains on its own thread in order.</remarks>
+  internal Action<StateMachineRun<TStateId>>? ScheduleDrain { get; set; }
+
+  /// <summary>Resolve the state the passive run is waiting in, as if it called <see cref="Context{TStateId}.NextState(Result)"/>.</summary>
+  /// <param name="trigger">State result.</param>
+  /// <returns>False if the run has completed.</returns>
+  /// <exception cref="InvalidOperationException">Thrown if the run was not started with <see cref="Start"/>.</exception>
+  public bool Post(Result trigger) => Enqueue(new PassiveInput(PassiveInputKind.Trigger, trigger, null, 0));
+
+  /// <summary>Deliver a message to the command state the passive run is waiting in, if it subscribes to the message's type (or a base of it).</summary>
+  /// <param name="message">Message.</param>
+  /// <returns>False if the run has completed.</returns>
+  /// <exception cref="InvalidOperationException">Thrown if the run was not started with <see cref="Start"/>.</exception>
+  public bool Post(object message)
+  {
+    ArgumentNullException.ThrowIfNull(message);
+    return Enqueue(new PassiveInput(PassiveInputKind.Message, default, message, 0));
+  }
+
+  /// <summary>Start a passive run; states are entered on the thread pool and transitions only happen as input is posted.</summary>
+  /// <param name="initialStateId">Initial state.</param>
+  /// <remarks>
+  ///   Messages are delivered through <see cref="Post(object)"/> rather than the event aggregator, and states wait for input
+  ///   indefinitely (<see cref="DefaultStateTimeoutMs"/> doesn't apply); command state timeouts are posted like any other input.
+  ///   Parallel composites are not supported passively.
+  /// </remarks>
+  /// <exception cref="MissingInitialStateException">Thrown if the initial state was not registered.</exception>
+  /// <exception cref="InvalidOperationException">Thrown if the run was already started.</exception>
+  public void Start(TStateId initialStateId)
+  {
+    var index = _nodeIndex.IndexOf(initialStateId);
+    if (index < 0)
+      throw new MissingInitialStateException($"Initial state '{initialStateId}' was not registered.");
+
+    if (Interlocked.CompareExchange(ref _passiveStatus, PassiveStarting, PassiveNotStarted) != PassiveNotStarted)
+      throw new InvalidOperationException("Passive run was already started.");
+
+    _levels = new PassiveLevel[_nodes.Length];
+    _drainItem = new PassiveDrain(this);
+
+    // Ensure we're always initialized
+    Context.Parameters ??= [];
+    Context.Errors ??= [];
+
+    // Start goes first, ahead of anything posted concurrently; the inbox is published before the status,
+    // so a Post that sees the run started always finds it (see WaitForInbox)
+    var inbox = new MpscQueue<PassiveInput>();
+    inbox.Enqueue(new PassiveInput(PassiveInputKind.Start, default, null, index));
+    Volatile.Write(ref _inbox, inbox);
+
+    // NOTE: A drain scheduled by a concurrent Post may already have completed the run
+    Interlocked.CompareExchange(ref _passiveStatus, PassiveRunning, PassiveStarting);
+    ScheduleDrainIfIdle();
+  }
+
+  /// <summary>Gets whether the waiting command state subscribes to the message.</summary>
+  private static bool Accepts(StateRegistration<TStateId> reg, ICommandState<TStateId> cmd, object message)
+  {
+    var type = message.GetType();
+    var subscribed = false;
+    foreach (var messageType in reg.SubscribedMessageTypes ?? [])
+    {
+      subscribed = true;
+      if (messageType.IsAssignableFrom(type))
+        return true;
+    }
+
+    foreach (var messageType in cmd.SubscribedMessageTypes ?? [])
+    {
+      subscribed = true;
+      if (messageType.IsAssignableFrom(type))
+        return true;
+    }
+
+    // Nothing declared; same as a wildcard subscription
+    return !subscribed;
+  }
+
+  /// <summary>Leave the current state with its result and enter (only) the next one.</summary>
+  /// <param name="result">Current state's result; NULL ends the run, as with <see cref="RunAsync"/>.</param>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  private async Task CompletePassiveStateAsync(Result? result)
+  {
+    var index = _position;
+    var reg = _nodes[index].Registration;
+    var levels = _levels!;
+    if (result is not { } stateResult)
+    {
+      TraceState(reg.StateId, _nodes[index].PreviousStateId, null, levels[index].Started);
+      FinishPassive(null);
+      return;
+    }
+
+    if (_isExiting)
+    {
+      // Composite's OnExit decided
+      _isExiting = false;
+      Context.SetLastChild(lastChildStateId: null, lastChildResult: null);
+      if (!IsContextPersistent)
+      {
+        Context.Parameters.PopScope(levels[index].ParameterScope);
+        Context.Errors.PopScope(levels[index].ErrorScope);
+      }
+    }
+    else
+    {
+      _passiveTimeout?.Disarm();
+      await OnExitAsync(levels[index].Instance!, Context).ConfigureAwait(false);
+      ApplyNextStateOverrides(index);
+    }
+
+    TraceState(reg.StateId, _nodes[index].PreviousStateId, stateResult, levels[index].Started);
+
+    var instance = levels[index].Instance!;
+    levels[index].Instance = null;
+    await ReleaseInstanceAsync(reg, instance).ConfigureAwait(false);
+
+    var next = ResolveNext(index, stateResult);
+    LogTransition(index, stateResult, next);
+    if (next >= 0)
+    {
+      await EnterPassiveAsync(next, reg.StateId).ConfigureAwait(false);
+      return;
+    }
+
+    var parentIndex = _nodes[index].ParentIndex;
+    if (parentIndex < 0)
+    {
+      FinishPassive(null);
+      return;
+    }
+
+    // Last sub-state; inform the parent and let its OnExit decide (now, or as a posted trigger)
+    // NOTE: Matches the sequential loop, which only reports the last child once a sibling transition happened.
+    TStateId? lastChildStateId = _nodes[index].PreviousStateId is null ? null : reg.StateId;
+    _position = parentIndex;
+    _isExiting = true;
+    Context.Configure(_nodes[parentIndex].StateId, _nodes[parentIndex].PreviousStateId, lastChildStateId, stateResult);
+    await OnExitAsync(levels[parentIndex].Instance!, Context).ConfigureAwait(false);
+  }
+
+  /// <summary>Process queued input until the inbox is empty; one drain at a time, as scheduled by <see cref="Enqueue"/>.</summary>
+  /// <returns>A <see cref="Task"/> that never faults; state exceptions end the run through <see cref="Completion"/>.</returns>
+  internal async Task DrainAsync()
+  {
+    while (true)
+    {
+      while (_inbox!.TryDequeue(out var input))
+      {
+        // Completed (or faulted); late input is dropped
+        if (_passiveStatus == PassiveCompleted)
+          continue;
+
+        try
+        {
+          await ProcessAsync(input).ConfigureAwait(false);
+        }
+        catch (Exception ex)
+        {
+          TracePassiveFault();
+          await ReleasePassiveLevelsAsync().ConfigureAwait(false);
+          FinishPassive(ex);
+        }
+      }
+
+      // Let the next Post schedule a drain, unless one slipped in before the flag was cleared
+      Volatile.Write(ref _drainScheduled, 0);
+      if (_inbox.IsEmpty || Interlocked.CompareExchange(ref _drainScheduled, 1, 0) != 0)
+        return;
+    }
+  }
+
+  private bool Enqueue(PassiveInput input)
+  {
+    var inbox = Volatile.Read(ref _inbox) ?? WaitForInbox();
+    if (Volatile.Read(ref _passiveStatus) == PassiveCompleted)
+      return false;
+
+    inbox.Enqueue(input);
+    ScheduleDrainIfIdle();
+    return true;
+  }
+
+  /// <summary>Enter the state, and down through composites to their initial child, running every handler up to the leaf's <c>OnEnter</c>.</summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <param name="prevStateId">Previous State Id.</param>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  /// <exception cref="NotSupportedException">Thrown when entering a parallel composite.</exception>
+  private async Task EnterPassiveAsync(int index, TStateId? prevStateId)
+  {
+    while (true)
+    {
+      var reg = _nodes[index].Registration;
+      if (_nodes[index].RegionChildIndices is not null)
+        throw new NotSupportedException($"Parallel composite '{reg.StateId}' can't run passively; use RunAsync.");
+
+      _nodes[index].PreviousStateId = prevStateId;
+      var instance = GetOrCreateInstance(index);
+      _levels![index].Instance = instance;
+      _levels[index].Started = Trace is not null ? _timeProvider.GetTimestamp() : 0;
+
+      _position = index;
+      Context.Configure(reg.StateId, prevStateId);
+      _levels[index].EntryVersion = Context.Signal.Version;
+      Context.NextStates.OnSuccess = _nodes[index].OnSuccess;
+      Context.NextStates.OnError = _nodes[index].OnError;
+      Context.NextStates.OnFailure = _nodes[index].OnFailure;
+      CheckpointHandler?.Invoke(this);
+
+      if (!reg.IsCompositeParent)
+      {
+        var timeoutMs = instance is ICommandState<TStateId> cmd ? cmd.TimeoutMs ?? DefaultCommandTimeoutMs : 0;
+        if (timeoutMs > 0)
+          (_passiveTimeout ??= new PassiveTimeout(this)).Arm(_levels[index].EntryVersion, timeoutMs);
+
+        await OnEnteringAsync(instance, Context).ConfigureAwait(false);
+        await OnEnterAsync(instance, Context).ConfigureAwait(false);
+        return;
+      }
+
+      // Same scoping as the sequential composite; keys added from OnEnter on are for the children
+      await OnEnteringAsync(instance, Context).ConfigureAwait(false);
+      if (!IsContextPersistent)
+      {
+        _levels[index].ParameterScope = Context.Parameters.PushScope();
+        _levels[index].ErrorScope = Context.Errors.PushScope();
+      }
+
+      await OnEnterAsync(instance, Context).ConfigureAwait(false);
+
+      var childIndex = _nodes[index].InitialChildIndex;
+      if (childIndex == StateNode<TStateId>.Unregistered)
+        throw new UnregisteredStateTransitionException($"Next State Id '{reg.InitialChildId}' was not registered.");
+
+      index = childIndex;
+      prevStateId = null;
+    }
+  }
+
+  private void FinishPassive(Exception? fault)
+  {
+    _passiveTimeout?.Disarm();
+    _fault = fault;
+
+    // Completed; a checkpoint from here on resumes without entering a state. A fault keeps its position.
+    if (fault is null)
+      _position = StateNode<TStateId>.None;
+
+    Volatile.Write(ref _passiveStatus, PassiveCompleted);
+    if (Volatile.Read(ref _completion) is { } completion)
+      SetCompletion(completion);
+  }
+
+  /// <summary>Apply one input to the waiting state, then transition as far as states complete without waiting on more input.</summary>
+  private async Task ProcessAsync(PassiveInput input)
+  {
+    var index = _position;
+    switch (input.Kind)
+    {
+      case PassiveInputKind.Start:
+        await EnterPassiveAsync(input.Value, null).ConfigureAwait(false);
+        break;
+
+      case PassiveInputKind.Trigger:
+        Context.NextState(input.Result);
+        break;
+
+      case PassiveInputKind.Message:
+        if (index >= 0 && !_isExiting && _levels![index].Instance is ICommandState<TStateId> cmd
+          && Context.Signal.IsPending(_levels[index].EntryVersion) && Accepts(_nodes[index].Registration, cmd, input.Message!))
+          await OnMessageAsync(cmd, Context, input.Message!).ConfigureAwait(false);
+
+        break;
+
+      case PassiveInputKind.Timeout:
+        if (index >= 0 && !_isExiting && _levels![index].Instance is ICommandState<TStateId> timedOut
+          && Context.Signal.IsPending((short)input.Value) && _levels[index].EntryVersion == (short)input.Value)
+          await OnTimeoutAsync(timedOut, Context, _nodes[index].Name, Logger).ConfigureAwait(false);
+
+        break;
+    }
+
+    while (_passiveStatus != PassiveCompleted && Context.Signal.TryGetResult(out var result))
+      await CompletePassiveStateAsync(result).ConfigureAwait(false);
+  }
+
+  /// <summary>Release the instances the faulted run's entered states still hold, innermost first, as the sequential run does.</summary>
+  /// <returns>A <see cref="Task"/> representing the asynchronous operation.</returns>
+  private async Task ReleasePassiveLevelsAsync()
+  {
+    for (var index = _position; index >= 0; index = _nodes[index].ParentIndex)
+    {
+      if (_levels![index].Instance is not { } instance)
+        continue;
+
+      _levels[index].Instance = null;
+
+#pragma warning disable SA1501 // Statement should not be on a single line
+      // Swallowed; the run faults with the state's exception
+      try { await ReleaseInstanceAsync(_nodes[index].Registration, instance).ConfigureAwait(false); } catch { }
+#pragma warning restore SA1501 // Statement should not be on a single line
+    }
+  }
+
+  /// <summary>Schedule <see cref="DrainAsync"/>, unless a drain is already queued or running.</summary>
+  private void ScheduleDrainIfIdle()
+  {
+    if (Interlocked.CompareExchange(ref _drainScheduled, 1, 0) != 0)
+      return;
+
+    if (ScheduleDrain is { } scheduleDrain)
+      scheduleDrain(this);
+    else
+      ThreadPool.UnsafeQueueUserWorkItem(_drainItem!, preferLocal: false);
+  }
+
+  private void SetCompletion(TaskCompletionSource<StateMachineRun<TStateId>> completion)
+  {
+    if (_fault is { } fault)
+      completion.TrySetException(fault);
+    else
+      completion.TrySetResult(this);
+  }
+
+  /// <summary>Trace the state that threw and every composite it was entered through, innermost first, as the sequential run does.</summary>
+  private void TracePassiveFault()
+  {
+    if (Trace is null)
+      return;
+
+    for (var index = _position; index >= 0; index = _nodes[index].ParentIndex)
+    {
+      if (_levels![index].Instance is not null)
+        TraceState(_nodes[index].StateId, _nodes[index].PreviousStateId, null, _levels[index].Started, isFaulted: true);
+    }
+  }
+
+  /// <summary>Wait out a concurrent <see cref="Start"/> that claimed the run but hasn't published its inbox yet.</summary>
+  /// <returns>Inbox.</returns>
+  /// <exception cref="InvalidOperationException">Thrown if the run was not started.</exception>
+  private MpscQueue<PassiveInput> WaitForInbox()
+  {
+    if (Volatile.Read(ref _passiveStatus) == PassiveNotStarted)
+      throw new InvalidOperationException("Passive run was not started.");
+
+    var spinner = default(SpinWait);
+    MpscQueue<PassiveInput>? inbox;
+    while ((inbox = Volatile.Read(ref _inbox)) is null)
+      spinner.SpinOnce();
+
+    return inbox;
+  }
+
+  /// <summary>Passive input.</summary>
+  /// <param name="Kind">Input kind.</param>
+  /// <param name="Result">Trigger result.</param>
+  /// <param name="Message">Message object.</param>
+  /// <param name="Value">Initial node index (start) or entry version (timeout).</param>
+  private readonly record struct PassiveInput(PassiveInputKind Kind, Result Result, object? Message, int Value);
+
+  /// <summary>What an entered state holds until it's left.</summary>
+  private struct PassiveLevel
+  {
+#pragma warning disable SA1401 // Fields should be private
+    public short EntryVersion;
+    public int ErrorScope;
+    public IState<TStateId>? Instance;
+    public int ParameterScope;
+    public long Started;
+#pragma warning restore SA1401 // Fields should be private
+  }
+
+  /// <summary>Drains the run's inbox on the thread pool; one per run, reused for every drain.</summary>
+  private sealed class PassiveDrain(StateMachineRun<TStateId> run) : IThreadPoolWorkItem
+  {
+    // NOTE: Never faults; state exceptions end the run through Completion.
+    public void Execute() => _ = run.DrainAsync();
+  }
+
+  /// <summary>Command state timeout posting to the inbox, so <c>OnTimeout</c> is serialized with the other input.</summary>
+  private sealed class PassiveTimeout(StateMachineRun<TStateId> run) : TimerWheel.Entry
+  {
+    private short _entryVersion;
+
+    public void Arm(short entryVersion, int timeoutMs)
+    {
+      _entryVersion = entryVersion;
+      run._wheel.Arm(this, timeoutMs);
+    }
+
+    public void Disarm() => TryDisarm();
+
+    protected internal override void OnExpired() =>
+      run.Enqueue(new PassiveInput(PassiveInputKind.Timeout, default, null, _entryVersion));
+  }
+}
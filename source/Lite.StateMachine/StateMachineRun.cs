@@ -0,0 +1,1079 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Threading;
+using System.Threading.Channels;
+using System.Threading.Tasks;
+using Microsoft.Extensions.Logging;
+
+namespace Lite.StateMachine;
+
+/// <summary>Single execution of a <see cref="StateMachineDefinition{TStateId}"/>.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Holds everything that changes while running: the <see cref="Context"/>, cached state instances,
+///   <c>NextStates</c> overrides and previous-state tracking. The definition is never written to,
+///   so any number of runs can execute it concurrently without locking.
+/// </remarks>
+public sealed partial class StateMachineRun<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Optional event aggregator for command states.</summary>
+  private readonly IEventAggregator? _eventAggregator;
+
+  /// <summary>Shared lookup of <typeparamref name="TStateId"/> to <see cref="_nodes"/> index.</summary>
+  private readonly StateIndexMap<TStateId> _nodeIndex;
+
+  /// <summary>This run's copy of the compiled transition table.</summary>
+  private readonly StateNode<TStateId>[] _nodes;
+
+  /// <summary>Command state timeout, reused across entries.</summary>
+  private CommandTimeout<TStateId>? _commandTimeout;
+
+  /// <summary>Command state message routes, while <see cref="IsMessageRoutingEnabled"/> (lazy-loaded); shared with parallel regions.</summary>
+  private MessageRouter<TStateId>? _router;
+
+  /// <summary>Router subscribed for the current <see cref="RunAsync"/>, otherwise NULL.</summary>
+  private MessageRouter<TStateId>? _activeRouter;
+
+  private TimeProvider _timeProvider = TimeProvider.System;
+
+  /// <summary>Wheel of <see cref="TimeProvider"/>, timing state and command timeouts.</summary>
+  private TimerWheel _wheel = TimerWheel.Shared;
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachineRun{TStateId}"/> class.</summary>
+  /// <param name="definition">Machine definition.</param>
+  /// <param name="context">Context to run with, or NULL for a new one.</param>
+  /// <param name="eventAggregator">Optional event aggregator for command states.</param>
+  /// <param name="previous">Previous run of an older definition to carry state instances and <c>NextStates</c> overrides from.</param>
+  internal StateMachineRun(
+    StateMachineDefinition<TStateId> definition,
+    Context<TStateId>? context,
+    IEventAggregator? eventAggregator,
+    StateMachineRun<TStateId>? previous = null)
+  {
+    Definition = definition;
+    _eventAggregator = eventAggregator;
+    _nodeIndex = definition.Index;
+    _nodes = (StateNode<TStateId>[])definition.Nodes.Clone();
+
+    // Carry forward lazy-loaded instances and NextStates overrides when re-compiling after a late registration
+    if (previous is not null)
+    {
+      for (int i = 0; i < _nodes.Length; i++)
+      {
+        ref var node = ref _nodes[i];
+        var prevIndex = previous._nodeIndex.IndexOf(node.StateId);
+        if (prevIndex < 0)
+          continue;
+
+        ref var prev = ref previous._nodes[prevIndex];
+        node.Instance = prev.Instance;
+        node.OnSuccess = prev.OnSuccess;
+        node.OnError = prev.OnError;
+        node.OnFailure = prev.OnFailure;
+        node.OnSuccessIndex = ResolveOverride(i, node.OnSuccess);
+        node.OnErrorIndex = ResolveOverride(i, node.OnError);
+        node.OnFailureIndex = ResolveOverride(i, node.OnFailure);
+      }
+    }
+
+    DefaultCommandTimeoutMs = definition.DefaultCommandTimeoutMs;
+    DefaultStateTimeoutMs = definition.DefaultStateTimeoutMs;
+    IsContextPersistent = definition.IsContextPersistent;
+    IsMessageRoutingEnabled = definition.IsMessageRoutingEnabled;
+    MessageQueueCapacity = definition.MessageQueueCapacity;
+    MessageQueueFullMode = definition.MessageQueueFullMode;
+    TimeProvider = definition.TimeProvider;
+    Logger = definition.Logger;
+
+    Context = context ?? new Context<TStateId>(
+      currentStateId: default,
+      nextStates: new StateMap<TStateId> { OnSuccess = null, OnError = null, OnFailure = null },
+      eventAggregator: eventAggregator);
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachineRun{TStateId}"/> class for one region of a parallel composite.</summary>
+  /// <param name="owner">Run hosting the parallel composite.</param>
+  /// <param name="context">Region's context overlay.</param>
+  /// <remarks>Shares the owner's node table; the definition validated that regions never touch the same nodes.</remarks>
+  private StateMachineRun(StateMachineRun<TStateId> owner, Context<TStateId> context)
+  {
+    Definition = owner.Definition;
+    _eventAggregator = owner._eventAggregator;
+    _nodeIndex = owner._nodeIndex;
+    _nodes = owner._nodes;
+
+    DefaultCommandTimeoutMs = owner.DefaultCommandTimeoutMs;
+    DefaultStateTimeoutMs = owner.DefaultStateTimeoutMs;
+    IsContextPersistent = owner.IsContextPersistent;
+    IsMessageRoutingEnabled = owner.IsMessageRoutingEnabled;
+    MessageQueueCapacity = owner.MessageQueueCapacity;
+    MessageQueueFullMode = owner.MessageQueueFullMode;
+    TimeProvider = owner.TimeProvider;
+    Logger = owner.Logger;
+    Trace = owner.Trace;
+    _activeRouter = owner._activeRouter;
+
+    Context = context;
+  }
+
+  /// <summary>Gets the context payload passed between the states.</summary>
+  public Context<TStateId> Context { get; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.DefaultCommandTimeoutMs"/>
+  public int DefaultCommandTimeoutMs { get; set; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/>
+  public int DefaultStateTimeoutMs { get; set; }
+
+  /// <summary>Gets the shared definition being run.</summary>
+  public StateMachineDefinition<TStateId> Definition { get; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.IsContextPersistent"/>
+  public bool IsContextPersistent { get; set; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.IsMessageRoutingEnabled"/>
+  public bool IsMessageRoutingEnabled { get; set; }
+
+  /// <summary>Gets or sets the optional logger of transitions, timeouts and swallowed <c>OnMessage</c> exceptions; NULL (default) to disable.</summary>
+  public ILogger? Logger { get; set; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.MessageQueueCapacity"/>
+  public int MessageQueueCapacity { get; set; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.MessageQueueFullMode"/>
+  public BoundedChannelFullMode MessageQueueFullMode { get; set; }
+
+  /// <inheritdoc cref="IStateMachine{TStateId}.TimeProvider"/>
+  public TimeProvider TimeProvider
+  {
+    get => _timeProvider;
+    set
+    {
+      ArgumentNullException.ThrowIfNull(value);
+      _timeProvider = value;
+      _wheel = TimerWheel.For(value);
+    }
+  }
+
+  /// <summary>Gets or sets the optional ring buffer recording each completed state; NULL (default) to disable.</summary>
+  public TransitionTrace<TStateId>? Trace { get; set; }
+
+  /// <summary>Run from the initial state until no transition remains, a state is cancelled/timed out, or cancellation.</summary>
+  /// <param name="initialStateId">Initial state.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>This run.</returns>
+  /// <remarks>A run is not re-entrant; create one run per concurrent execution.</remarks>
+  /// <exception cref="MissingInitialStateException">Thrown if the initial state was not registered.</exception>
+  public async Task<StateMachineRun<TStateId>> RunAsync(
+    TStateId initialStateId,
+    CancellationToken cancellationToken = default)
+  {
+    var current = _nodeIndex.IndexOf(initialStateId);
+    if (current < 0)
+      throw new MissingInitialStateException($"Initial state '{initialStateId}' was not registered.");
+
+    return await RunFromAsync(current, null, cancellationToken).ConfigureAwait(false);
+  }
+
+  /// <summary>Create state instances (resolving their DI graphs) and run <see cref="IWarmable.WarmUpAsync"/> ahead of the first entry.</summary>
+  /// <param name="options">Warm-up options, or NULL to warm all states, sequentially.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>This run.</returns>
+  /// <remarks>
+  ///   <see cref="StateLifetime.Singleton"/> instances are kept for this run, <see cref="StateLifetime.Pooled"/> ones
+  ///   seed their pool, and <see cref="StateLifetime.Transient"/> ones are disposed after warming up.
+  /// </remarks>
+  /// <exception cref="UnregisteredStateTransitionException">Thrown if a selected state was not registered.</exception>
+  public async Task<StateMachineRun<TStateId>> WarmUpAsync(WarmUpOptions<TStateId>? options = null, CancellationToken cancellationToken = default)
+  {
+    int[] indices;
+    if (options?.States is { } states)
+    {
+      indices = new int[states.Count];
+      var isSelected = new bool[_nodes.Length];
+      var n = 0;
+      foreach (var stateId in states)
+      {
+        var index = _nodeIndex.IndexOf(stateId);
+        if (index < 0)
+          throw new UnregisteredStateTransitionException($"Warm-up State Id '{stateId}' was not registered.");
+
+        // Listed twice warms once; a node must only ever have one worker
+        if (!isSelected[index])
+        {
+          isSelected[index] = true;
+          indices[n++] = index;
+        }
+      }
+
+      if (n < indices.Length)
+        Array.Resize(ref indices, n);
+    }
+    else
+    {
+      indices = new int[_nodes.Length];
+      for (int i = 0; i < indices.Length; i++)
+        indices[i] = i;
+    }
+
+    var parallelism = options?.MaxDegreeOfParallelism ?? 1;
+    if (parallelism == 1)
+    {
+      foreach (var index in indices)
+        await WarmUpStateAsync(index, cancellationToken).ConfigureAwait(false);
+    }
+    else
+    {
+      // NOTE: Indices are distinct, so each worker only touches its own node and the shared table needs no locking.
+      var parallelOptions = new ParallelOptions { MaxDegreeOfParallelism = parallelism, CancellationToken = cancellationToken };
+      await Parallel.ForEachAsync(indices, parallelOptions, (index, ct) => WarmUpStateAsync(index, ct)).ConfigureAwait(false);
+    }
+
+    return this;
+  }
+
+  /// <summary>Ready a completed run for a new input, restoring the definition's transitions and keeping cached state instances.</summary>
+  /// <param name="parameters">New input's context parameters, used as-is.</param>
+  /// <returns>False (nothing reset) if the last run didn't complete; cancelled or timed out runs may hold state mid-flight.</returns>
+  /// <remarks>Drops <c>NextStates</c> overrides, so every input starts from the registered transitions.</remarks>
+  internal bool TryReset(PropertyBag parameters)
+  {
+    if (_position != StateNode<TStateId>.None)
+      return false;
+
+    var nodes = Definition.Nodes;
+    for (int i = 0; i < _nodes.Length; i++)
+    {
+      var instance = _nodes[i].Instance;
+      _nodes[i] = nodes[i];
+      _nodes[i].Instance = instance;
+    }
+
+    Context.Reset(parameters);
+    return true;
+  }
+
+  /// <summary>Dispatch to <see cref="IValueCommandState{TStateId}.OnTimeout"/> when implemented.</summary>
+  /// <param name="cmd">Command state instance.</param>
+  /// <param name="context">State context.</param>
+  /// <param name="stateName">Cached state name.</param>
+  /// <param name="logger">Run's logger, or NULL.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  internal static ValueTask OnTimeoutAsync(ICommandState<TStateId> cmd, Context<TStateId> context, string stateName, ILogger? logger)
+  {
+    if (StateMachineTelemetry.CommandTimeouts.Enabled)
+      StateMachineTelemetry.CommandTimeouts.Add(1, new KeyValuePair<string, object?>(StateMachineTelemetry.StateTag, stateName));
+
+    if (logger is not null && logger.IsEnabled(LogLevel.Information))
+      StateMachineLog.CommandTimeout(logger, stateName);
+
+    return cmd is IValueCommandState<TStateId> valueCmd ? valueCmd.OnTimeout(context) : new ValueTask(cmd.OnTimeout(context));
+  }
+
+  /// <summary>Apply the keys each region added, changed or removed, in region order.</summary>
+  /// <param name="target">Parent's bag.</param>
+  /// <param name="runs">Region runs.</param>
+  /// <param name="select">Selects the region's bag.</param>
+  /// <remarks>
+  ///   Changes are diffed against the untouched parent first (the snapshot each region was forked from),
+  ///   so a region can't undo another's change with its stale copy. A parent key missing from a region was removed by it.
+  /// </remarks>
+  private static void MergeOverlays(PropertyBag target, StateMachineRun<TStateId>[] runs, Func<Context<TStateId>, PropertyBag> select)
+  {
+    var changes = new List<(object Key, object? Value, bool IsRemoved)>();
+    foreach (var run in runs)
+    {
+      var overlay = select(run.Context);
+      foreach (var item in overlay)
+      {
+        if (!target.TryGetValue(item.Key, out var value) || !Equals(value, item.Value))
+          changes.Add((item.Key, item.Value, false));
+      }
+
+      foreach (var item in target)
+      {
+        if (!overlay.ContainsKey(item.Key))
+          changes.Add((item.Key, null, true));
+      }
+    }
+
+    foreach (var change in changes)
+    {
+      if (change.IsRemoved)
+        target.Remove(change.Key);
+      else
+        target[change.Key] = change.Value;
+    }
+  }
+
+  /// <summary>Dispatch to <see cref="IValueState{TStateId}.OnEnter"/> when implemented, otherwise wrap the <see cref="Task"/> without allocating.</summary>
+  /// <param name="state">State instance.</param>
+  /// <param name="context">State context.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  private static ValueTask OnEnterAsync(IState<TStateId> state, Context<TStateId> context) =>
+    state is IValueState<TStateId> valueState ? valueState.OnEnter(context) : new ValueTask(state.OnEnter(context));
+
+  /// <summary>Dispatch to <see cref="IValueState{TStateId}.OnEntering"/> when implemented.</summary>
+  /// <param name="state">State instance.</param>
+  /// <param name="context">State context.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  private static ValueTask OnEnteringAsync(IState<TStateId> state, Context<TStateId> context) =>
+    state is IValueState<TStateId> valueState ? valueState.OnEntering(context) : new ValueTask(state.OnEntering(context));
+
+  /// <summary>Dispatch to <see cref="IValueState{TStateId}.OnExit"/> when implemented.</summary>
+  /// <param name="state">State instance.</param>
+  /// <param name="context">State context.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  private static ValueTask OnExitAsync(IState<TStateId> state, Context<TStateId> context) =>
+    state is IValueState<TStateId> valueState ? valueState.OnExit(context) : new ValueTask(state.OnExit(context));
+
+  /// <summary>Dispatch to <see cref="IValueCommandState{TStateId}.OnMessage"/> when implemented.</summary>
+  /// <param name="cmd">Command state instance.</param>
+  /// <param name="context">State context.</param>
+  /// <param name="message">Message object.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  internal static ValueTask OnMessageAsync(ICommandState<TStateId> cmd, Context<TStateId> context, object message) =>
+    cmd is IValueCommandState<TStateId> valueCmd ? valueCmd.OnMessage(context, message) : new ValueTask(cmd.OnMessage(context, message));
+
+  /// <summary>Release a <see cref="StateLifetime.Transient"/> or <see cref="StateLifetime.Pooled"/> instance once its state is left.</summary>
+  /// <param name="reg">State registration.</param>
+  /// <param name="instance">State instance.</param>
+  /// <returns>A <see cref="ValueTask"/> representing the asynchronous operation.</returns>
+  private static ValueTask ReleaseInstanceAsync(StateRegistration<TStateId> reg, IState<TStateId> instance)
+  {
+    if (reg.Lifetime == StateLifetime.Singleton
+      || (reg.Lifetime == StateLifetime.Pooled && reg.Pool!.TryReturn(instance)))
+      return default;
+
+    // Transient, or couldn't be pooled
+    if (instance is IAsyncDisposable asyncDisposable)
+      return asyncDisposable.DisposeAsync();
+
+    (instance as IDisposable)?.Dispose();
+    return default;
+  }
+
+  /// <summary>Compares two optional state ids without boxing.</summary>
+  /// <param name="a">First State Id.</param>
+  /// <param name="b">Second State Id.</param>
+  /// <returns>True if both are NULL or hold the same value.</returns>
+  private static bool SameState(TStateId? a, TStateId? b) =>
+    a.HasValue
+      ? b.HasValue && EqualityComparer<TStateId>.Default.Equals(a.GetValueOrDefault(), b.GetValueOrDefault())
+      : !b.HasValue;
+
+  /// <summary>
+  ///   Persist the state's <see cref="Context{TStateId}.NextStates"/> overrides to its
+  ///   registration and re-resolve only the compiled transitions that changed.
+  /// </summary>
+  /// <param name="index">Node index of the state that just exited.</param>
+  /// <remarks>Changed transitions are validated here, once, so <see cref="ResolveNext"/> only tests for a sentinel.</remarks>
+  private void ApplyNextStateOverrides(int index)
+  {
+    ref var node = ref _nodes[index];
+    var next = Context.NextStates;
+
+    if (!SameState(node.OnSuccess, next.OnSuccess))
+    {
+      node.OnSuccess = next.OnSuccess;
+      node.OnSuccessIndex = ResolveOverride(index, next.OnSuccess);
+    }
+
+    if (!SameState(node.OnError, next.OnError))
+    {
+      node.OnError = next.OnError;
+      node.OnErrorIndex = ResolveOverride(index, next.OnError);
+    }
+
+    if (!SameState(node.OnFailure, next.OnFailure))
+    {
+      node.OnFailure = next.OnFailure;
+      node.OnFailureIndex = ResolveOverride(index, next.OnFailure);
+    }
+  }
+
+  /// <summary>Copy this run's context into a new overlay for a parallel region.</summary>
+  /// <returns>Region context.</returns>
+  private Context<TStateId> ForkContext()
+  {
+    var context = new Context<TStateId>(
+      currentStateId: default,
+      nextStates: new StateMap<TStateId> { OnSuccess = null, OnError = null, OnFailure = null },
+      eventAggregator: Context.EventAggregator);
+
+    foreach (var item in Context.Parameters)
+      context.Parameters[item.Key] = item.Value;
+
+    foreach (var item in Context.Errors)
+      context.Errors[item.Key] = item.Value;
+
+    return context;
+  }
+
+  /// <summary>
+  ///   Retrieves an existing state instance associated with the specified node,
+  ///   or creates and caches a new instance if none exists.
+  /// </summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <returns>The state instance corresponding to the specified node.</returns>
+  private IState<TStateId> GetOrCreateInstance(int index)
+  {
+    ref var node = ref _nodes[index];
+    var reg = node.Registration;
+    return reg.Lifetime switch
+    {
+      StateLifetime.Transient => reg.Factory(),
+      StateLifetime.Pooled => reg.Pool!.Rent(reg.Factory),
+      _ => node.Instance ??= reg.Factory(),
+    };
+  }
+
+  /// <summary>Log why a state ended the run without a decision: cancellation or <see cref="DefaultStateTimeoutMs"/>.</summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <param name="cancellationToken">Run's cancellation token.</param>
+  private void LogNoDecision(int index, CancellationToken cancellationToken)
+  {
+    if (Logger is not { } logger)
+      return;
+
+    if (cancellationToken.IsCancellationRequested)
+    {
+      if (logger.IsEnabled(LogLevel.Information))
+        StateMachineLog.StateCancelled(logger, _nodes[index].Name);
+    }
+    else if (logger.IsEnabled(LogLevel.Warning))
+    {
+      StateMachineLog.StateTimeout(logger, _nodes[index].Name, DefaultStateTimeoutMs);
+    }
+  }
+
+  /// <summary>Log a state's result and where it leads; its parent (or the end of the run) when nothing is mapped.</summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <param name="result">State's result.</param>
+  /// <param name="next">Resolved node index, or <see cref="StateNode{TStateId}.None"/>.</param>
+  private void LogTransition(int index, Result result, int next)
+  {
+    if (Logger is not { } logger || !logger.IsEnabled(LogLevel.Debug))
+      return;
+
+    var parentIndex = _nodes[index].ParentIndex;
+    var nextName = next >= 0 ? _nodes[next].Name
+      : parentIndex >= 0 ? _nodes[parentIndex].Name
+      : StateMachineLog.EndOfRun;
+
+    StateMachineLog.Transition(logger, _nodes[index].Name, result, nextName);
+  }
+
+  /// <summary>Get next state transition based on state's result.</summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <param name="result">State's returned result.</param>
+  /// <returns>Node index to go to next or <see cref="StateNode{TStateId}.None"/> to bubble-up or end state machine process.</returns>
+  /// <exception cref="UnregisteredStateTransitionException">Thrown if the mapped state identifier has not been registered.</exception>
+  private int ResolveNext(int index, Result result)
+  {
+    ref var node = ref _nodes[index];
+    var next = result switch
+    {
+      Result.Success => node.OnSuccessIndex,
+      Result.Error => node.OnErrorIndex,
+      Result.Failure => node.OnFailureIndex,
+      _ => StateNode<TStateId>.None,
+    };
+
+    // Sentinels: never registered, or a sub-state's override left its composite (registered ones were validated by the definition)
+    if (next < StateNode<TStateId>.None)
+    {
+      var stateId = result switch
+      {
+        Result.Success => node.OnSuccess,
+        Result.Error => node.OnError,
+        _ => node.OnFailure,
+      };
+
+      if (next == StateNode<TStateId>.Disjointed)
+        throw new DisjointedNextSubStateException($"Child '{node.StateId}' maps to '{stateId}', which is not a sibling under '{_nodes[node.ParentIndex].StateId}'.");
+
+      throw new UnregisteredStateTransitionException($"Next State Id '{stateId}' was not registered.");
+    }
+
+    return next;
+  }
+
+  /// <summary>Resolve a <see cref="Context{TStateId}.NextStates"/> override to its node index or an invalid-transition sentinel.</summary>
+  /// <param name="index">Node index of the overriding state.</param>
+  /// <param name="stateId">Overridden transition.</param>
+  /// <returns>Node index, <see cref="StateNode{TStateId}.None"/>, <see cref="StateNode{TStateId}.Unregistered"/> or <see cref="StateNode{TStateId}.Disjointed"/>.</returns>
+  private int ResolveOverride(int index, TStateId? stateId)
+  {
+    var next = _nodeIndex.IndexOf(stateId);
+    var parentIndex = _nodes[index].ParentIndex;
+
+    // Sub-states of a composite may only move to a sibling, and in a parallel composite only within their region
+    if (next >= 0 && parentIndex >= 0 && _nodes[parentIndex].IsCompositeParent
+      && (_nodes[next].ParentIndex != parentIndex || _nodes[next].RegionIndex != _nodes[index].RegionIndex))
+      return StateNode<TStateId>.Disjointed;
+
+    return next;
+  }
+
+  /// <summary>Run the top-level loop from the given state.</summary>
+  /// <param name="current">Node index of the first top-level state.</param>
+  /// <param name="prevStateId">Its previous State Id.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>This run.</returns>
+  private async Task<StateMachineRun<TStateId>> RunFromAsync(int current, TStateId? prevStateId, CancellationToken cancellationToken)
+  {
+    // One subscription for the whole run; command states only flip their route
+    IDisposable? routing = null;
+    if (IsMessageRoutingEnabled && _eventAggregator is not null)
+    {
+      _activeRouter = _router ??= new MessageRouter<TStateId>(_nodes.Length);
+      routing = _eventAggregator.Subscribe(_activeRouter.Publish);
+    }
+
+    try
+    {
+      while (!cancellationToken.IsCancellationRequested)
+      {
+        _nodes[current].PreviousStateId = prevStateId;
+
+        // Ensure we're always initialized
+        Context.Parameters = Context.Parameters ?? [];
+        Context.Errors = Context.Errors ?? [];
+
+        // Run any state (composite or leaf) recursively.
+        var result = await RunAnyStateRecursiveAsync(current, cancellationToken).ConfigureAwait(false);
+        if (result is null)
+          break;
+
+        var next = ResolveNext(current, result.Value);
+        LogTransition(current, result.Value, next);
+        if (next == StateNode<TStateId>.None)
+        {
+          // Completed; a checkpoint from here on resumes without entering a state
+          _position = StateNode<TStateId>.None;
+          break;
+        }
+
+        prevStateId = _nodes[current].StateId;
+        current = next;
+      }
+    }
+    finally
+    {
+      routing?.Dispose();
+      _activeRouter = null;
+      _resumePath = null;
+    }
+
+    return this;
+  }
+
+  [AsyncMethodBuilder(typeof(PoolingAsyncValueTaskMethodBuilder<>))]
+  private async ValueTask<Result?> RunAnyStateRecursiveAsync(
+    int index,
+    CancellationToken ct)
+  {
+    var reg = _nodes[index].Registration;
+
+    // Run Normal or Command State
+    if (!reg.IsCompositeParent)
+      return await RunLeafAsync(index, ct).ConfigureAwait(false);
+
+    // Composite States
+    var instance = GetOrCreateInstance(index);
+    var name = _nodes[index].Name;
+    using var activity = StateMachineTelemetry.StartState(name, isComposite: true);
+    var started = StateMachineTelemetry.StartTimer();
+    var traceStarted = Trace is not null ? _timeProvider.GetTimestamp() : 0;
+    var prevStateId = _nodes[index].PreviousStateId;
+    try
+    {
+      _position = index;
+      Context.Configure(reg.StateId, prevStateId);
+      Context.NextStates.OnSuccess = _nodes[index].OnSuccess;
+      Context.NextStates.OnError = _nodes[index].OnError;
+      Context.NextStates.OnFailure = _nodes[index].OnFailure;
+      CheckpointHandler?.Invoke(this);
+
+      await OnEnteringAsync(instance, Context).ConfigureAwait(false);
+
+      // [IsContextPersistent]
+      //  Open the Context scope AFTER OnEntering so we can give the state a chance
+      //  to purposely add new keys to and carry forward for subsequent top-level states.
+      //
+      //  Any new Context keys added via OnEnter are considered "for children consumption only".
+      //  After our OnExit, they'll be (optionally) removed by dropping the scope.
+      var parameters = Context.Parameters;
+      var errors = Context.Errors;
+      var paramScope = -1;
+      var errorScope = -1;
+      if (!IsContextPersistent && !TryTakeResumeScope(index, out paramScope, out errorScope))
+      {
+        paramScope = parameters.PushScope();
+        errorScope = errors.PushScope();
+      }
+
+      var enterStarted = StateMachineTelemetry.StartTimer();
+      await OnEnterAsync(instance, Context).ConfigureAwait(false);
+      StateMachineTelemetry.RecordDuration(StateMachineTelemetry.OnEnterDuration, enterStarted, name);
+
+      var children = _nodes[index].RegionChildIndices is { } regions
+        ? await RunRegionsAsync(index, regions, ct).ConfigureAwait(false)
+        : await RunChildrenAsync(_nodes[index].InitialChildIndex, reg.InitialChildId.GetValueOrDefault(), ct).ConfigureAwait(false);
+
+      // Cancelled or timed out inside child state
+      if (children is not { } last)
+      {
+        StateMachineTelemetry.RecordResult(activity, name, null);
+        TraceState(reg.StateId, prevStateId, null, traceStarted);
+        return null;
+      }
+
+      var lastChildStateId = last.LastChildStateId;
+      var lastChildResult = last.LastChildResult;
+
+      // Parent's OnExit decides Ok/Error/Failure; Inform parent of last child's result via Context
+      // TODO (2025-12-28 DS): Pass one Context object. Just clear "lastChildResult" after the OnExit.
+      Context.Configure(reg.StateId, prevStateId, lastChildStateId, lastChildResult);
+
+      // vNext (2025-12-28 DS): Use `OnState` handler to handle children completion instead of OnExit
+      ////await instance.OnState(Context).ConfigureAwait(false);
+      ////var parentDecision = await WaitForNextOrCancelAsync(ct).ConfigureAwait(false);
+
+      var exitStarted = StateMachineTelemetry.StartTimer();
+      await OnExitAsync(instance, Context).ConfigureAwait(false);
+      StateMachineTelemetry.RecordDuration(StateMachineTelemetry.OnExitDuration, exitStarted, name);
+
+      var parentDecision = await WaitForNextOrCancelAsync(ct).ConfigureAwait(false);
+      StateMachineTelemetry.RecordResult(activity, name, parentDecision);
+      StateMachineTelemetry.RecordDuration(StateMachineTelemetry.StateDuration, started, name);
+      TraceState(reg.StateId, prevStateId, parentDecision, traceStarted);
+
+      // Clear out the garbage pail kids
+      Context.SetLastChild(lastChildStateId: null, lastChildResult: null);
+      if (Context.RegionResults.Count > 0)
+        Context.SetRegionResults([]);
+
+      // Optionally cleanup context added by the children; giving the parent a peek at their mess.
+      if (!IsContextPersistent)
+      {
+        parameters.PopScope(paramScope);
+        errors.PopScope(errorScope);
+      }
+
+      if (parentDecision is null)
+        LogNoDecision(index, ct);
+
+      return parentDecision;
+    }
+    catch
+    {
+      // Handler (or a child's) threw; left without a decision
+      TraceState(reg.StateId, prevStateId, null, traceStarted, isFaulted: true);
+      throw;
+    }
+    finally
+    {
+      await ReleaseInstanceAsync(reg, instance).ConfigureAwait(false);
+    }
+  }
+
+  /// <summary>Run a composite's sub-states, from the initial child until one maps to NULL.</summary>
+  /// <param name="childIndex">Node index of the initial child.</param>
+  /// <param name="initialChildId">Initial child's State Id.</param>
+  /// <param name="ct">Cancellation token.</param>
+  /// <returns>Last child's outcome, or NULL if a child was cancelled or timed out.</returns>
+  /// <exception cref="UnregisteredStateTransitionException">Thrown if the initial child was not registered.</exception>
+  [AsyncMethodBuilder(typeof(PoolingAsyncValueTaskMethodBuilder<>))]
+  private async ValueTask<RegionResult<TStateId>?> RunChildrenAsync(
+    int childIndex,
+    TStateId initialChildId,
+    CancellationToken ct)
+  {
+    Result? lastChildResult = null;
+
+    // Set the initial substate's PreviousStateId to NULL, as we already know the parent.
+    TStateId? childPrevStateId = null;
+    TStateId? lastChildStateId = null;
+
+    // Resuming a checkpoint; start at the checkpointed sub-state instead of the initial child
+    if (_resumePath is { } path)
+    {
+      childIndex = path[_resumeLevel];
+      childPrevStateId = _resumePreviousIds![_resumeLevel];
+      if (++_resumeLevel == path.Length)
+        _resumePath = null;
+    }
+
+    // NOTE: The definition validated the initial child exists and belongs to this composite, if registered
+    if (childIndex == StateNode<TStateId>.Unregistered)
+      throw new UnregisteredStateTransitionException($"Next State Id '{initialChildId}' was not registered.");
+
+    // Composite Loop
+    while (!ct.IsCancellationRequested)
+    {
+      var childReg = _nodes[childIndex].Registration;
+      _nodes[childIndex].PreviousStateId = childPrevStateId;
+
+      Result? childResult;
+      if (childReg.IsCompositeParent)
+        childResult = await RunAnyStateRecursiveAsync(childIndex, ct).ConfigureAwait(false);
+      else
+        childResult = await RunLeafAsync(childIndex, ct).ConfigureAwait(false);
+
+      // Cancelled or timed out inside child state
+      if (childResult is null)
+        return null;
+
+      lastChildResult = childResult;
+      var nextChildIndex = ResolveNext(childIndex, childResult.Value);
+      LogTransition(childIndex, childResult.Value, nextChildIndex);
+
+      // NULL mapping => last child => bubble-up to parent and exit
+      if (nextChildIndex == StateNode<TStateId>.None)
+        break;
+
+      // NOTE: Siblings were validated by the definition, overrides by ApplyNextStateOverrides
+      var nextChildId = _nodes[nextChildIndex].StateId;
+
+      // Proceed to the next substate
+      childPrevStateId = childReg.StateId;
+      childIndex = nextChildIndex;
+      lastChildStateId = nextChildId;
+    }
+
+    return new RegionResult<TStateId>(initialChildId, lastChildStateId, lastChildResult);
+  }
+
+  // Rename (2015-12-28 DS): RunSingleStateAsync(...)
+  [AsyncMethodBuilder(typeof(PoolingAsyncValueTaskMethodBuilder<>))]
+  private async ValueTask<Result?> RunLeafAsync(
+    int index,
+    CancellationToken cancellationToken)
+  {
+    ref var node = ref _nodes[index];
+    var reg = node.Registration;
+    var name = node.Name;
+    IState<TStateId> instance = GetOrCreateInstance(index);
+
+    using var activity = StateMachineTelemetry.StartState(name, isComposite: false);
+    var started = StateMachineTelemetry.StartTimer();
+    var traceStarted = Trace is not null ? _timeProvider.GetTimestamp() : 0;
+
+    _position = index;
+    Context.Configure(reg.StateId, node.PreviousStateId);
+
+    // Version of this state entry; used by the subscription and timeout callbacks to ignore a re-armed signal
+    var entryVersion = Context.Signal.Version;
+    Context.NextStates.OnSuccess = node.OnSuccess;
+    Context.NextStates.OnError = node.OnError;
+    Context.NextStates.OnFailure = node.OnFailure;
+    CheckpointHandler?.Invoke(this);
+
+    CommandStateScope<TStateId> command = default;
+
+    // NOTE: Command state wiring lives in a separate method so its lambdas don't force a closure allocation on every leaf entry
+    if (instance is ICommandState<TStateId> cmd && _eventAggregator is not null)
+      command = StartCommandState(index, reg, cmd, entryVersion, cancellationToken);
+
+    try
+    {
+      await OnEnteringAsync(instance, Context).ConfigureAwait(false);
+
+      var enterStarted = StateMachineTelemetry.StartTimer();
+      await OnEnterAsync(instance, Context).ConfigureAwait(false);
+      StateMachineTelemetry.RecordDuration(StateMachineTelemetry.OnEnterDuration, enterStarted, name);
+
+      var result = await WaitForNextOrCancelAsync(cancellationToken).ConfigureAwait(false);
+      StateMachineTelemetry.RecordResult(activity, name, result);
+
+      // Let an in-flight OnTimeout/OnMessage finish before transitioning, so it can't publish into the next state
+      await command.StopAsync().ConfigureAwait(false);
+
+      // TODO (2025-12-28 DS): Potential DefaultStateTimeoutMs. Even leaving OnEnter without NextState(Result.OK), should consider calling `OnExit` to allow states to cleanup.
+      if (result is null)
+      {
+        TraceState(reg.StateId, Context.PreviousStateId, null, traceStarted);
+        LogNoDecision(index, cancellationToken);
+        return null;
+      }
+
+      var exitStarted = StateMachineTelemetry.StartTimer();
+      await OnExitAsync(instance, Context).ConfigureAwait(false);
+      StateMachineTelemetry.RecordDuration(StateMachineTelemetry.OnExitDuration, exitStarted, name);
+      StateMachineTelemetry.RecordDuration(StateMachineTelemetry.StateDuration, started, name);
+      TraceState(reg.StateId, Context.PreviousStateId, result, traceStarted);
+
+      ApplyNextStateOverrides(index);
+
+      return result.Value;
+    }
+    catch
+    {
+      TraceState(reg.StateId, Context.PreviousStateId, null, traceStarted, isFaulted: true);
+      throw;
+    }
+    finally
+    {
+      // Again on faults; an OnMessage/OnTimeout still running must not outlive the instance
+      await command.StopAsync().ConfigureAwait(false);
+      await ReleaseInstanceAsync(reg, instance).ConfigureAwait(false);
+    }
+  }
+
+  /// <summary>
+  ///   Run each region of a parallel composite concurrently on its own context overlay, then join them by the composite's <see cref="JoinPolicy"/>.
+  ///   Overlay changes (including removed keys) are merged back in region order (last region wins) and each region's outcome is set on <see cref="Context{TStateId}.RegionResults"/>.
+  /// </summary>
+  /// <param name="index">Node index of the parallel composite.</param>
+  /// <param name="regions">Node index of each region's initial child.</param>
+  /// <param name="ct">Cancellation token.</param>
+  /// <returns>Deciding region's outcome, or NULL if cancelled or a region timed out on its own.</returns>
+  private async ValueTask<RegionResult<TStateId>?> RunRegionsAsync(
+    int index,
+    int[] regions,
+    CancellationToken ct)
+  {
+    var regionIds = _nodes[index].Registration.RegionInitialChildIds!;
+    var policy = _nodes[index].JoinPolicy;
+
+    var runs = new StateMachineRun<TStateId>[regions.Length];
+    var tasks = new Task<RegionResult<TStateId>?>[regions.Length];
+    var results = new RegionResult<TStateId>[regions.Length];
+    using var joinCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+    var joinToken = joinCts.Token;
+
+    for (int r = 0; r < regions.Length; r++)
+    {
+      var run = runs[r] = new StateMachineRun<TStateId>(this, ForkContext());
+      var childIndex = regions[r];
+      var childId = regionIds[r];
+      results[r] = new RegionResult<TStateId>(childId, null, null);
+
+      // On the thread pool, so synchronous states still overlap
+      tasks[r] = Task.Run(() => run.RunChildrenAsync(childIndex, childId, joinToken).AsTask(), CancellationToken.None);
+    }
+
+    var decided = -1;
+    var aborted = false;
+    try
+    {
+      var pending = new List<Task<RegionResult<TStateId>?>>(tasks);
+      while (pending.Count > 0)
+      {
+        var done = await Task.WhenAny(pending).ConfigureAwait(false);
+        pending.Remove(done);
+
+        var outcome = await done.ConfigureAwait(false);
+        if (outcome is not { } regionResult)
+        {
+          // Timed out (or cancelled) on its own, not by the join; same as a sequential child, the composite is abandoned
+          if (!joinCts.IsCancellationRequested)
+          {
+            aborted = true;
+            joinCts.Cancel();
+          }
+
+          continue;
+        }
+
+        var r = Array.IndexOf(tasks, done);
+        results[r] = regionResult;
+
+        // NULL result: the join cancelled it before it started
+        if (decided < 0 && regionResult.LastChildResult is { } result
+          && (policy == JoinPolicy.Any || (policy == JoinPolicy.FailFast && result != Result.Success)))
+        {
+          decided = r;
+          joinCts.Cancel();
+        }
+      }
+    }
+    finally
+    {
+      // Never leave a region running; its exception (if any) was already observed above
+      joinCts.Cancel();
+      await ((Task)Task.WhenAll(tasks)).ConfigureAwait(ConfigureAwaitOptions.SuppressThrowing);
+    }
+
+    if (aborted || ct.IsCancellationRequested)
+      return null;
+
+    MergeOverlays(Context.Parameters, runs, static c => c.Parameters);
+    MergeOverlays(Context.Errors, runs, static c => c.Errors);
+    Context.SetRegionResults(results);
+
+    // JoinPolicy.All (or nothing failed): first non-success region, otherwise the last region
+    if (decided < 0)
+    {
+      decided = results.Length - 1;
+      for (int r = 0; r < results.Length; r++)
+      {
+        if (results[r].LastChildResult != Result.Success)
+        {
+          decided = r;
+          break;
+        }
+      }
+    }
+
+    return results[decided];
+  }
+
+  /// <summary>Subscribes the command state to its messages and starts its <see cref="ICommandState{TStateId}.TimeoutMs"/> timer.</summary>
+  /// <param name="index">Node index of the state.</param>
+  /// <param name="reg">State registration.</param>
+  /// <param name="cmd">Command state instance.</param>
+  /// <param name="entryVersion"><see cref="StateSignal.Version"/> of this state entry.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>Command state's subscription (or route), pump and timeout; stopped by the caller on exit.</returns>
+  private CommandStateScope<TStateId> StartCommandState(
+    int index,
+    StateRegistration<TStateId> reg,
+    ICommandState<TStateId> cmd,
+    short entryVersion,
+    CancellationToken cancellationToken)
+  {
+    var scope = default(CommandStateScope<TStateId>);
+    var signal = Context.Signal;
+
+    if (cmd is IBatchCommandState<TStateId> batchCmd)
+    {
+      // Batch states always queue; drain what's waiting into a single OnMessageBatch
+      scope.Pump = new MessagePump(
+        MessageQueueCapacity,
+        MessageQueueFullMode,
+        batchCmd.MaxBatchSize,
+        batchCmd.MaxBatchLingerMs,
+        batch => cancellationToken.IsCancellationRequested || !signal.IsPending(entryVersion)
+          ? default
+          : new ValueTask(batchCmd.OnMessageBatch(Context, batch)),
+        _timeProvider,
+        Logger,
+        _nodes[index].Name,
+        cancellationToken);
+    }
+    else if (MessageQueueCapacity > 0)
+    {
+      // Publishers only enqueue; a single consumer runs OnMessage in order
+      scope.Pump = new MessagePump(
+        MessageQueueCapacity,
+        MessageQueueFullMode,
+        msgObj => cancellationToken.IsCancellationRequested || !signal.IsPending(entryVersion)
+          ? default
+          : OnMessageAsync(cmd, Context, msgObj),
+        Logger,
+        _nodes[index].Name,
+        cancellationToken);
+    }
+
+    if (_activeRouter is not null)
+    {
+      // Already subscribed by the run; just start routing to this entry
+      scope.Route = _activeRouter.Activate(index, reg, _nodes[index].Name, cmd, Context, entryVersion, scope.Pump, Logger, cancellationToken);
+    }
+    else
+    {
+      // Apply the Highlander rule!
+      var typeSet = new HashSet<Type>();
+      foreach (var preReg in reg.SubscribedMessageTypes ?? [])
+        typeSet.Add(preReg);
+
+      foreach (var preReg in cmd.SubscribedMessageTypes ?? [])
+        typeSet.Add(preReg);
+
+      IReadOnlyCollection<Type> types = [.. typeSet];
+
+      // The following runs risk of duplicates
+      ////IReadOnlyCollection<Type> types = [.. cmd.SubscribedMessageTypes ?? [], .. reg.SubscribedMessageTypes ?? []];
+
+      if (scope.Pump is { } pump)
+      {
+        scope.Subscription = _eventAggregator!.Subscribe(pump.Enqueue, [.. types]);
+      }
+      else
+      {
+        var handlers = scope.Handlers = new InFlightMessages();
+        scope.Subscription = _eventAggregator!.Subscribe(async (msgObj) =>
+        {
+          // Entered before checking the entry, so leaving the state waits for it or it sees the state is gone
+          if (!handlers.TryEnter())
+            return;
+
+#pragma warning disable SA1501 // Statement should not be on a single line
+          // Log and swallow to avoid breaking publication loop
+          try
+          {
+            if (!cancellationToken.IsCancellationRequested && signal.IsPending(entryVersion))
+              await OnMessageAsync(cmd, Context, msgObj).ConfigureAwait(false);
+          }
+          catch (Exception ex) { StateMachineLog.OnMessageFaulted(Logger, ex, _nodes[index].Name, msgObj); }
+          finally { handlers.Exit(); }
+#pragma warning restore SA1501 // Statement should not be on a single line
+        },
+        [.. types]);   //// [.. types] == types.ToArray()
+      }
+    }
+
+    var timeoutMs = cmd.TimeoutMs ?? DefaultCommandTimeoutMs;
+    if (timeoutMs > 0)
+    {
+      // Reuse the machine's timeout unless a previous OnTimeout is somehow still running
+      if (_commandTimeout is null || !_commandTimeout.IsIdle)
+        _commandTimeout = new CommandTimeout<TStateId>();
+
+      _commandTimeout.Start(cmd, Context, entryVersion, timeoutMs, _wheel, _nodes[index].Name, Logger, cancellationToken);
+      scope.Timeout = _commandTimeout;
+    }
+
+    return scope;
+  }
+
+  /// <summary>Append the completed (or faulted) state to <see cref="Trace"/>, if enabled.</summary>
+  /// <param name="stateId">State Id.</param>
+  /// <param name="previousStateId">Previous State Id.</param>
+  /// <param name="result">State result; NULL when cancelled, timed out or faulted.</param>
+  /// <param name="started"><see cref="TimeProvider"/> timestamp the state was entered.</param>
+  /// <param name="isFaulted">One of the state's handlers threw.</param>
+  private void TraceState(TStateId stateId, TStateId? previousStateId, Result? result, long started, bool isFaulted = false)
+  {
+    if (Trace is not { } trace)
+      return;
+
+    // Timestamps are on this run's clock, which may not be the Stopwatch's
+    trace.TimestampFrequency = _timeProvider.TimestampFrequency;
+    trace.Write(new(stateId, previousStateId, result, started, _timeProvider.GetTimestamp() - started, Environment.CurrentManagedThreadId, isFaulted));
+  }
+
+  private async ValueTask WarmUpStateAsync(int index, CancellationToken cancellationToken)
+  {
+    var instance = GetOrCreateInstance(index);
+    try
+    {
+      if (instance is IWarmable warmable)
+        await warmable.WarmUpAsync(cancellationToken).ConfigureAwait(false);
+    }
+    finally
+    {
+      await ReleaseInstanceAsync(_nodes[index].Registration, instance).ConfigureAwait(false);
+    }
+  }
+
+  /// <summary>Wait for the current state's <see cref="Context{TStateId}.NextState(Result)"/>, <see cref="DefaultStateTimeoutMs"/>, or cancellation.</summary>
+  /// <param name="ct">Cancellation token.</param>
+  /// <returns>State's result, or NULL if cancelled or timed out.</returns>
+  private ValueTask<Result?> WaitForNextOrCancelAsync(CancellationToken ct)
+  {
+    // Fast-path: result was set inside OnEnter/OnExit, skip arming the timeout and cancellation entirely
+    if (Context.Signal.TryGetResult(out var result))
+      return new ValueTask<Result?>(result);
+
+    return Context.Signal.WaitAsync(DefaultStateTimeoutMs, _wheel, ct);
+  }
+}
@@ -0,0 +1,212 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Threading;
+using System.Threading.Channels;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Hosts many lightweight state machine instances sharing one <see cref="StateMachineDefinition{TStateId}"/>.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Each instance is a <see cref="StateMachineRun{TStateId}"/> owning only its context, node table (transitions, cached state instances)
+///   and command timeout; timeouts of all instances are serviced by one shared timer wheel.
+///   Instances are started on the thread pool, whose per-core queues and work stealing spread them across cores.
+/// </remarks>
+public sealed class StateMachineRuntime<TStateId>
+  where TStateId : struct, Enum
+{
+  private int _activeCount;
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachineRuntime{TStateId}"/> class.</summary>
+  /// <param name="definition">Definition every instance shares.</param>
+  public StateMachineRuntime(StateMachineDefinition<TStateId> definition)
+  {
+    ArgumentNullException.ThrowIfNull(definition);
+    Definition = definition;
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachineRuntime{TStateId}"/> class.</summary>
+  /// <param name="template">Configured machine whose current registrations and settings every instance shares.</param>
+  public StateMachineRuntime(StateMachine<TStateId> template)
+    : this((template ?? throw new ArgumentNullException(nameof(template))).BuildDefinition())
+  {
+  }
+
+  /// <summary>Gets the number of instances currently running.</summary>
+  public int ActiveCount => Volatile.Read(ref _activeCount);
+
+  /// <summary>Gets the shared definition.</summary>
+  public StateMachineDefinition<TStateId> Definition { get; }
+
+  /// <summary>Create an instance without starting it.</summary>
+  /// <param name="eventAggregator">Instance's event aggregator, or NULL to share the definition's.</param>
+  /// <param name="parameters">Optional initial context parameters.</param>
+  /// <returns>New state machine instance.</returns>
+  public StateMachineRun<TStateId> Create(IEventAggregator? eventAggregator = null, PropertyBag? parameters = null) =>
+    Definition.CreateRun(eventAggregator, parameters);
+
+  /// <summary>Run each input through its own instance, in parallel, streaming each result as its run completes.</summary>
+  /// <param name="inputs">Context parameters of each item, used as its <see cref="Context{TStateId}.Parameters"/> as-is; enumerated once.</param>
+  /// <param name="initialStateId">Initial state of every item.</param>
+  /// <param name="options">Degree of parallelism (default, processor count), scheduler and cancellation; or NULL for the defaults.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>Results in completion order; correlate them by <see cref="BatchRunResult{TStateId}.Index"/>.</returns>
+  /// <remarks>
+  ///   Completed instances are pooled and reset for later items, keeping their context, node table and singleton state instances,
+  ///   so at most twice the degree of parallelism (plus one) are ever created. A result's context is recycled once the next
+  ///   is requested; copy out what you need first. Runs are started as results are consumed, at most one ahead per worker.
+  ///   An item throwing is reported through <see cref="BatchRunResult{TStateId}.Exception"/>; the others keep running.
+  ///   Breaking out of the loop cancels the items still running.
+  /// </remarks>
+  /// <exception cref="MissingInitialStateException">Thrown if the initial state was not registered.</exception>
+  public async IAsyncEnumerable<BatchRunResult<TStateId>> RunManyAsync(
+    IEnumerable<PropertyBag> inputs,
+    TStateId initialStateId,
+    ParallelOptions? options = null,
+    [EnumeratorCancellation] CancellationToken cancellationToken = default)
+  {
+    ArgumentNullException.ThrowIfNull(inputs);
+    if (Definition.Index.IndexOf(initialStateId) < 0)
+      throw new MissingInitialStateException($"Initial state '{initialStateId}' was not registered.");
+
+    var parallelism = options is { MaxDegreeOfParallelism: > 0 } ? options.MaxDegreeOfParallelism : Environment.ProcessorCount;
+    using var cts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken, options?.CancellationToken ?? default);
+
+    // NOTE: Bounded, so workers wait on a slow consumer rather than piling up completed runs.
+    var results = Channel.CreateBounded<BatchRunResult<TStateId>>(new BoundedChannelOptions(parallelism) { SingleReader = true });
+    var idle = new ConcurrentBag<StateMachineRun<TStateId>>();
+    var workerOptions = new ParallelOptions
+    {
+      CancellationToken = cts.Token,
+      MaxDegreeOfParallelism = parallelism,
+      TaskScheduler = options?.TaskScheduler ?? TaskScheduler.Default,
+    };
+
+    var producer = Task.Run(
+      async () =>
+      {
+        try
+        {
+          await Parallel.ForEachAsync(
+            Number(inputs),
+            workerOptions,
+            async (item, ct) =>
+            {
+              var run = RentRun(idle, item.Input);
+              Exception? exception = null;
+              try
+              {
+                await RunAsync(run, initialStateId, ct).ConfigureAwait(false);
+              }
+              catch (Exception ex)
+              {
+                exception = ex;
+              }
+
+              await results.Writer.WriteAsync(new BatchRunResult<TStateId>(item.Index, run, exception), ct).ConfigureAwait(false);
+            }).ConfigureAwait(false);
+
+          results.Writer.TryComplete();
+        }
+        catch (Exception ex)
+        {
+          results.Writer.TryComplete(ex);
+        }
+      },
+      CancellationToken.None);
+
+    BatchRunResult<TStateId>? yielded = null;
+    try
+    {
+      await foreach (var result in results.Reader.ReadAllAsync(cts.Token).ConfigureAwait(false))
+      {
+        // The previous result's context is no longer needed
+        if (yielded is { IsSuccess: true } previous)
+          idle.Add(previous.Run);
+
+        yielded = result;
+        yield return result;
+      }
+    }
+    finally
+    {
+      cts.Cancel();
+      await producer.ConfigureAwait(false);
+    }
+  }
+
+  /// <summary>Create and start a passive instance, which only runs while input posted to it is processed.</summary>
+  /// <param name="initialStateId">Initial state.</param>
+  /// <param name="parameters">Optional initial context parameters.</param>
+  /// <param name="eventAggregator">Instance's event aggregator, or NULL to share the definition's.</param>
+  /// <returns>The started instance.</returns>
+  /// <remarks>Idle passive instances hold no task, timer or thread and aren't counted by <see cref="ActiveCount"/>.</remarks>
+  public StateMachineRun<TStateId> Start(
+    TStateId initialStateId,
+    PropertyBag? parameters = null,
+    IEventAggregator? eventAggregator = null)
+  {
+    var machine = Create(eventAggregator, parameters);
+    machine.Start(initialStateId);
+    return machine;
+  }
+
+  /// <summary>Create and start an instance on the thread pool.</summary>
+  /// <param name="initialStateId">Initial state.</param>
+  /// <param name="parameters">Optional initial context parameters.</param>
+  /// <param name="eventAggregator">Instance's event aggregator, or NULL to share the definition's.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>The instance, once it has run to completion.</returns>
+  public Task<StateMachineRun<TStateId>> StartAsync(
+    TStateId initialStateId,
+    PropertyBag? parameters = null,
+    IEventAggregator? eventAggregator = null,
+    CancellationToken cancellationToken = default)
+  {
+    var machine = Create(eventAggregator, parameters);
+    return Task.Run(() => RunAsync(machine, initialStateId, cancellationToken), cancellationToken);
+  }
+
+  /// <summary>Pair each input with its position in the batch.</summary>
+  /// <param name="inputs">Batch inputs.</param>
+  /// <returns>Index and input of each item.</returns>
+  private static IEnumerable<(int Index, PropertyBag Input)> Number(IEnumerable<PropertyBag> inputs)
+  {
+    var index = 0;
+    foreach (var input in inputs)
+      yield return (index++, input ?? []);
+  }
+
+  /// <summary>Take an idle, completed instance for the input, or create one.</summary>
+  /// <param name="idle">Pooled instances.</param>
+  /// <param name="parameters">Input's context parameters.</param>
+  /// <returns>Instance ready to run.</returns>
+  private StateMachineRun<TStateId> RentRun(ConcurrentBag<StateMachineRun<TStateId>> idle, PropertyBag parameters)
+  {
+    if (idle.TryTake(out var run) && run.TryReset(parameters))
+      return run;
+
+    run = Create();
+    run.Context.Parameters = parameters;
+    return run;
+  }
+
+  private async Task<StateMachineRun<TStateId>> RunAsync(StateMachineRun<TStateId> machine, TStateId initialStateId, CancellationToken cancellationToken)
+  {
+    Interlocked.Increment(ref _activeCount);
+    try
+    {
+      return await machine.RunAsync(initialStateId, cancellationToken).ConfigureAwait(false);
+    }
+    finally
+    {
+      Interlocked.Decrement(ref _activeCount);
+    }
+  }
+}
@@ -0,0 +1,147 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace Lite.StateMachine;
+
+/// <summary>Runs passive state machine instances one input at a time on a <see cref="VirtualTimeProvider"/>, so every run replays identically.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Instead of the thread pool, input posted to an instance queues it here, and the simulation drains instances in the order
+///   they became ready on the calling thread. Timeouts only fire as time is advanced, without waiting on the wall clock, so
+///   hours of timeouts run in milliseconds. States awaiting real asynchronous work are waited on, keeping the order intact.
+///   Not thread safe; post and advance from one thread.
+/// </remarks>
+public sealed class StateMachineSimulation<TStateId>
+  where TStateId : struct, Enum
+{
+  private readonly Lock _lockGate = new();
+
+  /// <summary>Instances with input waiting, in the order it arrived.</summary>
+  private readonly Queue<StateMachineRun<TStateId>> _ready = new();
+
+  private readonly List<StateMachineRun<TStateId>> _runs = [];
+
+  private readonly Action<StateMachineRun<TStateId>> _scheduleDrain;
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachineSimulation{TStateId}"/> class.</summary>
+  /// <param name="definition">Definition every instance shares.</param>
+  /// <param name="timeProvider">Simulated clock, or NULL for a new one.</param>
+  public StateMachineSimulation(StateMachineDefinition<TStateId> definition, VirtualTimeProvider? timeProvider = null)
+  {
+    ArgumentNullException.ThrowIfNull(definition);
+    Definition = definition;
+    TimeProvider = timeProvider ?? new VirtualTimeProvider();
+    _scheduleDrain = run =>
+    {
+      lock (_lockGate)
+        _ready.Enqueue(run);
+    };
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="StateMachineSimulation{TStateId}"/> class.</summary>
+  /// <param name="template">Configured machine whose current registrations and settings every instance shares.</param>
+  /// <param name="timeProvider">Simulated clock, or NULL for a new one.</param>
+  public StateMachineSimulation(StateMachine<TStateId> template, VirtualTimeProvider? timeProvider = null)
+    : this((template ?? throw new ArgumentNullException(nameof(template))).BuildDefinition(), timeProvider)
+  {
+  }
+
+  /// <summary>Gets the shared definition.</summary>
+  public StateMachineDefinition<TStateId> Definition { get; }
+
+  /// <summary>Gets a value indicating whether every started instance has completed (or faulted).</summary>
+  public bool IsCompleted
+  {
+    get
+    {
+      foreach (var run in _runs)
+      {
+        if (!run.Completion.IsCompleted)
+          return false;
+      }
+
+      return true;
+    }
+  }
+
+  /// <summary>Gets the instances started, in order.</summary>
+  public IReadOnlyList<StateMachineRun<TStateId>> Runs => _runs;
+
+  /// <summary>Gets the simulated clock.</summary>
+  public VirtualTimeProvider TimeProvider { get; }
+
+  /// <summary>Advance the clock, firing each timeout at its due time and processing what it leads to before the next.</summary>
+  /// <param name="delta">Time to advance by.</param>
+  /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="delta"/> is negative.</exception>
+  public void Advance(TimeSpan delta)
+  {
+    ArgumentOutOfRangeException.ThrowIfLessThan(delta, TimeSpan.Zero);
+
+    var until = TimeProvider.Elapsed + delta;
+    RunUntilIdle();
+    while (TimeProvider.TryFireNext(until))
+      RunUntilIdle();
+
+    TimeProvider.AdvanceTo(until);
+  }
+
+  /// <summary>Advance the clock until every instance has completed, or the limit is reached.</summary>
+  /// <param name="limit">Most time to advance by.</param>
+  /// <returns>True if every instance completed; false if one is still waiting, for input or past the limit.</returns>
+  /// <remarks>The clock stops at the last timeout processed; instances waiting on input only don't move it.</remarks>
+  public bool RunUntilComplete(TimeSpan limit)
+  {
+    ArgumentOutOfRangeException.ThrowIfLessThan(limit, TimeSpan.Zero);
+
+    var until = TimeProvider.Elapsed + limit;
+    RunUntilIdle();
+    while (!IsCompleted && TimeProvider.TryFireNext(until))
+      RunUntilIdle();
+
+    return IsCompleted;
+  }
+
+  /// <summary>Process posted input, and whatever it leads to, without advancing the clock.</summary>
+  /// <returns>Number of drains run.</returns>
+  public int RunUntilIdle()
+  {
+    var drains = 0;
+    while (TryDequeue(out var run))
+    {
+      // NOTE: Never faults; blocks only while a state awaits real (not simulated) work.
+      run.DrainAsync().GetAwaiter().GetResult();
+      drains++;
+    }
+
+    return drains;
+  }
+
+  /// <summary>Create and start a passive instance on the simulated clock; its initial state is entered by the next <see cref="RunUntilIdle"/>.</summary>
+  /// <param name="initialStateId">Initial state.</param>
+  /// <param name="parameters">Optional initial context parameters.</param>
+  /// <param name="eventAggregator">Instance's event aggregator, or NULL to share the definition's.</param>
+  /// <returns>The started instance; post input to it as with <see cref="StateMachineRuntime{TStateId}.Start"/>.</returns>
+  /// <exception cref="MissingInitialStateException">Thrown if the initial state was not registered.</exception>
+  public StateMachineRun<TStateId> Start(
+    TStateId initialStateId,
+    PropertyBag? parameters = null,
+    IEventAggregator? eventAggregator = null)
+  {
+    var run = Definition.CreateRun(eventAggregator, parameters);
+    run.TimeProvider = TimeProvider;
+    run.ScheduleDrain = _scheduleDrain;
+    run.Start(initialStateId);
+    _runs.Add(run);
+    return run;
+  }
+
+  private bool TryDequeue(out StateMachineRun<TStateId> run)
+  {
+    lock (_lockGate)
+      return _ready.TryDequeue(out run!);
+  }
+}
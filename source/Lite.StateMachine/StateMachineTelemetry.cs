@@ -0,0 +1,106 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+
+namespace Lite.StateMachine;
+
+/// <summary>
+///   Built-in <see cref="ActivitySource"/> and <see cref="Meter"/>, both named <see cref="Name"/>, for OpenTelemetry and <c>dotnet-counters</c>.
+///   Nothing is measured or allocated unless a listener is attached.
+/// </summary>
+/// <remarks>
+///   Spans: one per state and composite (tagged <see cref="StateTag"/>, <see cref="ResultTag"/>, <see cref="CompositeTag"/>).
+///   Metrics: <c>lite.statemachine.transitions</c>, <c>.state.duration</c>, <c>.state.on_enter.duration</c>,
+///   <c>.state.on_exit.duration</c>, <c>.command.timeouts</c> and <c>.command.queue.depth</c>.
+///   Example: <c>dotnet-counters monitor -n MyApp --counters Lite.StateMachine</c>.
+/// </remarks>
+public static class StateMachineTelemetry
+{
+  /// <summary>Activity source and meter name.</summary>
+  public const string Name = "Lite.StateMachine";
+
+  /// <summary>Tag set on composite state spans.</summary>
+  public const string CompositeTag = "lite.statemachine.composite";
+
+  /// <summary>Tag holding the state's <see cref="Result"/>.</summary>
+  public const string ResultTag = "lite.statemachine.result";
+
+  /// <summary>Tag holding the State Id.</summary>
+  public const string StateTag = "lite.statemachine.state";
+
+  internal static readonly ActivitySource Source = new(Name);
+
+  internal static readonly Meter Meter = new(Name);
+
+  internal static readonly Counter<long> Transitions = Meter.CreateCounter<long>("lite.statemachine.transitions", "{transition}", "State results, by state and result.");
+
+  internal static readonly Histogram<double> StateDuration = Meter.CreateHistogram<double>("lite.statemachine.state.duration", "s", "Time spent in a state, from entering until exited.");
+
+  internal static readonly Histogram<double> OnEnterDuration = Meter.CreateHistogram<double>("lite.statemachine.state.on_enter.duration", "s", "Duration of the state's OnEnter.");
+
+  internal static readonly Histogram<double> OnExitDuration = Meter.CreateHistogram<double>("lite.statemachine.state.on_exit.duration", "s", "Duration of the state's OnExit.");
+
+  internal static readonly Counter<long> CommandTimeouts = Meter.CreateCounter<long>("lite.statemachine.command.timeouts", "{timeout}", "Command states that timed out.");
+
+  internal static readonly Histogram<long> QueueDepth = Meter.CreateHistogram<long>("lite.statemachine.command.queue.depth", "{message}", "Command state messages waiting when the queue is read, by state.");
+
+  /// <summary>Start a timer if any duration is listened to.</summary>
+  /// <returns>Timestamp, or 0 when not timing.</returns>
+  internal static long StartTimer() =>
+    StateDuration.Enabled || OnEnterDuration.Enabled || OnExitDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+
+  /// <summary>Record the elapsed time since <paramref name="startTimestamp"/>.</summary>
+  /// <param name="histogram">Duration histogram.</param>
+  /// <param name="startTimestamp">Timestamp from <see cref="StartTimer"/>.</param>
+  /// <param name="stateName">State name.</param>
+  internal static void RecordDuration(Histogram<double> histogram, long startTimestamp, string stateName)
+  {
+    if (startTimestamp != 0 && histogram.Enabled)
+      histogram.Record(Stopwatch.GetElapsedTime(startTimestamp).TotalSeconds, new KeyValuePair<string, object?>(StateTag, stateName));
+  }
+
+  /// <summary>Count the state's result and tag its span.</summary>
+  /// <param name="activity">State's span, if sampled.</param>
+  /// <param name="stateName">State name.</param>
+  /// <param name="result">State result; NULL when cancelled or timed out.</param>
+  internal static void RecordResult(Activity? activity, string stateName, Result? result)
+  {
+    if (result is null)
+    {
+      activity?.SetStatus(ActivityStatusCode.Error, "Cancelled or timed out");
+      return;
+    }
+
+    var resultName = result.GetValueOrDefault() switch
+    {
+      Result.Success => "success",
+      Result.Error => "error",
+      _ => "failure",
+    };
+
+    activity?.SetTag(ResultTag, resultName);
+
+    if (Transitions.Enabled)
+      Transitions.Add(1, new KeyValuePair<string, object?>(StateTag, stateName), new KeyValuePair<string, object?>(ResultTag, resultName));
+  }
+
+  /// <summary>Start a span for a state, if anyone is listening.</summary>
+  /// <param name="stateName">State name.</param>
+  /// <param name="isComposite">Is composite parent state.</param>
+  /// <returns>Span or NULL.</returns>
+  internal static Activity? StartState(string stateName, bool isComposite)
+  {
+    var activity = Source.StartActivity(stateName);
+    if (activity is { IsAllDataRequested: true })
+    {
+      activity.SetTag(StateTag, stateName);
+      if (isComposite)
+        activity.SetTag(CompositeTag, true);
+    }
+
+    return activity;
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+
+namespace Lite.StateMachine;
+
+/// <summary>Compiled, array-indexed form of a <see cref="StateRegistration{TStateId}"/> used by the transition loop.</summary>
+/// <typeparam name="TStateId">State Id.</typeparam>
+/// <remarks>
+///   All state references are indices into the compiled node table so the hot loop never hashes or boxes a <typeparamref name="TStateId"/>.
+///   Negative indices are sentinels, see <see cref="None"/> and <see cref="Unregistered"/>.
+///   Runtime changes (instance, <c>NextStates</c> overrides, previous state) live here, never on the shared registration,
+///   so each <see cref="StateMachineRun{TStateId}"/> owns a copy of the definition's table.
+/// </remarks>
+internal struct StateNode<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>No state (i.e. NULL transition, no parent, no initial child).</summary>
+  public const int None = -1;
+
+  /// <summary>State Id was provided but never registered with the machine.</summary>
+  public const int Unregistered = -2;
+
+  /// <summary>Sub-state's <c>NextStates</c> override targets a state outside its composite.</summary>
+  public const int Disjointed = -3;
+
+#pragma warning disable SA1401 // Fields should be private
+
+  /// <summary>Index of the initial child state (composite parents only).</summary>
+  public int InitialChildIndex;
+
+  /// <summary>Cached state instance (lazy-loaded on first entry).</summary>
+  public IState<TStateId>? Instance;
+
+  /// <summary>Is composite parent state.</summary>
+  public bool IsCompositeParent;
+
+  /// <summary>How the regions are joined (parallel composites only).</summary>
+  public JoinPolicy JoinPolicy;
+
+  /// <summary>State name for telemetry, formatted once.</summary>
+  public string Name;
+
+  /// <summary>OnError transition, including overrides from <see cref="Context{TStateId}.NextStates"/>.</summary>
+  public TStateId? OnError;
+
+  /// <summary>Index of the OnError transition.</summary>
+  public int OnErrorIndex;
+
+  /// <summary>OnFailure transition, including overrides.</summary>
+  public TStateId? OnFailure;
+
+  /// <summary>Index of the OnFailure transition.</summary>
+  public int OnFailureIndex;
+
+  /// <summary>OnSuccess transition, including overrides.</summary>
+  public TStateId? OnSuccess;
+
+  /// <summary>Index of the OnSuccess transition.</summary>
+  public int OnSuccessIndex;
+
+  /// <summary>Index of the composite parent state.</summary>
+  public int ParentIndex;
+
+  /// <summary>Previous State Id we transitioned from.</summary>
+  public TStateId? PreviousStateId;
+
+  /// <summary>Index of each region's initial child (parallel composites only), otherwise NULL.</summary>
+  public int[]? RegionChildIndices;
+
+  /// <summary>Region of the parallel composite this sub-state belongs to, otherwise <see cref="None"/>.</summary>
+  public int RegionIndex;
+
+  /// <summary>Source registration.</summary>
+  public StateRegistration<TStateId> Registration;
+
+  /// <summary>State Id.</summary>
+  public TStateId StateId;
+
+#pragma warning restore SA1401 // Fields should be private
+}
@@ -0,0 +1,64 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+
+namespace Lite.StateMachine;
+
+/// <summary>Instance pool of a <see cref="StateLifetime.Pooled"/> registration.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>Same shape as <c>DefaultObjectPool</c>: one fast slot in front of a bounded queue.</remarks>
+internal sealed class StatePool<TStateId>
+  where TStateId : struct, Enum
+{
+  private readonly ConcurrentQueue<IState<TStateId>> _items = new();
+  private readonly int _maxRetained;
+
+  private int _count;
+  private IState<TStateId>? _fastItem;
+
+  /// <summary>Initializes a new instance of the <see cref="StatePool{TStateId}"/> class.</summary>
+  /// <param name="maxRetained">Maximum instances kept, including the fast slot.</param>
+  public StatePool(int maxRetained) => _maxRetained = maxRetained - 1;
+
+  /// <summary>Rent a pooled instance, or create one.</summary>
+  /// <param name="factory">State factory.</param>
+  /// <returns>State instance.</returns>
+  public IState<TStateId> Rent(Func<IState<TStateId>> factory)
+  {
+    var item = _fastItem;
+    if (item is not null && Interlocked.CompareExchange(ref _fastItem, null, item) == item)
+      return item;
+
+    if (_items.TryDequeue(out item))
+    {
+      Interlocked.Decrement(ref _count);
+      return item;
+    }
+
+    return factory();
+  }
+
+  /// <summary>Reset and return an instance.</summary>
+  /// <param name="item">State instance.</param>
+  /// <returns>True if pooled; false if it failed to reset or the pool is full, so the caller should dispose it.</returns>
+  public bool TryReturn(IState<TStateId> item)
+  {
+    if (item is IResettableState resettable && !resettable.TryReset())
+      return false;
+
+    if (_fastItem is null && Interlocked.CompareExchange(ref _fastItem, item, null) is null)
+      return true;
+
+    if (Interlocked.Increment(ref _count) <= _maxRetained)
+    {
+      _items.Enqueue(item);
+      return true;
+    }
+
+    Interlocked.Decrement(ref _count);
+    return false;
+  }
+}
@@ -7,6 +7,7 @@ namespace Lite.StateMachine;
 
 /// <summary>State registration class for lazy-loading.</summary>
 /// <typeparam name="TStateId">State Id.</typeparam>
+/// <remarks>Immutable once registered; shared by every <see cref="StateMachineRun{TStateId}"/> of a definition.</remarks>
 internal sealed class StateRegistration<TStateId>
   where TStateId : struct, Enum
 {
@@ -20,20 +21,29 @@ internal sealed class StateRegistration<TStateId>
   /// <summary>Gets a value indicating whether this is a composite parent state or not.</summary>
   public bool IsCompositeParent { get; init; }
 
-  /// <summary>Gets or sets an optional auto-wire OnError StateId transition.</summary>
-  public TStateId? OnError { get; set; } = null;
+  /// <summary>Gets how the regions are joined (parallel composites only).</summary>
+  public JoinPolicy JoinPolicy { get; init; }
 
-  /// <summary>Gets or sets an optional auto-wire OnFailure StateId transition.</summary>
-  public TStateId? OnFailure { get; set; } = null;
+  /// <summary>Gets the instance lifetime.</summary>
+  public StateLifetime Lifetime { get; init; } = StateLifetime.Singleton;
 
-  /// <summary>Gets or sets an optional auto-wire OnSuccess StateId transition.</summary>
-  public TStateId? OnSuccess { get; set; } = null;
+  /// <summary>Gets an optional auto-wire OnError StateId transition.</summary>
+  public TStateId? OnError { get; init; } = null;
+
+  /// <summary>Gets an optional auto-wire OnFailure StateId transition.</summary>
+  public TStateId? OnFailure { get; init; } = null;
+
+  /// <summary>Gets an optional auto-wire OnSuccess StateId transition.</summary>
+  public TStateId? OnSuccess { get; init; } = null;
 
   /// <summary>Gets the sub-state's parent State Id (optional).</summary>
   public TStateId? ParentId { get; init; }
 
-  /// <summary>Gets or sets the Previous <typeparamref name="TStateId"/> we transitioned from.</summary>
-  public TStateId? PreviousStateId { get; set; }
+  /// <summary>Gets each region's initial child (parallel composites only); the first is also <see cref="InitialChildId"/>.</summary>
+  public TStateId[]? RegionInitialChildIds { get; init; }
+
+  /// <summary>Gets the instance pool (<see cref="StateLifetime.Pooled"/> only).</summary>
+  public StatePool<TStateId>? Pool { get; init; }
 
   /// <summary>Gets the State Id, used by ExportUml for <see cref="RegisterState{TStateClass}(TStateId, TStateId?, TStateId?, TStateId?, Action{StateMachine{TStateId}}?)"./> .</summary>
   public TStateId StateId { get; init; }
@@ -0,0 +1,151 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+using System.Threading.Tasks.Sources;
+
+namespace Lite.StateMachine;
+
+/// <summary>
+///   Reusable, resettable completion signal for a state's <see cref="Result"/>.
+///   Replaces allocating a <see cref="TaskCompletionSource{TResult}"/>, linked <see cref="CancellationTokenSource"/>
+///   and <see cref="Task.Delay(int, CancellationToken)"/> on every state transition; timeouts use the run's <see cref="TimerWheel"/>.
+/// </summary>
+/// <remarks>
+///   A NULL result denotes the state was cancelled or timed out (<see cref="IStateMachine{TStateId}.DefaultStateTimeoutMs"/>).
+///   Only the first result per <see cref="Reset"/> is accepted; subsequent calls are ignored, same as <c>TrySetResult</c>.
+/// </remarks>
+internal sealed class StateSignal : TimerWheel.Entry, IValueTaskSource<Result?>
+{
+  private readonly Lock _lockGate = new();
+
+  /// <summary>Version the timeout timer was armed for, so a late tick can't time out the next state.</summary>
+  private short _armedVersion;
+
+  private CancellationTokenRegistration _cancelRegistration;
+
+  private ManualResetValueTaskSourceCore<Result?> _core = new() { RunContinuationsAsynchronously = true };
+
+  /// <summary>A result was accepted for this entry; written under <see cref="_lockGate"/>.</summary>
+  private volatile bool _isClaimed;
+
+  /// <summary>The accepted result was set on <see cref="_core"/>; published only after it completes.</summary>
+  private volatile bool _isSet;
+
+  /// <summary>Gets a value indicating whether a result has been set since the last <see cref="Reset"/>.</summary>
+  public bool IsCompleted => _isSet;
+
+  /// <summary>Gets the current signal version (changes on every <see cref="Reset"/>).</summary>
+  public short Version => _core.Version;
+
+  /// <inheritdoc/>
+  public Result? GetResult(short token)
+  {
+    // Disarm before handing back the result so the next state starts clean
+    _cancelRegistration.Dispose();
+    _cancelRegistration = default;
+    if (IsArmed)
+      TryDisarm();
+
+    return _core.GetResult(token);
+  }
+
+  /// <inheritdoc/>
+  public ValueTaskSourceStatus GetStatus(short token) => _core.GetStatus(token);
+
+  /// <summary>Gets a value indicating whether the signal is still waiting on a result for the given version.</summary>
+  /// <param name="version">Version captured at state entry.</param>
+  /// <returns>True if still pending; false as soon as a result is accepted, even before it's published.</returns>
+  public bool IsPending(short version) => !_isClaimed && version == _core.Version;
+
+  /// <inheritdoc/>
+  public void OnCompleted(Action<object?> continuation, object? state, short token, ValueTaskSourceOnCompletedFlags flags) =>
+    _core.OnCompleted(continuation, state, token, flags);
+
+  /// <summary>Re-arm the signal for the next state entry.</summary>
+  public void Reset()
+  {
+    lock (_lockGate)
+    {
+      _core.Reset();
+      _isClaimed = false;
+      _isSet = false;
+    }
+  }
+
+  /// <summary>Set the state's result, if one has not already been set for this entry.</summary>
+  /// <param name="result">State result, or NULL for cancelled/timed out.</param>
+  /// <returns>True if the result was accepted.</returns>
+  public bool TrySetResult(Result? result)
+  {
+    lock (_lockGate)
+    {
+      if (_isClaimed)
+        return false;
+
+      _isClaimed = true;
+      _core.SetResult(result);
+      _isSet = true;
+      return true;
+    }
+  }
+
+  /// <summary>Gets the result without waiting, when it was already set (i.e. by <c>NextState</c> inside <c>OnEnter</c>).</summary>
+  /// <param name="result">State's result.</param>
+  /// <returns>True if the result was already set; nothing is armed or registered.</returns>
+  public bool TryGetResult(out Result? result)
+  {
+    if (!_isSet)
+    {
+      result = null;
+      return false;
+    }
+
+    result = _core.GetResult(_core.Version);
+    return true;
+  }
+
+  /// <summary>Wait for the state's result, its timeout, or cancellation.</summary>
+  /// <param name="timeoutMs">Timeout in milliseconds or <see cref="Timeout.Infinite"/>.</param>
+  /// <param name="wheel">Wheel timing the timeout.</param>
+  /// <param name="cancellationToken">Cancellation token.</param>
+  /// <returns>State's result or NULL if cancelled or timed out.</returns>
+  public ValueTask<Result?> WaitAsync(int timeoutMs, TimerWheel wheel, CancellationToken cancellationToken)
+  {
+    var version = _core.Version;
+
+    if (!_isSet)
+    {
+      if (cancellationToken.CanBeCanceled)
+        _cancelRegistration = cancellationToken.UnsafeRegister(static s => ((StateSignal)s!).TrySetResult(null), this);
+
+      if (timeoutMs == 0)
+      {
+        TrySetResult(null);
+      }
+      else if (timeoutMs > 0)
+      {
+        _armedVersion = version;
+        wheel.Arm(this, timeoutMs);
+      }
+    }
+
+    return new ValueTask<Result?>(this, version);
+  }
+
+  /// <inheritdoc/>
+  protected internal override void OnExpired()
+  {
+    lock (_lockGate)
+    {
+      if (_isClaimed || _armedVersion != _core.Version)
+        return;
+
+      _isClaimed = true;
+      _core.SetResult(null);
+      _isSet = true;
+    }
+  }
+}
@@ -0,0 +1,207 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+namespace Lite.StateMachine;
+
+/// <summary>Hashed timer wheel servicing state and command timeouts for every machine in the process.</summary>
+/// <remarks>
+///   Arming and disarming links/unlinks a reusable <see cref="Entry"/> in a slot, O(1) with no allocation.
+///   A single timer ticks every <see cref="TickMs"/> while anything is armed, so timeouts fire
+///   at tick resolution (never early, up to one tick late).
+///   Each <see cref="TimeProvider"/> gets one wheel (<see cref="For"/>); a virtual clock turns it as it's advanced.
+/// </remarks>
+internal sealed class TimerWheel
+{
+  /// <summary>Tick resolution in milliseconds.</summary>
+  public const int TickMs = 10;
+
+  /// <summary>Number of slots; one revolution covers <c>SlotCount * TickMs</c>, longer timeouts wait for later revolutions.</summary>
+  private const int SlotCount = 512;
+
+  private const int SlotMask = SlotCount - 1;
+
+  /// <summary>Wheels of custom time providers, kept for as long as their provider lives.</summary>
+  private static readonly ConditionalWeakTable<TimeProvider, TimerWheel> Wheels = [];
+
+  private readonly Lock _lockGate = new();
+  private readonly Entry?[] _slots = new Entry?[SlotCount];
+  private readonly ITimer _timer;
+  private readonly TimeProvider _timeProvider;
+  private readonly long _timestampsPerMs;
+
+  private int _armedCount;
+
+  /// <summary>Ticks processed so far.</summary>
+  private long _currentTick;
+
+  /// <summary>Clock milliseconds where tick 0 would have been, re-based when the wheel restarts from idle.</summary>
+  private long _originMs;
+
+  private bool _running;
+
+  /// <summary>Initializes a new instance of the <see cref="TimerWheel"/> class.</summary>
+  /// <param name="timeProvider">Clock and timer source.</param>
+  public TimerWheel(TimeProvider timeProvider)
+  {
+    _timeProvider = timeProvider;
+    _timestampsPerMs = Math.Max(1, timeProvider.TimestampFrequency / 1000);
+
+    // Don't capture whichever caller's ExecutionContext happens to create the wheel
+    using (ExecutionContext.SuppressFlow())
+      _timer = timeProvider.CreateTimer(static s => ((TimerWheel)s!).OnTick(), this, Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+  }
+
+  /// <summary>Gets the process-wide wheel, on <see cref="TimeProvider.System"/>.</summary>
+  public static TimerWheel Shared { get; } = new(TimeProvider.System);
+
+  /// <summary>Gets the wheel of a time provider.</summary>
+  /// <param name="timeProvider">Clock and timer source.</param>
+  /// <returns><see cref="Shared"/> for the system clock, otherwise the provider's own wheel.</returns>
+  public static TimerWheel For(TimeProvider timeProvider) =>
+    ReferenceEquals(timeProvider, TimeProvider.System)
+      ? Shared
+      : Wheels.GetValue(timeProvider, static p => new TimerWheel(p));
+
+  /// <summary>Arm (or re-arm) an entry to expire after the given time.</summary>
+  /// <param name="entry">Entry to arm.</param>
+  /// <param name="timeoutMs">Milliseconds until expiry (&gt;= 0).</param>
+  public void Arm(Entry entry, int timeoutMs)
+  {
+    lock (_lockGate)
+    {
+      if (entry.IsArmed)
+        Unlink(entry);
+
+      // Rounded up, so a fraction of a millisecond can't make it early
+      var nowMs = (_timeProvider.GetTimestamp() + _timestampsPerMs - 1) / _timestampsPerMs;
+      if (!_running)
+      {
+        _originMs = nowMs - (_currentTick * TickMs);
+        _running = true;
+        _timer.Change(TimeSpan.FromMilliseconds(TickMs), TimeSpan.FromMilliseconds(TickMs));
+      }
+
+      // From the clock rather than the last tick processed, which may be a partial or several late ticks behind
+      var deadlineTick = (nowMs - _originMs + timeoutMs + TickMs - 1) / TickMs;
+      entry.DeadlineTick = Math.Max(_currentTick + 1, deadlineTick);
+      Link(entry, (int)(entry.DeadlineTick & SlotMask));
+    }
+  }
+
+  /// <summary>Disarm an entry.</summary>
+  /// <param name="entry">Entry to disarm.</param>
+  /// <returns>True if it was armed and will not fire; false if not armed or already fired.</returns>
+  public bool Disarm(Entry entry)
+  {
+    lock (_lockGate)
+    {
+      if (!entry.IsArmed)
+        return false;
+
+      Unlink(entry);
+      return true;
+    }
+  }
+
+  private void Link(Entry entry, int slot)
+  {
+    var head = _slots[slot];
+    entry.Slot = slot;
+    entry.Wheel = this;
+    entry.Prev = null;
+    entry.Next = head;
+    if (head is not null)
+      head.Prev = entry;
+
+    _slots[slot] = entry;
+    _armedCount++;
+  }
+
+  private void OnTick()
+  {
+    lock (_lockGate)
+    {
+      if (!_running)
+        return;
+
+      // Catch up on ticks the timer was late for
+      var targetTick = (NowMs() - _originMs) / TickMs;
+      while (_currentTick < targetTick && _armedCount > 0)
+      {
+        _currentTick++;
+
+        var entry = _slots[(int)(_currentTick & SlotMask)];
+        while (entry is not null)
+        {
+          var next = entry.Next;
+          if (entry.DeadlineTick <= _currentTick)
+          {
+            Unlink(entry);
+
+#pragma warning disable SA1501 // Statement should not be on a single line
+            // Swallow to keep the wheel turning
+            try { entry.OnExpired(); } catch { }
+#pragma warning restore SA1501 // Statement should not be on a single line
+          }
+
+          entry = next;
+        }
+      }
+
+      if (_armedCount == 0)
+      {
+        // Idle; stop ticking until the next Arm
+        _currentTick = Math.Max(_currentTick, targetTick);
+        _running = false;
+        _timer.Change(Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+      }
+    }
+  }
+
+  private long NowMs() => _timeProvider.GetTimestamp() / _timestampsPerMs;
+
+  private void Unlink(Entry entry)
+  {
+    if (entry.Prev is not null)
+      entry.Prev.Next = entry.Next;
+    else
+      _slots[entry.Slot] = entry.Next;
+
+    if (entry.Next is not null)
+      entry.Next.Prev = entry.Prev;
+
+    entry.Prev = null;
+    entry.Next = null;
+    entry.Slot = -1;
+    _armedCount--;
+  }
+
+  /// <summary>Reusable timer wheel node.</summary>
+  /// <remarks><see cref="OnExpired"/> runs on the wheel's thread while it holds its lock; keep it short and non-blocking.</remarks>
+  internal abstract class Entry
+  {
+#pragma warning disable SA1401 // Fields should be private
+    internal long DeadlineTick;
+    internal Entry? Next;
+    internal Entry? Prev;
+    internal int Slot = -1;
+
+    /// <summary>Wheel the entry was last armed on.</summary>
+    internal TimerWheel? Wheel;
+#pragma warning restore SA1401 // Fields should be private
+
+    /// <summary>Gets a value indicating whether the entry is linked into the wheel.</summary>
+    internal bool IsArmed => Slot >= 0;
+
+    /// <summary>Disarm the entry from the wheel it was armed on.</summary>
+    /// <returns>True if it was armed and will not fire; false if not armed or already fired.</returns>
+    internal bool TryDisarm() => Wheel is { } wheel && wheel.Disarm(this);
+
+    /// <summary>Called once when the entry expires.</summary>
+    protected internal abstract void OnExpired();
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Lite.StateMachine;
+
+/// <summary>One completed (or faulted) state in a <see cref="TransitionTrace{TStateId}"/>.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Unmanaged with a fixed field order, so a trace can be dumped as raw (native-endian) bytes:
+///   <code>
+///     0  long  Timestamp
+///     8  long  Duration
+///     16 int   ThreadId
+///     20 byte  Result (valid when HasResult)
+///     21 byte  Flags; 1 = HasResult, 2 = HasPreviousStateId, 4 = IsFaulted
+///     22 TStateId StateId, then TStateId PreviousStateId (valid when HasPreviousStateId)
+///   </code>
+///   The State Ids are aligned to their underlying type's size (an <c>int</c> enum starts at 24, for a 32 byte record),
+///   and the struct is padded to 8 bytes; <see cref="TransitionTrace{TStateId}.RecordSize"/> is the exact size.
+/// </remarks>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct TransitionRecord<TStateId>
+  where TStateId : struct, Enum
+{
+  private const byte FaultedFlag = 4;
+  private const byte HasPreviousFlag = 2;
+  private const byte HasResultFlag = 1;
+
+  // NOTE: Declaration order is the binary layout; don't reorder.
+  private readonly long _timestamp;
+  private readonly long _duration;
+  private readonly int _threadId;
+  private readonly byte _result;
+  private readonly byte _flags;
+  private readonly TStateId _stateId;
+  private readonly TStateId _previousStateId;
+
+  /// <summary>Initializes a new instance of the <see cref="TransitionRecord{TStateId}"/> struct.</summary>
+  /// <param name="stateId">State Id.</param>
+  /// <param name="previousStateId">Previous State Id, if any.</param>
+  /// <param name="result">State result; NULL when cancelled, timed out or faulted.</param>
+  /// <param name="timestamp">State entry <see cref="TimeProvider"/> timestamp.</param>
+  /// <param name="duration">Time in the state, in <see cref="TimeProvider"/> timestamp ticks.</param>
+  /// <param name="threadId">Managed thread the state completed on.</param>
+  /// <param name="isFaulted">The state was left by an exception from one of its handlers.</param>
+  public TransitionRecord(TStateId stateId, TStateId? previousStateId, Result? result, long timestamp, long duration, int threadId, bool isFaulted = false)
+  {
+    _timestamp = timestamp;
+    _duration = duration;
+    _threadId = threadId;
+    _result = (byte)result.GetValueOrDefault();
+    _flags = (byte)((result.HasValue ? HasResultFlag : 0) | (previousStateId.HasValue ? HasPreviousFlag : 0) | (isFaulted ? FaultedFlag : 0));
+    _stateId = stateId;
+    _previousStateId = previousStateId.GetValueOrDefault();
+  }
+
+  /// <summary>Gets the time spent in the state, in ticks of <see cref="TransitionTrace{TStateId}.TimestampFrequency"/>.</summary>
+  public long Duration => _duration;
+
+  /// <summary>Gets a value indicating whether the state was left by an exception from one of its handlers.</summary>
+  public bool IsFaulted => (_flags & FaultedFlag) != 0;
+
+  /// <summary>Gets the previous State Id, if any.</summary>
+  public TStateId? PreviousStateId => (_flags & HasPreviousFlag) != 0 ? _previousStateId : null;
+
+  /// <summary>Gets the state's result; NULL when cancelled, timed out or faulted.</summary>
+  public Result? Result => (_flags & HasResultFlag) != 0 ? (Result)_result : null;
+
+  /// <summary>Gets the State Id.</summary>
+  public TStateId StateId => _stateId;
+
+  /// <summary>Gets the managed thread id the state completed on.</summary>
+  public int ThreadId => _threadId;
+
+  /// <summary>Gets the <see cref="TimeProvider"/> timestamp the state was entered.</summary>
+  public long Timestamp => _timestamp;
+}
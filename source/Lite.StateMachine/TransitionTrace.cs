@@ -0,0 +1,163 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.IO;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Lite.StateMachine;
+
+/// <summary>Opt-in, fixed-size ring of the last completed (or faulted) states, for post-mortem dumps.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+/// <remarks>
+///   Writing is lock-free and allocation-free; once full, the oldest records are overwritten.
+///   Readers may snapshot while a machine is running; a record being overwritten at that moment is skipped.
+/// </remarks>
+/// <example><![CDATA[
+///   machine.Trace = new TransitionTrace<StateId>(256);
+///   ...
+///   catch { machine.Trace.WriteTo(File.Create("trace.bin")); }
+/// ]]></example>
+public sealed class TransitionTrace<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Binary format magic, "LSMT".</summary>
+  public const uint Magic = 0x544D534C;
+
+  /// <summary>Binary format version; 2 is the <see cref="TransitionRecord{TStateId}"/> layout with flags.</summary>
+  public const ushort FormatVersion = 2;
+
+  /// <summary>Binary header size; magic, version, record size, record count and the <see cref="TimestampFrequency"/>.</summary>
+  public const int HeaderSize = 4 + 2 + 2 + 4 + 8;
+
+  private readonly long _mask;
+  private readonly Slot[] _slots;
+
+  /// <summary>Records written since creation.</summary>
+  private long _written;
+
+  /// <summary>Initializes a new instance of the <see cref="TransitionTrace{TStateId}"/> class.</summary>
+  /// <param name="capacity">Records to keep; rounded up to a power of two.</param>
+  public TransitionTrace(int capacity = 256)
+  {
+    ArgumentOutOfRangeException.ThrowIfNegativeOrZero(capacity);
+    ArgumentOutOfRangeException.ThrowIfGreaterThan(capacity, 1 << 30);
+
+    _slots = new Slot[(int)BitOperations.RoundUpToPowerOf2((uint)capacity)];
+    _mask = _slots.Length - 1;
+  }
+
+  /// <summary>Gets or sets the number of record timestamp ticks per second; defaults to <see cref="System.Diagnostics.Stopwatch.Frequency"/>.</summary>
+  /// <remarks>Set by the run to its <see cref="TimeProvider.TimestampFrequency"/> as it writes, so a virtual clock's dump reads correctly.</remarks>
+  public long TimestampFrequency { get; set; } = System.Diagnostics.Stopwatch.Frequency;
+
+  /// <summary>Gets the number of records kept.</summary>
+  public int Capacity => _slots.Length;
+
+  /// <summary>Gets the number of records currently held (at most <see cref="Capacity"/>).</summary>
+  public int Count => (int)Math.Min(Volatile.Read(ref _written), _slots.Length);
+
+  /// <summary>Gets the total number of records ever written.</summary>
+  public long TotalWritten => Volatile.Read(ref _written);
+
+  /// <summary>Gets the size of one binary record.</summary>
+  public static int RecordSize => Unsafe.SizeOf<TransitionRecord<TStateId>>();
+
+  /// <summary>Copy the held records, oldest first.</summary>
+  /// <param name="destination">Destination; at least <see cref="Capacity"/> to receive every record.</param>
+  /// <returns>Number of records copied.</returns>
+  public int CopyTo(Span<TransitionRecord<TStateId>> destination)
+  {
+    var end = Volatile.Read(ref _written);
+    var start = Math.Max(end - Math.Min(_slots.Length, destination.Length), 0) + 1;
+
+    var count = 0;
+    for (var seq = start; seq <= end; seq++)
+    {
+      ref var slot = ref _slots[(seq - 1) & _mask];
+      if (Volatile.Read(ref slot.Sequence) != seq)
+        continue;
+
+      var record = slot.Record;
+
+      // Overwritten while copying (seqlock)
+      Interlocked.MemoryBarrier();
+      if (Volatile.Read(ref slot.Sequence) != seq)
+        continue;
+
+      destination[count++] = record;
+    }
+
+    return count;
+  }
+
+  /// <summary>Snapshot the held records, oldest first.</summary>
+  /// <returns>Records.</returns>
+  public TransitionRecord<TStateId>[] Snapshot()
+  {
+    var buffer = new TransitionRecord<TStateId>[_slots.Length];
+    return buffer.AsSpan(0, CopyTo(buffer)).ToArray();
+  }
+
+  /// <summary>
+  ///   Write the held records in the compact binary format: a little-endian header
+  ///   (<see cref="Magic"/>, <see cref="FormatVersion"/>, <see cref="RecordSize"/>, count, <see cref="TimestampFrequency"/>)
+  ///   followed by the raw <see cref="TransitionRecord{TStateId}"/> structs.
+  /// </summary>
+  /// <remarks>Records are in the machine's native byte order, laid out as documented on <see cref="TransitionRecord{TStateId}"/>.</remarks>
+  /// <param name="stream">Destination stream.</param>
+  /// <returns>Number of records written.</returns>
+  public int WriteTo(Stream stream)
+  {
+    ArgumentNullException.ThrowIfNull(stream);
+
+    var records = ArrayPool<TransitionRecord<TStateId>>.Shared.Rent(_slots.Length);
+    try
+    {
+      var count = CopyTo(records.AsSpan(0, _slots.Length));
+
+      Span<byte> header = stackalloc byte[HeaderSize];
+      BinaryPrimitives.WriteUInt32LittleEndian(header, Magic);
+      BinaryPrimitives.WriteUInt16LittleEndian(header[4..], FormatVersion);
+      BinaryPrimitives.WriteUInt16LittleEndian(header[6..], (ushort)RecordSize);
+      BinaryPrimitives.WriteInt32LittleEndian(header[8..], count);
+      BinaryPrimitives.WriteInt64LittleEndian(header[12..], TimestampFrequency);
+
+      stream.Write(header);
+      stream.Write(MemoryMarshal.AsBytes(records.AsSpan(0, count)));
+      return count;
+    }
+    finally
+    {
+      ArrayPool<TransitionRecord<TStateId>>.Shared.Return(records);
+    }
+  }
+
+  /// <summary>Append a record, overwriting the oldest once full.</summary>
+  /// <param name="record">Record.</param>
+  /// <remarks>Called by the run after each state; safe from any number of threads.</remarks>
+  public void Write(in TransitionRecord<TStateId> record)
+  {
+    var seq = Interlocked.Increment(ref _written);
+    ref var slot = ref _slots[(seq - 1) & _mask];
+
+    // Invalidate for readers before touching the record
+    Volatile.Write(ref slot.Sequence, 0);
+    Interlocked.MemoryBarrier();
+    slot.Record = record;
+    Volatile.Write(ref slot.Sequence, seq);
+  }
+
+  private struct Slot
+  {
+#pragma warning disable SA1401 // Fields should be private
+    public TransitionRecord<TStateId> Record;
+    public long Sequence;
+#pragma warning restore SA1401 // Fields should be private
+  }
+}
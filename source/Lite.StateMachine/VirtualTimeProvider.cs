@@ -0,0 +1,175 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Lite.StateMachine;
+
+/// <summary>Clock that only moves when it's advanced, for deterministic tests and simulations.</summary>
+/// <remarks>
+///   Timers fire synchronously on the thread calling <see cref="Advance"/>, in due-time order (ties in creation order),
+///   and each sees the clock at its own due time. Timers due now fire on the next advance, including <see cref="TimeSpan.Zero"/>.
+///   Timestamps are in <see cref="Stopwatch"/> units, like <see cref="TimeProvider.System"/>.
+/// </remarks>
+public sealed class VirtualTimeProvider : TimeProvider
+{
+  private readonly Lock _lockGate = new();
+  private readonly DateTimeOffset _start;
+
+  /// <summary>Scheduled firings; stale ones (timer changed or disposed since) are skipped when dequeued.</summary>
+  private readonly PriorityQueue<(VirtualTimer Timer, long Version), (long DueTicks, long Sequence)> _timers = new();
+
+  /// <summary>Elapsed <see cref="TimeSpan"/> ticks.</summary>
+  private long _nowTicks;
+
+  private long _sequence;
+
+  /// <summary>Initializes a new instance of the <see cref="VirtualTimeProvider"/> class, starting at 2000-01-01 UTC.</summary>
+  public VirtualTimeProvider()
+    : this(new DateTimeOffset(2000, 1, 1, 0, 0, 0, TimeSpan.Zero))
+  {
+  }
+
+  /// <summary>Initializes a new instance of the <see cref="VirtualTimeProvider"/> class.</summary>
+  /// <param name="start">Wall-clock time at zero elapsed.</param>
+  public VirtualTimeProvider(DateTimeOffset start)
+  {
+    _start = start;
+  }
+
+  /// <summary>Gets the time advanced so far.</summary>
+  public TimeSpan Elapsed => TimeSpan.FromTicks(Volatile.Read(ref _nowTicks));
+
+  /// <inheritdoc/>
+  public override TimeZoneInfo LocalTimeZone => TimeZoneInfo.Utc;
+
+  /// <summary>Move the clock forward, firing every timer that comes due on the way.</summary>
+  /// <param name="delta">Time to advance by.</param>
+  /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="delta"/> is negative.</exception>
+  public void Advance(TimeSpan delta)
+  {
+    ArgumentOutOfRangeException.ThrowIfLessThan(delta, TimeSpan.Zero);
+
+    var until = Elapsed + delta;
+    while (TryFireNext(until))
+      continue;
+
+    AdvanceTo(until);
+  }
+
+  /// <inheritdoc/>
+  public override ITimer CreateTimer(TimerCallback callback, object? state, TimeSpan dueTime, TimeSpan period)
+  {
+    ArgumentNullException.ThrowIfNull(callback);
+
+    var timer = new VirtualTimer(this, callback, state);
+    timer.Change(dueTime, period);
+    return timer;
+  }
+
+  /// <inheritdoc/>
+  public override long GetTimestamp()
+  {
+    // Split to keep ticks * frequency from overflowing
+    var ticks = Volatile.Read(ref _nowTicks);
+    var frequency = Stopwatch.Frequency;
+    return (ticks / TimeSpan.TicksPerSecond * frequency) + (ticks % TimeSpan.TicksPerSecond * frequency / TimeSpan.TicksPerSecond);
+  }
+
+  /// <inheritdoc/>
+  public override DateTimeOffset GetUtcNow() => _start + Elapsed;
+
+  /// <summary>Move the clock to a time without firing anything; never backwards.</summary>
+  /// <param name="until">Elapsed time to move to.</param>
+  internal void AdvanceTo(TimeSpan until)
+  {
+    lock (_lockGate)
+    {
+      if (until.Ticks > _nowTicks)
+        Volatile.Write(ref _nowTicks, until.Ticks);
+    }
+  }
+
+  /// <summary>Fire the earliest timer due at or before <paramref name="until"/>, moving the clock to its due time.</summary>
+  /// <param name="until">Latest elapsed time to fire at.</param>
+  /// <returns>False if nothing is due by then.</returns>
+  internal bool TryFireNext(TimeSpan until)
+  {
+    VirtualTimer timer;
+    lock (_lockGate)
+    {
+      while (true)
+      {
+        if (!_timers.TryPeek(out var next, out var due) || due.DueTicks > until.Ticks)
+          return false;
+
+        _timers.Dequeue();
+        if (next.Timer.Version != next.Version)
+          continue;
+
+        timer = next.Timer;
+        if (due.DueTicks > _nowTicks)
+          Volatile.Write(ref _nowTicks, due.DueTicks);
+
+        // Periodic timers are queued again before their callback, which may change them
+        if (timer.PeriodTicks > 0)
+          _timers.Enqueue((timer, timer.Version), (due.DueTicks + timer.PeriodTicks, _sequence++));
+
+        break;
+      }
+    }
+
+    timer.Fire();
+    return true;
+  }
+
+  private void Schedule(VirtualTimer timer, TimeSpan dueTime, TimeSpan period)
+  {
+    lock (_lockGate)
+    {
+      // Invalidates anything already queued for it
+      timer.Version++;
+      timer.PeriodTicks = period > TimeSpan.Zero ? period.Ticks : 0;
+      if (dueTime != Timeout.InfiniteTimeSpan)
+        _timers.Enqueue((timer, timer.Version), (_nowTicks + Math.Max(0, dueTime.Ticks), _sequence++));
+    }
+  }
+
+  private sealed class VirtualTimer(VirtualTimeProvider owner, TimerCallback callback, object? state) : ITimer
+  {
+    private bool _isDisposed;
+
+    /// <summary>Gets or sets the change count; guarded by the owner's lock.</summary>
+    public long Version { get; set; }
+
+    /// <summary>Gets or sets the period, or 0 for one-shot; guarded by the owner's lock.</summary>
+    public long PeriodTicks { get; set; }
+
+    public bool Change(TimeSpan dueTime, TimeSpan period)
+    {
+      if (_isDisposed)
+        return false;
+
+      owner.Schedule(this, dueTime, period);
+      return true;
+    }
+
+    public void Dispose()
+    {
+      _isDisposed = true;
+      owner.Schedule(this, Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+    }
+
+    public ValueTask DisposeAsync()
+    {
+      Dispose();
+      return default;
+    }
+
+    public void Fire() => callback(state);
+  }
+}
@@ -0,0 +1,19 @@
+// Copyright Xeno Innovations, Inc. 2025
+// See the LICENSE file in the project root for more information.
+
+using System;
+using System.Collections.Generic;
+
+namespace Lite.StateMachine;
+
+/// <summary>Options for pre-instantiating states ahead of the first run.</summary>
+/// <typeparam name="TStateId">Type of State Id.</typeparam>
+public sealed class WarmUpOptions<TStateId>
+  where TStateId : struct, Enum
+{
+  /// <summary>Gets the maximum number of states created at once (default: 1, sequential; -1 for unbounded).</summary>
+  public int MaxDegreeOfParallelism { get; init; } = 1;
+
+  /// <summary>Gets the states to warm up, or NULL for all registered states (default).</summary>
+  public IReadOnlyCollection<TStateId>? States { get; init; }
+}